@@ -0,0 +1,9 @@
+#ifndef __cpp_impl_coroutine
+#  error "No support for coroutines (__cpp_impl_coroutine)"
+#endif
+
+#include <coroutine>
+
+int main(int, char**) {
+  return 0;
+}
@@ -8,6 +8,7 @@
 #include <string>
 
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/timeout_token.hpp"
 #include "caf/fwd.hpp"
 
 namespace caf {
@@ -51,6 +52,14 @@ public:
   set_request_timeout(time_point t, abstract_actor* self, message_id id)
     = 0;
 
+  /// Schedules a `sec::request_timeout` for `self` at time point `t` unless
+  /// `self` disposes `token` before. Disposing the token is a cheaper
+  /// alternative to `cancel_request_timeout`, because it does not require a
+  /// round trip to the clock. The default implementation ignores `token`.
+  virtual void set_request_timeout(time_point t, abstract_actor* self,
+                                   message_id id,
+                                   detail::timeout_token_ptr token);
+
   /// Cancels a pending receive timeout.
   virtual void cancel_ordinary_timeout(abstract_actor* self, std::string type)
     = 0;
@@ -12,6 +12,7 @@
 #include "caf/detail/unique_function.hpp"
 #include "caf/fwd.hpp"
 #include "caf/input_range.hpp"
+#include "caf/mailbox_overflow_policy.hpp"
 
 namespace caf {
 
@@ -35,6 +36,15 @@ public:
   input_range<const group>* groups;
   detail::unique_function<behavior(local_actor*)> init_fun;
 
+  /// Maximum number of ordinary messages in the mailbox of a scheduled actor.
+  /// Responses, urgent messages and stream traffic never count towards this
+  /// limit. The default value 0 disables the limit.
+  size_t mailbox_capacity;
+
+  /// Selects how a scheduled actor handles messages that exceed its
+  /// `mailbox_capacity`.
+  mailbox_overflow_policy mailbox_overflow;
+
   // -- properties -------------------------------------------------------------
 
   actor_config& add_flag(int x) {
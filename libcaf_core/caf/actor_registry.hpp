@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
@@ -16,6 +17,7 @@
 #include "caf/actor.hpp"
 #include "caf/actor_cast.hpp"
 #include "caf/actor_control_block.hpp"
+#include "caf/config.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/shared_spinlock.hpp"
 #include "caf/fwd.hpp"
@@ -33,6 +35,9 @@ class CAF_CORE_EXPORT actor_registry {
 public:
   friend class actor_system;
 
+  /// Number of independently locked partitions for the ID-based entries.
+  static constexpr size_t num_shards = 64;
+
   ~actor_registry();
 
   /// Returns the local actor associated to `key`.
@@ -55,6 +60,10 @@ public:
   /// @returns the increased count.
   size_t inc_running();
 
+  /// Increases running-actors-count by `n`.
+  /// @returns the increased count.
+  size_t inc_running(size_t n);
+
   /// Decreases running-actors-count by one.
   /// @returns the decreased count.
   size_t dec_running();
@@ -108,13 +117,34 @@ private:
 
   using entries = std::unordered_map<actor_id, strong_actor_ptr>;
 
+  /// Stores a partition of the ID-based entries. Each shard occupies its own
+  /// cache line to avoid false sharing between lookups for different actors.
+  struct alignas(CAF_CACHE_LINE_SIZE) shard {
+    mutable detail::shared_spinlock mtx;
+    entries instances;
+  };
+
+  static_assert((num_shards & (num_shards - 1)) == 0,
+                "num_shards must be a power of two");
+
   actor_registry(actor_system& sys);
 
+  /// Returns the partition for `key`.
+  shard& shard_for(actor_id key) noexcept {
+    return shards_[key & (num_shards - 1)];
+  }
+
+  /// Returns the partition for `key`.
+  const shard& shard_for(actor_id key) const noexcept {
+    return shards_[key & (num_shards - 1)];
+  }
+
   mutable std::mutex running_mtx_;
   mutable std::condition_variable running_cv_;
 
-  mutable detail::shared_spinlock instances_mtx_;
-  entries entries_;
+  /// Partitions the ID-based entries. Actor IDs are assigned sequentially, so
+  /// the lower bits of an ID distribute the actors evenly over all shards.
+  std::array<shard, num_shards> shards_;
 
   name_map named_entries_;
   mutable detail::shared_spinlock named_entries_mtx_;
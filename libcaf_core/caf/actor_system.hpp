@@ -22,6 +22,8 @@
 #include "caf/actor_profiler.hpp"
 #include "caf/actor_registry.hpp"
 #include "caf/actor_traits.hpp"
+#include "caf/detail/batching_execution_unit.hpp"
+#include "caf/detail/config_snapshot.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/init_fun_factory.hpp"
 #include "caf/detail/private_thread_pool.hpp"
@@ -178,6 +180,29 @@ public:
 
     /// Counts the total number of messages that wait in a mailbox.
     telemetry::int_gauge* queued_messages;
+
+    /// Counts request timeouts that the clock discarded because the actor
+    /// received the response (or terminated) before the timeout expired.
+    telemetry::int_counter* discarded_timeouts;
+  };
+
+  /// Metrics for the thread-caching memory pool. The actor system only
+  /// registers these metrics when building CAF with `CAF_ENABLE_MEMORY_POOL`.
+  struct memory_pool_metrics_t {
+    /// Counts blocks served from thread caches.
+    telemetry::int_counter* allocations = nullptr;
+
+    /// Counts blocks that returned to their thread cache.
+    telemetry::int_counter* deallocations = nullptr;
+
+    /// Counts blocks that returned to their thread cache from another thread.
+    telemetry::int_counter* remote_deallocations = nullptr;
+
+    /// Counts allocations that bypassed the thread caches.
+    telemetry::int_counter* fallback_allocations = nullptr;
+
+    /// Tracks the memory that the pool requested from the system.
+    telemetry::int_gauge* reserved_memory = nullptr;
   };
 
   /// Metrics that some actors may collect in addition to the base metrics. All
@@ -194,6 +219,15 @@ public:
     /// Counts how many messages are currently waiting in the mailbox.
     telemetry::int_gauge_family* mailbox_size = nullptr;
 
+    /// Tracks how many messages the actor may consume per resume.
+    telemetry::int_gauge_family* throughput_budget = nullptr;
+
+    /// Tracks the average time the actor needs to process a message.
+    telemetry::dbl_gauge_family* message_cost = nullptr;
+
+    /// Counts messages that the actor discarded due to a full mailbox.
+    telemetry::int_counter_family* dropped_messages = nullptr;
+
     struct {
       // -- inbound ------------------------------------------------------------
 
@@ -333,6 +367,10 @@ public:
   /// Returns a new actor ID.
   actor_id next_actor_id();
 
+  /// Reserves `n` consecutive actor IDs.
+  /// @returns the first reserved ID.
+  actor_id next_actor_ids(size_t n);
+
   /// Returns the last given actor ID.
   actor_id latest_actor_id() const;
 
@@ -410,6 +448,83 @@ public:
                              std::forward<Ts>(xs)...);
   }
 
+  /// Returns a new actor of type `C` with a bounded mailbox. The actor accepts
+  /// up to `capacity` ordinary messages in its mailbox and then applies
+  /// `policy` to new messages.
+  /// @param capacity Maximum number of ordinary messages in the mailbox.
+  /// @param policy Selects how the actor handles messages beyond `capacity`.
+  /// @param xs Constructor arguments for `C`.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  infer_handle_from_class_t<C>
+  spawn_bounded(size_t capacity, mailbox_overflow_policy policy, Ts&&... xs) {
+    check_invariants<C>();
+    actor_config cfg;
+    cfg.mailbox_capacity = capacity;
+    cfg.mailbox_overflow = policy;
+    return spawn_impl<C, Os>(cfg, detail::spawn_fwd<Ts>(xs)...);
+  }
+
+  /// Returns a new functor-based actor with a bounded mailbox. The actor
+  /// accepts up to `capacity` ordinary messages in its mailbox and then
+  /// applies `policy` to new messages.
+  /// @param capacity Maximum number of ordinary messages in the mailbox.
+  /// @param policy Selects how the actor handles messages beyond `capacity`.
+  /// @param fun Function object for the actor's behavior.
+  /// @param xs Arguments for `fun`.
+  template <spawn_options Os = no_spawn_options, class F, class... Ts>
+  infer_handle_from_fun_t<F> spawn_bounded(size_t capacity,
+                                           mailbox_overflow_policy policy,
+                                           F fun, Ts&&... xs) {
+    using impl = infer_impl_from_fun_t<F>;
+    check_invariants<impl>();
+    static constexpr bool spawnable = detail::spawnable<F, impl, Ts...>();
+    static_assert(spawnable,
+                  "cannot spawn function-based actor with given arguments");
+    actor_config cfg;
+    cfg.mailbox_capacity = capacity;
+    cfg.mailbox_overflow = policy;
+    return spawn_functor<Os>(detail::bool_token<spawnable>{}, cfg, fun,
+                             std::forward<Ts>(xs)...);
+  }
+
+  /// Returns `n` new actors of type `C`, each constructed from copies of
+  /// `xs...`. Unlike calling `spawn` `n` times, this function reserves the
+  /// actor IDs, updates the count of running actors and looks up the metric
+  /// handles only once for all actors. Further, it passes all new actors to
+  /// the scheduler at once.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  std::vector<infer_handle_from_class_t<C>>
+  spawn_n(size_t n, const Ts&... xs) {
+    using handle_type = infer_handle_from_class_t<C>;
+    check_invariants<C>();
+    auto make = [&](actor_id aid, actor_config& cfg, auto& setup) {
+      return detail::make_actor_impl<C, handle_type>(setup, aid, node(), this,
+                                                     cfg, xs...);
+    };
+    return spawn_n_impl<C, Os, handle_type>(n, make);
+  }
+
+  /// Returns `n` new functor-based actors. Each actor calls a copy of `fun`
+  /// with copies of `xs...`.
+  /// @copydetails spawn_n
+  template <spawn_options Os = no_spawn_options, class F, class... Ts>
+  std::vector<infer_handle_from_fun_t<F>>
+  spawn_n(size_t n, F fun, const Ts&... xs) {
+    using impl = infer_impl_from_fun_t<F>;
+    using handle_type = infer_handle_from_fun_t<F>;
+    check_invariants<impl>();
+    static constexpr bool spawnable = detail::spawnable<F, impl, Ts...>();
+    static_assert(spawnable,
+                  "cannot spawn function-based actor with given arguments");
+    detail::init_fun_factory<impl, F> fac;
+    auto make = [&](actor_id aid, actor_config& cfg, auto& setup) {
+      cfg.init_fun = fac(fun, xs...);
+      return detail::make_actor_impl<impl, handle_type>(setup, aid, node(),
+                                                        this, cfg);
+    };
+    return spawn_n_impl<impl, Os, handle_type>(n, make);
+  }
+
   /// Returns a new actor with run-time type `name`, constructed
   /// with the arguments stored in `args`.
   /// @experimental
@@ -529,6 +644,12 @@ public:
     return cfg_;
   }
 
+  /// Returns configuration parameters that CAF reads when constructing actors.
+  /// The actor system reads these parameters once at startup.
+  const detail::config_snapshot& config_snapshot() const noexcept {
+    return config_snapshot_;
+  }
+
   /// Returns the system-wide clock.
   actor_clock& clock() noexcept;
 
@@ -592,6 +713,58 @@ public:
     return res;
   }
 
+  template <class C, spawn_options Os, class Handle, class Factory>
+  std::vector<Handle> spawn_n_impl(size_t n, Factory& make) {
+    static_assert(is_unbound(Os),
+                  "top-level spawns cannot have monitor or link flag");
+    std::vector<Handle> result;
+    if (n == 0)
+      return result;
+    result.reserve(n);
+    CAF_SET_LOGGER_SYS(this);
+    auto first_id = next_actor_ids(n);
+    const local_actor* prototype = nullptr;
+    auto setup = [&prototype](C& self) {
+      if (prototype == nullptr) {
+        self.setup_metrics();
+        prototype = &self;
+      } else {
+        self.setup_metrics(*prototype);
+      }
+    };
+    for (size_t i = 0; i < n; ++i) {
+      actor_config cfg{dummy_execution_unit()};
+      if (has_detach_flag(Os) || std::is_base_of<blocking_actor, C>::value)
+        cfg.flags |= abstract_actor::is_detached_flag;
+      if (has_hide_flag(Os))
+        cfg.flags |= abstract_actor::is_hidden_flag;
+      result.emplace_back(make(static_cast<actor_id>(first_id + i), cfg, setup));
+    }
+    // Register all actors at once before launching any of them. Otherwise, an
+    // actor could terminate before incrementing the count.
+    if (!has_hide_flag(Os)) {
+      for (auto& hdl : result)
+        actor_cast<abstract_actor*>(hdl)->setf(
+          abstract_actor::is_registered_flag);
+      registry_.inc_running(n);
+    }
+    launch_all<C>(result, has_lazy_init_flag(Os), has_hide_flag(Os));
+    return result;
+  }
+
+  template <class C, class Handle>
+  void launch_all(std::vector<Handle>& hdls, bool lazy, bool hide) {
+    detail::batching_execution_unit ctx{this};
+    for (auto& hdl : hdls) {
+      auto ptr = static_cast<C*>(actor_cast<abstract_actor*>(hdl));
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+      profiler_add_actor(*ptr, nullptr);
+#endif
+      ptr->launch(&ctx, lazy, hide);
+    }
+    ctx.flush();
+  }
+
   void profiler_add_actor(const local_actor& self, const local_actor* parent) {
     if (profiler_)
       profiler_->add_actor(self, parent);
@@ -635,6 +808,10 @@ public:
     return base_metrics_;
   }
 
+  /// Updates the memory pool metrics from the current pool statistics. Metric
+  /// exporters call this function before collecting the metrics.
+  void update_memory_pool_metrics();
+
   const auto& actor_metric_families() const noexcept {
     return actor_metric_families_;
   }
@@ -728,6 +905,9 @@ private:
   /// Stores the system-wide factory for deserializing tracing data.
   tracing_data_factory* tracing_context_;
 
+  /// Caches configuration parameters for constructing actors.
+  detail::config_snapshot config_snapshot_;
+
   /// Caches the configuration parameter `caf.metrics-filters.actors.includes`
   /// for faster lookups at runtime.
   std::vector<std::string> metrics_actors_includes_;
@@ -742,6 +922,16 @@ private:
   /// Manages threads for detached actors.
   detail::private_thread_pool private_threads_;
 
+  /// Stores the metrics for the memory pool.
+  memory_pool_metrics_t memory_pool_metrics_;
+
+  /// Serializes updates to `memory_pool_metrics_`.
+  std::mutex memory_pool_metrics_mtx_;
+
+  /// Publishes metrics to a memory-mapped file if the configuration sets
+  /// `caf.metrics-shm.path`.
+  std::unique_ptr<detail::shared_memory_exporter> shm_exporter_;
+
   /// Ties the lifetime of the meta objects table to the actor system.
   detail::global_meta_objects_guard_type meta_objects_guard_;
 };
@@ -0,0 +1,217 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/build_config.hpp"
+
+#ifdef CAF_ENABLE_COROUTINES
+
+#  include <coroutine>
+#  include <new>
+#  include <tuple>
+#  include <type_traits>
+#  include <utility>
+
+#  include "caf/config.hpp"
+#  include "caf/detail/memory_pool.hpp"
+#  include "caf/detail/response_continuation.hpp"
+#  include "caf/detail/type_list.hpp"
+#  include "caf/error.hpp"
+#  include "caf/expected.hpp"
+#  include "caf/message.hpp"
+#  include "caf/message_id.hpp"
+#  include "caf/raise_error.hpp"
+#  include "caf/sec.hpp"
+
+namespace caf {
+
+/// Return type for message handlers of event-based actors that are
+/// coroutines. A handler returning `co_handler` may suspend via
+/// `co_await self->request(...)` without blocking its worker thread. The actor
+/// resumes the handler when receiving the response and processes other
+/// messages in the meantime.
+///
+/// The actor treats the handler like a handler returning `void`, i.e., it
+/// responds to a request message immediately after the handler suspends for
+/// the first time. Handlers that respond after a `co_await` must create a
+/// response promise first.
+///
+/// When building CAF with `CAF_ENABLE_MEMORY_POOL`, coroutine frames are
+/// allocated from the thread-caching memory pool.
+///
+/// @warning The captures of a lambda live in the behavior and arguments taken
+///          by reference live in the message. Hence, coroutine handlers should
+///          take their arguments by value and must not access lambda captures
+///          after a `co_await` if the actor may change its behavior meanwhile.
+class co_handler {
+public:
+  struct promise_type {
+    co_handler get_return_object() noexcept {
+      return {};
+    }
+
+    std::suspend_never initial_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_never final_suspend() noexcept {
+      return {};
+    }
+
+    void return_void() noexcept {
+      // nop
+    }
+
+    void unhandled_exception() noexcept {
+      CAF_CRITICAL("unhandled exception in a coroutine message handler");
+    }
+
+#  ifdef CAF_ENABLE_MEMORY_POOL
+    static void* operator new(size_t size) {
+      if (auto ptr = detail::memory_pool::allocate(size))
+        return ptr;
+      CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+    }
+
+    static void operator delete(void* ptr) noexcept {
+      detail::memory_pool::deallocate(ptr);
+    }
+#  endif // CAF_ENABLE_MEMORY_POOL
+  };
+};
+
+} // namespace caf
+
+namespace caf::detail {
+
+/// Owns a suspended coroutine and destroys it unless released. Allows actors
+/// to clean up coroutines that wait for a response when terminating.
+class coroutine_guard {
+public:
+  explicit coroutine_guard(std::coroutine_handle<> hdl) noexcept : hdl_(hdl) {
+    // nop
+  }
+
+  coroutine_guard(coroutine_guard&& other) noexcept
+    : hdl_(std::exchange(other.hdl_, nullptr)) {
+    // nop
+  }
+
+  coroutine_guard& operator=(coroutine_guard&&) = delete;
+
+  ~coroutine_guard() {
+    if (hdl_)
+      hdl_.destroy();
+  }
+
+  std::coroutine_handle<> release() noexcept {
+    return std::exchange(hdl_, nullptr);
+  }
+
+private:
+  std::coroutine_handle<> hdl_;
+};
+
+/// Selects the result type of `co_await` on a response handle.
+template <class ResponseType>
+struct response_awaiter_value {
+  using type = message;
+};
+
+template <>
+struct response_awaiter_value<type_list<>> {
+  using type = void;
+};
+
+template <>
+struct response_awaiter_value<type_list<void>> {
+  using type = void;
+};
+
+template <class T>
+struct response_awaiter_value<type_list<T>> {
+  using type = T;
+};
+
+template <class T1, class T2, class... Ts>
+struct response_awaiter_value<type_list<T1, T2, Ts...>> {
+  using type = std::tuple<T1, T2, Ts...>;
+};
+
+/// Suspends a coroutine until an actor receives the response for `mid`.
+template <class Self, class ResponseType>
+class response_awaiter {
+public:
+  using value_type = typename response_awaiter_value<ResponseType>::type;
+
+  response_awaiter(Self* self, message_id mid) noexcept
+    : self_(self), mid_(mid) {
+    // nop
+  }
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> hdl) {
+    auto f = [this, guard = coroutine_guard{hdl}](message& msg) mutable {
+      set_result(msg);
+      guard.release().resume();
+      return true;
+    };
+    self_->add_multiplexed_response_handler(mid_,
+                                            response_continuation{std::move(f)});
+  }
+
+  expected<value_type> await_resume() {
+    return std::move(result_);
+  }
+
+private:
+  void set_result(message& msg) {
+    if (msg.match_elements<error>()) {
+      result_ = std::move(msg.get_mutable_as<error>(0));
+    } else if constexpr (std::is_same<value_type, message>::value) {
+      result_ = std::move(msg);
+    } else {
+      set_typed_result(msg, ResponseType{});
+    }
+  }
+
+  template <class... Ts>
+  void set_typed_result(message& msg, type_list<Ts...>) {
+    if constexpr (std::is_void<value_type>::value) {
+      if (msg.empty())
+        result_ = expected<void>{};
+      else
+        result_ = make_error(sec::unexpected_response, std::move(msg));
+    } else {
+      if (!msg.match_elements<Ts...>()) {
+        result_ = make_error(sec::unexpected_response, std::move(msg));
+      } else if constexpr (sizeof...(Ts) == 1) {
+        result_ = std::move(msg.get_mutable_as<Ts...>(0));
+      } else {
+        auto get = [&msg](auto index) -> decltype(auto) {
+          using type = tl_at_t<type_list<Ts...>, decltype(index)::value>;
+          return std::move(msg.get_mutable_as<type>(decltype(index)::value));
+        };
+        result_ = get_all(get, std::index_sequence_for<Ts...>{});
+      }
+    }
+  }
+
+  template <class F, size_t... Is>
+  static value_type get_all(F& get, std::index_sequence<Is...>) {
+    return value_type{get(std::integral_constant<size_t, Is>{})...};
+  }
+
+  Self* self_;
+  message_id mid_;
+  expected<value_type> result_ = make_error(sec::unexpected_response);
+};
+
+} // namespace caf::detail
+
+#endif // CAF_ENABLE_COROUTINES
@@ -79,9 +79,18 @@ constexpr auto policy = string_view{"stealing"};
 constexpr auto profiling_output_file = string_view{""};
 constexpr auto max_throughput = std::numeric_limits<size_t>::max();
 constexpr auto profiling_resolution = timespan(100'000'000);
+constexpr auto time_slice = timespan{0};
+constexpr auto adaptive_throughput = false;
 
 } // namespace caf::defaults::scheduler
 
+namespace caf::defaults::clock {
+
+constexpr auto backend = string_view{"map"};
+constexpr auto tick_interval = timespan{1'000'000};
+
+} // namespace caf::defaults::clock
+
 namespace caf::defaults::work_stealing {
 
 constexpr auto aggressive_poll_attempts = size_t{100};
@@ -91,6 +100,12 @@ constexpr auto moderate_steal_interval = size_t{5};
 constexpr auto moderate_sleep_duration = timespan{50'000};
 constexpr auto relaxed_steal_interval = size_t{1};
 constexpr auto relaxed_sleep_duration = timespan{10'000'000};
+constexpr auto idle_strategy = string_view{"park"};
+constexpr auto pin_workers = false;
+constexpr auto locality_aware_stealing = false;
+constexpr auto sysfs_cpu_path = string_view{"/sys/devices/system/cpu"};
+constexpr auto lifo_slot = true;
+constexpr auto max_lifo_runs = size_t{3};
 
 } // namespace caf::defaults::work_stealing
 
@@ -108,6 +123,12 @@ constexpr auto format = string_view{"[%c:%p] %d %m"};
 
 } // namespace caf::defaults::logger::console
 
+namespace caf::defaults::metrics_shm {
+
+constexpr auto interval = timespan{1'000'000'000};
+
+} // namespace caf::defaults::metrics_shm
+
 namespace caf::defaults::middleman {
 
 constexpr auto app_identifier = string_view{"generic-caf-app"};
@@ -0,0 +1,46 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/execution_unit.hpp"
+
+namespace caf::detail {
+
+/// Collects all jobs passed to `exec_later` and hands them to the scheduler in
+/// a single `bulk_enqueue` call when calling `flush` or when going out of
+/// scope. Allows code that wakes up many actors at once (e.g., when
+/// broadcasting a message) to avoid paying for one scheduling step per actor.
+class CAF_CORE_EXPORT batching_execution_unit : public execution_unit {
+public:
+  using super = execution_unit;
+
+  explicit batching_execution_unit(actor_system* sys);
+
+  batching_execution_unit(const batching_execution_unit&) = delete;
+
+  batching_execution_unit& operator=(const batching_execution_unit&) = delete;
+
+  /// Calls `flush`.
+  ~batching_execution_unit() override;
+
+  /// Stores `ptr` until the next call to `flush`.
+  void exec_later(resumable* ptr) override;
+
+  /// Delegates all collected jobs to the scheduler of `system()`.
+  void flush();
+
+  /// Returns the number of jobs that wait for the next `flush`.
+  size_t pending() const noexcept {
+    return jobs_.size();
+  }
+
+private:
+  std::vector<resumable*> jobs_;
+};
+
+} // namespace caf::detail
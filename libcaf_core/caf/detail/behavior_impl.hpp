@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -25,6 +28,7 @@
 #include "caf/skip.hpp"
 #include "caf/timeout_definition.hpp"
 #include "caf/timespan.hpp"
+#include "caf/type_id_list.hpp"
 #include "caf/typed_message_view.hpp"
 #include "caf/typed_response_promise.hpp"
 #include "caf/variant.hpp"
@@ -107,32 +111,22 @@ public:
     // nop
   }
 
+  /// Behaviors with up to this many handlers try each handler in turn. Larger
+  /// behaviors look up handlers in a table that is sorted by the hash of their
+  /// argument types.
+  static constexpr size_t max_linear_dispatch = 8;
+
   virtual bool invoke(detail::invoke_result_visitor& f, message& xs) override {
-    return invoke_impl(f, xs, std::make_index_sequence<sizeof...(Ts)>{});
+    if constexpr (sizeof...(Ts) <= max_linear_dispatch)
+      return invoke_impl(f, xs, std::make_index_sequence<sizeof...(Ts)>{});
+    else
+      return invoke_hashed(f, xs);
   }
 
   template <size_t... Is>
   bool invoke_impl(detail::invoke_result_visitor& f, message& msg,
                    std::index_sequence<Is...>) {
-    [[maybe_unused]] auto dispatch = [&](auto& fun) {
-      using fun_type = std::decay_t<decltype(fun)>;
-      using trait = get_callable_trait_t<fun_type>;
-      auto arg_types = to_type_id_list<typename trait::decayed_arg_types>();
-      if (arg_types == msg.types()) {
-        typename trait::message_view_type xs{msg};
-        using fun_result = decltype(detail::apply_args(fun, xs));
-        if constexpr (std::is_same<void, fun_result>::value) {
-          detail::apply_args(fun, xs);
-          f(unit);
-        } else {
-          auto invoke_res = detail::apply_args(fun, xs);
-          f(invoke_res);
-        }
-        return true;
-      }
-      return false;
-    };
-    return (dispatch(std::get<Is>(cases_)) || ...);
+    return (invoke_case<Is>(f, msg) || ...);
   }
 
   void handle_timeout() override {
@@ -140,6 +134,75 @@ public:
   }
 
 private:
+  using invoke_fun = bool (default_behavior_impl::*)(invoke_result_visitor&,
+                                                     message&);
+
+  /// Maps the hash of the argument types for a handler to its invoke function.
+  struct dispatch_entry {
+    uint64_t hash;
+    invoke_fun fun;
+  };
+
+  using dispatch_table = std::array<dispatch_entry, sizeof...(Ts)>;
+
+  template <class F>
+  static constexpr uint64_t hash_of() {
+    using trait = get_callable_trait_t<F>;
+    return to_type_id_list_hash<typename trait::decayed_arg_types>();
+  }
+
+  template <size_t... Is>
+  static constexpr dispatch_table
+  make_dispatch_table(std::index_sequence<Is...>) {
+    dispatch_table result{{dispatch_entry{
+      hash_of<Ts>(), &default_behavior_impl::template invoke_case<Is>}...}};
+    // Sort by hash, keeping handlers with the same hash in declaration order
+    // in order to preserve first-match semantics on collisions.
+    for (size_t i = 1; i < result.size(); ++i)
+      for (size_t j = i; j > 0 && result[j].hash < result[j - 1].hash; --j) {
+        auto tmp = result[j];
+        result[j] = result[j - 1];
+        result[j - 1] = tmp;
+      }
+    return result;
+  }
+
+  bool invoke_hashed(detail::invoke_result_visitor& f, message& msg) {
+    static constexpr auto table
+      = make_dispatch_table(std::make_index_sequence<sizeof...(Ts)>{});
+    auto hash = type_id_list_hash(msg.types());
+    auto pred = [](const dispatch_entry& x, uint64_t y) { return x.hash < y; };
+    auto first = std::lower_bound(table.begin(), table.end(), hash, pred);
+    for (; first != table.end() && first->hash == hash; ++first)
+      if ((this->*first->fun)(f, msg))
+        return true;
+    return false;
+  }
+
+  template <size_t I>
+  bool invoke_case(detail::invoke_result_visitor& f, message& msg) {
+    auto& fun = std::get<I>(cases_);
+    using fun_type = std::decay_t<decltype(fun)>;
+    using trait = get_callable_trait_t<fun_type>;
+    auto arg_types = to_type_id_list<typename trait::decayed_arg_types>();
+    if (arg_types == msg.types()) {
+      typename trait::message_view_type xs{msg};
+      using fun_result = decltype(detail::apply_args(fun, xs));
+      // Coroutine handlers produce their results via response promises, i.e.,
+      // the actor treats them like handlers returning void.
+      if constexpr (std::is_same<void, fun_result>::value
+                    || std::is_same<co_handler, fun_result>::value) {
+        detail::apply_args(fun, xs);
+        f(unit);
+      } else {
+        auto invoke_res = detail::apply_args(fun, xs);
+        f(invoke_res);
+      }
+      return true;
+    }
+    return false;
+  }
+
   tuple_type cases_;
 
   TimeoutDefinition timeout_definition_;
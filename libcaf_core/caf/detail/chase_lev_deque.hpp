@@ -0,0 +1,174 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace caf::detail {
+
+/// A lock-free work-stealing deque based on "Dynamic Circular Work-Stealing
+/// Deque" by Chase and Lev, using the C11 memory orderings from "Correct and
+/// Efficient Work-Stealing for Weak Memory Models" by Lê et al.
+///
+/// Only the owner of the deque may call `push_back` and `pop_back`. Any thread
+/// may call `steal`, which removes the oldest element from the front. The
+/// deque stores pointers in a circular array that doubles its capacity when
+/// running full. Hence, `push_back` only allocates when the deque grows beyond
+/// its previous high-water mark. Previous arrays remain alive until the deque
+/// gets destroyed, since concurrent thieves may still read from them. This
+/// bounds the memory overhead to the size of the current array.
+/// @note The deque never takes ownership of the stored elements.
+template <class T>
+class chase_lev_deque {
+public:
+  using value_type = T;
+  using pointer = value_type*;
+  using size_type = size_t;
+
+  static constexpr size_type default_capacity = 64;
+
+  explicit chase_lev_deque(size_type initial_capacity = default_capacity)
+    : top_(0), bottom_(0) {
+    // Round up to the next power of two.
+    size_type capacity = 2;
+    while (capacity < initial_capacity)
+      capacity <<= 1;
+    arrays_.emplace_back(std::make_unique<array>(capacity));
+    array_ = arrays_.back().get();
+  }
+
+  chase_lev_deque(const chase_lev_deque&) = delete;
+
+  chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+  /// Adds `value` to the back of the deque.
+  /// @warning Only the owner of the deque may call this function.
+  void push_back(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_acquire);
+    auto a = array_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<index_type>(a->capacity()) - 1)
+      a = grow(a, t, b);
+    a->store(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /// Removes the most recently added element from the back of the deque.
+  /// @returns the removed element or `nullptr` if the deque is empty.
+  /// @warning Only the owner of the deque may call this function.
+  pointer pop_back() {
+    auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    auto a = array_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      // The deque was empty.
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto result = a->load(b);
+    if (t == b) {
+      // Last element: race against thieves.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+        result = nullptr;
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  /// Removes the oldest element from the front of the deque.
+  /// @returns the removed element or `nullptr` if the deque is empty or if
+  ///          another thread won the race for the front element.
+  /// @note Safe to call from any thread.
+  pointer steal() {
+    auto t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = bottom_.load(std::memory_order_acquire);
+    if (t >= b)
+      return nullptr;
+    auto a = array_.load(std::memory_order_acquire);
+    auto result = a->load(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+      return nullptr;
+    return result;
+  }
+
+  /// Queries whether the deque appears empty. The result is only a snapshot
+  /// when other threads access the deque concurrently.
+  bool empty() const noexcept {
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_relaxed);
+    return b <= t;
+  }
+
+  /// Returns the number of elements the deque can store before growing.
+  size_type capacity() const noexcept {
+    return array_.load(std::memory_order_relaxed)->capacity();
+  }
+
+private:
+  using index_type = int64_t;
+
+  class array {
+  public:
+    explicit array(size_type capacity)
+      : mask_(capacity - 1), buf_(new std::atomic<pointer>[capacity]) {
+      // nop
+    }
+
+    size_type capacity() const noexcept {
+      return mask_ + 1;
+    }
+
+    pointer load(index_type pos) const noexcept {
+      return buf_[static_cast<size_type>(pos) & mask_].load(
+        std::memory_order_relaxed);
+    }
+
+    void store(index_type pos, pointer value) noexcept {
+      buf_[static_cast<size_type>(pos) & mask_].store(
+        value, std::memory_order_relaxed);
+    }
+
+  private:
+    size_type mask_;
+    std::unique_ptr<std::atomic<pointer>[]> buf_;
+  };
+
+  array* grow(array* old, index_type t, index_type b) {
+    auto ptr = std::make_unique<array>(old->capacity() * 2);
+    for (auto i = t; i != b; ++i)
+      ptr->store(i, old->load(i));
+    auto result = ptr.get();
+    arrays_.emplace_back(std::move(ptr));
+    array_.store(result, std::memory_order_release);
+    return result;
+  }
+
+  // Read by thieves, modified by thieves and the owner.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<index_type> top_;
+
+  // Modified only by the owner.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<index_type> bottom_;
+
+  // Points to the last element of `arrays_`.
+  std::atomic<array*> array_;
+
+  // Keeps all arrays alive, since thieves may still read from old ones.
+  std::vector<std::unique_ptr<array>> arrays_;
+};
+
+} // namespace caf::detail
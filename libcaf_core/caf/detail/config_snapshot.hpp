@@ -0,0 +1,70 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstdint>
+
+#include "caf/defaults.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::detail {
+
+/// Stores configuration parameters that CAF reads whenever constructing
+/// actors, stream managers or inbound paths. The actor system takes this
+/// snapshot once at startup to avoid repeated, string-keyed lookups in the
+/// configuration while spawning actors.
+class CAF_CORE_EXPORT config_snapshot {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Selects the credit controller for inbound paths.
+  enum class credit_policy {
+    size_based,
+    token_based,
+  };
+
+  /// Parameters for the `size-based` credit controller.
+  struct size_based_policy {
+    int32_t bytes_per_batch = defaults::stream::size_policy::bytes_per_batch;
+    int32_t buffer_capacity = defaults::stream::size_policy::buffer_capacity;
+    int32_t sampling_rate = defaults::stream::size_policy::sampling_rate;
+    int32_t calibration_interval
+      = defaults::stream::size_policy::calibration_interval;
+    float smoothing_factor = defaults::stream::size_policy::smoothing_factor;
+  };
+
+  /// Parameters for the `token-based` credit controller.
+  struct token_based_policy {
+    int32_t batch_size = defaults::stream::token_policy::batch_size;
+    int32_t buffer_size = defaults::stream::token_policy::buffer_size;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Creates a snapshot with the default values.
+  config_snapshot() = default;
+
+  /// Reads all parameters from `cfg`, falling back to the default values for
+  /// missing or invalid entries.
+  explicit config_snapshot(const actor_system_config& cfg);
+
+  // -- member variables -------------------------------------------------------
+
+  /// Caches `caf.stream.max-batch-delay`.
+  timespan stream_max_batch_delay = defaults::stream::max_batch_delay;
+
+  /// Caches `caf.stream.credit-policy`.
+  credit_policy stream_credit_policy = credit_policy::size_based;
+
+  /// Caches the parameters in `caf.stream.size-based-policy`.
+  size_based_policy size_policy;
+
+  /// Caches the parameters in `caf.stream.token-based-policy`.
+  token_based_policy token_policy;
+};
+
+} // namespace caf::detail
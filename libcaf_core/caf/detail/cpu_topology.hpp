@@ -0,0 +1,99 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/string_view.hpp"
+
+namespace caf::detail {
+
+/// Describes the hardware topology of the CPUs on this machine.
+class CAF_CORE_EXPORT cpu_topology {
+public:
+  /// Default location of the CPU information in the Linux sysfs.
+  static constexpr string_view default_sysfs_path = "/sys/devices/system/cpu";
+
+  /// Locates a single logical CPU.
+  struct cpu_info {
+    /// ID of the logical CPU as used by the OS.
+    int id;
+
+    /// ID of the NUMA node this CPU belongs to.
+    int numa_node;
+
+    /// ID of the physical package (socket) this CPU belongs to.
+    int package;
+
+    /// Smallest ID of all CPUs that share the L2 cache with this CPU.
+    int l2_group;
+
+    /// Smallest ID of all CPUs that share the last-level cache with this CPU.
+    int llc_group;
+  };
+
+  /// Relative distance between two CPUs.
+  enum class locality {
+    /// Both CPUs share the L2 cache.
+    l2,
+    /// Both CPUs share the last-level cache.
+    llc,
+    /// Both CPUs belong to the same NUMA node.
+    numa,
+    /// The CPUs belong to different NUMA nodes.
+    remote,
+  };
+
+  cpu_topology() = default;
+
+  explicit cpu_topology(std::vector<cpu_info> cpus);
+
+  /// Reads the CPU topology from the sysfs at `path`.
+  /// @returns An empty topology if `path` contains no CPU information or if
+  ///          the platform provides no sysfs.
+  static cpu_topology read(string_view path = default_sysfs_path);
+
+  /// Returns all online CPUs, sorted by NUMA node, package, last-level cache
+  /// group, L2 group and ID. Hence, CPUs that share a cache are next to each
+  /// other.
+  const std::vector<cpu_info>& cpus() const noexcept {
+    return cpus_;
+  }
+
+  /// Returns whether this topology contains no CPUs.
+  bool empty() const noexcept {
+    return cpus_.empty();
+  }
+
+  /// Returns the CPU for the worker with ID `worker_id` when assigning workers
+  /// to CPUs in round-robin order.
+  /// @pre `!empty()`
+  const cpu_info& cpu_for_worker(size_t worker_id) const noexcept {
+    return cpus_[worker_id % cpus_.size()];
+  }
+
+  /// Returns the relative distance between `x` and `y`.
+  static locality distance(const cpu_info& x, const cpu_info& y) noexcept;
+
+  /// Parses a list of CPUs in the Linux sysfs format, e.g., `0-3,8,10-11`.
+  /// @returns A sorted list of CPU IDs or an empty list on a parser error.
+  static std::vector<int> parse_cpu_list(string_view str);
+
+  /// Pins the calling thread to the CPU with ID `cpu_id`.
+  /// @returns `true` on success, `false` if the platform does not support
+  ///          thread pinning or if the OS rejected the CPU.
+  static bool pin_this_thread(int cpu_id);
+
+private:
+  std::vector<cpu_info> cpus_;
+};
+
+/// @relates cpu_topology
+CAF_CORE_EXPORT std::string to_string(cpu_topology::locality x);
+
+} // namespace caf::detail
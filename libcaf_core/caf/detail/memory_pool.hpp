@@ -0,0 +1,85 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/detail/core_export.hpp"
+
+namespace caf::detail {
+
+/// A thread-caching pool allocator for small, short-lived objects such as
+/// mailbox elements and message contents. Each thread allocates from its own
+/// cache with one free list per size class. Blocks always return to the cache
+/// that allocated them: the owning thread pushes freed blocks to its local
+/// free list without synchronization, while other threads push to a lock-free
+/// list that the owner drains once its local free list runs empty. Requests
+/// that exceed the largest size class fall back to `malloc`.
+///
+/// The pool never returns memory to the operating system. Caches of threads
+/// that terminate become available to new threads.
+class CAF_CORE_EXPORT memory_pool {
+public:
+  /// Number of distinct block sizes.
+  static constexpr size_t num_size_classes = 6;
+
+  /// Size of the smallest block, including the block header.
+  static constexpr size_t min_block_size = 64;
+
+  /// Size of the largest block, including the block header.
+  static constexpr size_t max_block_size = min_block_size
+                                           << (num_size_classes - 1);
+
+  /// Bytes reserved in front of each block. Keeps all blocks aligned to
+  /// `alignof(std::max_align_t)`.
+  static constexpr size_t header_size = 16;
+
+  /// Bytes the pool requests from the system when running out of blocks.
+  static constexpr size_t slab_size = 64 * 1024;
+
+  /// Summarizes the activity of all thread caches.
+  struct statistics {
+    /// Number of blocks served from a thread cache.
+    uint64_t allocations = 0;
+
+    /// Number of blocks that returned to their cache.
+    uint64_t deallocations = 0;
+
+    /// Number of blocks that returned to their cache from another thread.
+    uint64_t remote_deallocations = 0;
+
+    /// Number of allocations that bypassed the pool.
+    uint64_t fallback_allocations = 0;
+
+    /// Number of bytes the pool requested from the system.
+    uint64_t reserved_bytes = 0;
+  };
+
+  /// Allocates a memory block of at least `size` bytes.
+  /// @returns a pointer to the allocated memory or `nullptr` if the system
+  ///          runs out of memory.
+  static void* allocate(size_t size) noexcept;
+
+  /// Releases a memory block previously allocated with `allocate`. Any thread
+  /// may release a block, regardless of which thread allocated it.
+  static void deallocate(void* ptr) noexcept;
+
+  /// Returns the size class for blocks of `size` bytes (excluding the header)
+  /// or `num_size_classes` if `size` exceeds the largest size class.
+  static constexpr size_t size_class(size_t size) noexcept {
+    size_t result = 0;
+    for (auto block_size = min_block_size; block_size - header_size < size;
+         block_size <<= 1)
+      if (++result == num_size_classes)
+        break;
+    return result;
+  }
+
+  /// Collects statistics from all thread caches.
+  static statistics stats() noexcept;
+};
+
+} // namespace caf::detail
@@ -12,6 +12,7 @@
 #include "caf/config.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/implicit_conversions.hpp"
+#include "caf/detail/memory_pool.hpp"
 #include "caf/detail/padded_size.hpp"
 #include "caf/fwd.hpp"
 #include "caf/type_id_list.hpp"
@@ -30,8 +31,19 @@
 namespace caf::detail {
 
 /// Container for storing an arbitrary number of message elements.
+///
+/// A message data object may share its memory block with a mailbox element
+/// (see `make_mailbox_element`). In this case, the element holds an extra
+/// reference to the data that keeps the block alive. This reference does not
+/// count when checking whether the data is unique.
 class CAF_CORE_EXPORT message_data {
 public:
+  // -- constants --------------------------------------------------------------
+
+  /// Reference of a mailbox element that shares its memory block with this
+  /// object. Regular references never reach this value.
+  static constexpr size_t element_ref = size_t{1} << (sizeof(size_t) * 8 - 1);
+
   // -- constructors, destructors, and assignment operators --------------------
 
   message_data() = delete;
@@ -49,6 +61,30 @@ public:
 
   static intrusive_ptr<message_data> make_uninitialized(type_id_list types);
 
+  // -- memory management ------------------------------------------------------
+
+  /// Allocates memory for a message data object with `size` bytes, including
+  /// the storage for its elements. Uses the @ref memory_pool when building CAF
+  /// with `CAF_ENABLE_MEMORY_POOL` and `malloc` otherwise.
+  /// @returns a pointer to the allocated memory or `nullptr` if the system
+  ///          runs out of memory.
+  static void* allocate(size_t size) noexcept {
+#ifdef CAF_ENABLE_MEMORY_POOL
+    return memory_pool::allocate(size);
+#else
+    return malloc(size);
+#endif
+  }
+
+  /// Releases memory previously allocated with `allocate`.
+  static void deallocate(void* ptr) noexcept {
+#ifdef CAF_ENABLE_MEMORY_POOL
+    memory_pool::deallocate(ptr);
+#else
+    free(ptr);
+#endif
+  }
+
   // -- reference counting -----------------------------------------------------
 
   /// Increases reference count by one.
@@ -59,22 +95,35 @@ public:
   /// Decreases the reference count by one and destroys the object when its
   /// reference count drops to zero.
   void deref() noexcept {
-    if (unique() || rc_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
-      this->~message_data();
-      free(const_cast<message_data*>(this));
-    }
+    if (rc_ == 1 || rc_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      destroy();
+  }
+
+  /// Adds the reference of a mailbox element that shares its memory block with
+  /// this object.
+  void add_element_ref() noexcept {
+    rc_.fetch_add(element_ref, std::memory_order_relaxed);
+  }
+
+  /// Drops the reference of a mailbox element that shares its memory block
+  /// with this object and destroys the object if no other reference exists.
+  /// @pre the mailbox element is already destroyed
+  void release_element_ref() noexcept {
+    if (rc_ == element_ref
+        || rc_.fetch_sub(element_ref, std::memory_order_acq_rel) == element_ref)
+      destroy();
   }
 
   // -- properties -------------------------------------------------------------
 
   /// Queries whether there is exactly one reference to this data.
   bool unique() const noexcept {
-    return rc_ == 1;
+    return (rc_ & ~element_ref) == 1;
   }
 
   /// Returns the current number of references to this data.
   size_t get_reference_count() const noexcept {
-    return rc_.load();
+    return rc_.load() & ~element_ref;
   }
 
   /// Returns the memory region for storing the message elements.
@@ -158,6 +207,11 @@ public:
   }
 
 private:
+  void destroy() noexcept {
+    this->~message_data();
+    deallocate(this);
+  }
+
   void init_impl(byte*) {
     // End of recursion.
   }
@@ -0,0 +1,92 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/span.hpp"
+
+namespace caf::detail {
+
+/// Maps label sets to the instances of a metric family. Lookups never block
+/// and may run concurrently to a single writer. The index never removes
+/// entries, because metric families never remove instances.
+class CAF_CORE_EXPORT metric_index {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  metric_index() noexcept;
+
+  metric_index(const metric_index&) = delete;
+
+  metric_index& operator=(const metric_index&) = delete;
+
+  ~metric_index();
+
+  // -- hashing ----------------------------------------------------------------
+
+  /// Computes a hash value for `labels` that does not depend on their order.
+  static size_t hash_of(span<const telemetry::label_view> labels) noexcept;
+
+  /// Computes a hash value for `labels` that does not depend on their order.
+  static size_t hash_of(span<const telemetry::label> labels) noexcept;
+
+  // -- lookups ----------------------------------------------------------------
+
+  /// Returns the instance with the label set `labels` or `nullptr`.
+  /// @param hash The result of `hash_of(labels)`.
+  /// @note Safe to call concurrently to `insert`.
+  telemetry::metric* find(size_t hash,
+                          span<const telemetry::label_view> labels) const
+    noexcept;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds `instance` to the index.
+  /// @param hash The result of `hash_of(instance->labels())`.
+  /// @pre The caller prevents concurrent calls to `insert`.
+  /// @pre The index contains no other instance with the same labels.
+  void insert(size_t hash, telemetry::metric* instance);
+
+private:
+  struct slot {
+    /// Caches the hash value for the labels of `instance`. Written before
+    /// storing `instance`, i.e., readers may only access the hash value after
+    /// reading a non-null `instance`.
+    size_t hash = 0;
+
+    std::atomic<telemetry::metric*> instance{nullptr};
+  };
+
+  struct table {
+    explicit table(size_t capacity);
+
+    size_t mask;
+
+    std::unique_ptr<slot[]> slots;
+  };
+
+  /// Stores `instance` into `tbl` without checking the load factor.
+  static void place(table& tbl, size_t hash, telemetry::metric* instance);
+
+  /// Points to the most recent table.
+  std::atomic<table*> table_;
+
+  /// Stores all tables. Readers may still access older tables after growing
+  /// the index, so we only release the tables in the destructor. Since each
+  /// table doubles the capacity, this wastes at most as many slots as the
+  /// current table has.
+  std::vector<std::unique_ptr<table>> tables_;
+
+  /// Stores the number of instances in the index.
+  size_t size_;
+};
+
+} // namespace caf::detail
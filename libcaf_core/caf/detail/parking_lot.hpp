@@ -0,0 +1,129 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::detail {
+
+/// Allows idle worker threads to suspend themselves until another thread
+/// wakes them up. Each worker owns a slot with a single state word. On Linux,
+/// workers wait on this word via `futex`. Other platforms fall back to a mutex
+/// and a condition variable per slot. An additional bitmap tracks all parked
+/// workers, allowing other threads to find a parked worker quickly. Waking a
+/// worker that is not parked costs only a single atomic load.
+class CAF_CORE_EXPORT parking_lot {
+public:
+  explicit parking_lot(size_t num_workers);
+
+  parking_lot(const parking_lot&) = delete;
+
+  parking_lot& operator=(const parking_lot&) = delete;
+
+  ~parking_lot();
+
+  /// Suspends worker `id` until another thread calls `unpark(id)` or until
+  /// `timeout` expires. Before suspending, the worker announces itself as
+  /// parked and then calls `has_work`. When `has_work` returns `true`, the
+  /// worker returns immediately. Producers must publish new work *before*
+  /// calling `unpark` to avoid lost wakeups.
+  /// @returns `true` if another thread woke up the worker (or `has_work`
+  ///          returned `true`), `false` on a timeout.
+  template <class Predicate>
+  bool park(size_t id, timespan timeout, Predicate has_work) {
+    auto& x = slots_[id];
+    x.state.store(parked, std::memory_order_seq_cst);
+    set_bit(id);
+    if (has_work()) {
+      clear_bit(id);
+      x.state.store(running, std::memory_order_seq_cst);
+      return true;
+    }
+    wait(x, timeout);
+    clear_bit(id);
+    return x.state.exchange(running, std::memory_order_seq_cst) != parked;
+  }
+
+  /// Wakes up worker `id` if it is currently parked.
+  /// @returns `true` if this call woke up the worker, `false` otherwise.
+  bool unpark(size_t id) {
+    auto& x = slots_[id];
+    if (x.state.load(std::memory_order_seq_cst) != parked
+        || x.state.exchange(notified, std::memory_order_seq_cst) != parked)
+      return false;
+    wake(x);
+    return true;
+  }
+
+  /// Wakes up one of the currently parked workers, if any.
+  /// @returns `true` if this call woke up a worker, `false` otherwise.
+  bool unpark_any();
+
+  /// Queries whether at least one worker is currently parked.
+  bool has_parked() const noexcept {
+    for (auto& word : mask_)
+      if (word.load(std::memory_order_relaxed) != 0)
+        return true;
+    return false;
+  }
+
+  /// Returns the number of slots in the parking lot.
+  size_t size() const noexcept {
+    return num_slots_;
+  }
+
+private:
+  // -- states of a slot -------------------------------------------------------
+
+  static constexpr uint32_t running = 0;
+
+  static constexpr uint32_t parked = 1;
+
+  static constexpr uint32_t notified = 2;
+
+  struct alignas(CAF_CACHE_LINE_SIZE) slot {
+    std::atomic<uint32_t> state{running};
+#ifndef CAF_LINUX
+    std::mutex mtx;
+    std::condition_variable cv;
+#endif
+  };
+
+  void set_bit(size_t id) noexcept {
+    auto mask = uint64_t{1} << (id % 64);
+    mask_[id / 64].fetch_or(mask, std::memory_order_seq_cst);
+  }
+
+  void clear_bit(size_t id) noexcept {
+    auto mask = ~(uint64_t{1} << (id % 64));
+    mask_[id / 64].fetch_and(mask, std::memory_order_seq_cst);
+  }
+
+  // Blocks the calling thread until the state of `x` is no longer `parked`,
+  // until `timeout` expires or on a spurious wakeup.
+  static void wait(slot& x, timespan timeout);
+
+  // Wakes up the thread waiting on `x`.
+  static void wake(slot& x);
+
+  size_t num_slots_;
+
+  std::unique_ptr<slot[]> slots_;
+
+  std::vector<std::atomic<uint64_t>> mask_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,127 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+#include "caf/config.hpp"
+
+namespace caf::detail {
+
+/// Stores a fixed number of values for up to `num_shards` threads. Each thread
+/// updates the cells of its own shard, which starts on a separate cache line.
+/// Hence, threads updating the same value never write to the same cache line
+/// unless more than `num_shards` threads access the cells. Readers compute the
+/// current value by summing up the cells of all shards.
+template <class T>
+class per_thread_cells {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = T;
+
+  using cell_type = std::atomic<value_type>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Number of independent copies of each cell.
+  static constexpr size_t num_shards = 32;
+
+  /// Number of cells that fit into a single cache line.
+  static constexpr size_t cells_per_line = CAF_CACHE_LINE_SIZE
+                                           / sizeof(cell_type);
+
+  static_assert((num_shards & (num_shards - 1)) == 0,
+                "num_shards must be a power of two");
+
+  static_assert(cells_per_line > 0);
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Creates `size` cells per shard and initializes them to 0.
+  explicit per_thread_cells(size_t size)
+    : size_(size),
+      lines_per_shard_((size + cells_per_line - 1) / cells_per_line),
+      lines_(new line[num_shards * lines_per_shard_]) {
+    // nop
+  }
+
+  per_thread_cells(const per_thread_cells&) = delete;
+
+  per_thread_cells& operator=(const per_thread_cells&) = delete;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of cells per shard.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds `amount` to the cell at `index` in the shard of the calling thread.
+  void add(size_t index, value_type amount) noexcept {
+    auto& cell = at(shard_index(), index);
+    if constexpr (std::is_integral<value_type>::value) {
+      cell.fetch_add(amount, std::memory_order_relaxed);
+    } else {
+      // Only the owning thread writes to this cell unless there are more
+      // threads than shards. Hence, this loop almost never retries.
+      auto val = cell.load(std::memory_order_relaxed);
+      while (!cell.compare_exchange_weak(val, val + amount,
+                                         std::memory_order_relaxed)) {
+        // nop
+      }
+    }
+  }
+
+  // -- observers --------------------------------------------------------------
+
+  /// Returns the sum of the cells at `index` over all shards.
+  value_type sum(size_t index) const noexcept {
+    value_type result = 0;
+    for (size_t shard = 0; shard < num_shards; ++shard)
+      result += at(shard, index).load(std::memory_order_relaxed);
+    return result;
+  }
+
+  /// Returns the shard for the calling thread.
+  static size_t shard_index() noexcept {
+    static std::atomic<size_t> next_index;
+    thread_local size_t index = next_index.fetch_add(1) & (num_shards - 1);
+    return index;
+  }
+
+private:
+  struct alignas(CAF_CACHE_LINE_SIZE) line {
+    line() noexcept {
+      for (auto& cell : cells)
+        cell.store(0, std::memory_order_relaxed);
+    }
+
+    cell_type cells[cells_per_line];
+  };
+
+  cell_type& at(size_t shard, size_t index) noexcept {
+    auto& ln = lines_[shard * lines_per_shard_ + index / cells_per_line];
+    return ln.cells[index % cells_per_line];
+  }
+
+  const cell_type& at(size_t shard, size_t index) const noexcept {
+    auto& ln = lines_[shard * lines_per_shard_ + index / cells_per_line];
+    return ln.cells[index % cells_per_line];
+  }
+
+  size_t size_;
+
+  size_t lines_per_shard_;
+
+  std::unique_ptr<line[]> lines_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,37 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+#include "caf/detail/type_traits.hpp"
+
+namespace caf::detail {
+
+/// Hints the processor to load the cache line at `ptr` for reading. Does
+/// nothing on compilers without a prefetch intrinsic. Passing a null pointer
+/// is safe.
+inline void prefetch(const void* ptr) noexcept {
+#if defined(CAF_GCC) || defined(CAF_CLANG)
+  __builtin_prefetch(ptr);
+#else
+  static_cast<void>(ptr);
+#endif
+}
+
+/// Prefetches data for the elements that follow the current element of a
+/// queue: the element after `next` and, if `T` provides `prefetch_content`,
+/// the data that `next` points to. Reading the pointer to the content of an
+/// element stalls unless the element is already in the cache. Hence, this
+/// function prefetches each element one step before its content.
+template <class T>
+void prefetch_ahead(const T* next) noexcept {
+  if (next == nullptr)
+    return;
+  prefetch(static_cast<const void*>(next->next));
+  if constexpr (has_prefetch_content_member<T>::value)
+    next->prefetch_content();
+}
+
+} // namespace caf::detail
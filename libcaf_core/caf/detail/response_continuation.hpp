@@ -0,0 +1,201 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "caf/byte.hpp"
+#include "caf/const_typed_message_view.hpp"
+#include "caf/detail/apply_args.hpp"
+#include "caf/detail/type_traits.hpp"
+#include "caf/message.hpp"
+#include "caf/type_id_list.hpp"
+#include "caf/typed_message_view.hpp"
+
+namespace caf::detail {
+
+/// A single-shot response handler that consists of a callback for the result
+/// and a callback for errors. Unlike a `behavior`, a continuation stores small
+/// callbacks inline instead of allocating a `behavior_impl` on the heap.
+class response_continuation {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Maximum size of the callbacks for storing them inline.
+  static constexpr size_t storage_size = 6 * sizeof(void*);
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  response_continuation() noexcept : vtbl_(nullptr) {
+    // nop
+  }
+
+  template <class F, class OnError>
+  response_continuation(F f, OnError g) {
+    init(impl<F, OnError>{std::move(f), std::move(g)});
+  }
+
+  /// Creates a continuation from a single callback that receives the response
+  /// message as-is, i.e., without matching its content. The callback returns
+  /// whether it accepted the message.
+  template <class F>
+  explicit response_continuation(F f) {
+    init(raw_impl<F>{std::move(f)});
+  }
+
+  response_continuation(response_continuation&& other) noexcept
+    : vtbl_(other.vtbl_) {
+    if (vtbl_ != nullptr) {
+      vtbl_->move(other.storage_, storage_);
+      other.vtbl_ = nullptr;
+    }
+  }
+
+  response_continuation& operator=(response_continuation&& other) noexcept {
+    if (this != &other) {
+      reset();
+      if (other.vtbl_ != nullptr) {
+        other.vtbl_->move(other.storage_, storage_);
+        vtbl_ = other.vtbl_;
+        other.vtbl_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  response_continuation(const response_continuation&) = delete;
+
+  response_continuation& operator=(const response_continuation&) = delete;
+
+  ~response_continuation() {
+    reset();
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Queries whether this continuation holds callbacks.
+  explicit operator bool() const noexcept {
+    return vtbl_ != nullptr;
+  }
+
+  /// Queries whether this continuation stores its callbacks inline.
+  bool is_inline() const noexcept {
+    return vtbl_ != nullptr && vtbl_->is_inline;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Destroys the callbacks.
+  void reset() noexcept {
+    if (vtbl_ != nullptr) {
+      vtbl_->destroy(storage_);
+      vtbl_ = nullptr;
+    }
+  }
+
+  // -- invocation -------------------------------------------------------------
+
+  /// Invokes the result callback if the types of `msg` match its arguments or
+  /// the error callback if `msg` contains a single `error`.
+  /// @returns `false` if neither callback accepts `msg`, `true` otherwise.
+  /// @pre `static_cast<bool>(*this)`
+  bool operator()(message& msg) {
+    return vtbl_->invoke(storage_, msg);
+  }
+
+private:
+  // -- implementation details -------------------------------------------------
+
+  template <class F, class OnError>
+  struct impl {
+    F f;
+    OnError g;
+
+    bool operator()(message& msg) {
+      return try_invoke(f, msg) || try_invoke(g, msg);
+    }
+  };
+
+  template <class F>
+  struct raw_impl {
+    F f;
+
+    bool operator()(message& msg) {
+      return f(msg);
+    }
+  };
+
+  struct vtable {
+    bool (*invoke)(void*, message&);
+    void (*move)(void*, void*) noexcept;
+    void (*destroy)(void*) noexcept;
+    bool is_inline;
+  };
+
+  template <class T>
+  static constexpr bool fits_inline() {
+    return sizeof(T) <= storage_size
+           && alignof(T) <= alignof(std::max_align_t)
+           && std::is_nothrow_move_constructible<T>::value;
+  }
+
+  template <class Fun>
+  static bool try_invoke(Fun& fun, message& msg) {
+    using trait = get_callable_trait_t<Fun>;
+    if (msg.types() != to_type_id_list<typename trait::decayed_arg_types>())
+      return false;
+    typename trait::message_view_type xs{msg};
+    apply_args(fun, xs);
+    return true;
+  }
+
+  template <class Impl>
+  void init(Impl&& x) {
+    if constexpr (fits_inline<Impl>()) {
+      new (storage_) Impl(std::move(x));
+      vtbl_ = &inline_vtable<Impl>;
+    } else {
+      new (storage_) Impl*(new Impl(std::move(x)));
+      vtbl_ = &heap_vtable<Impl>;
+    }
+  }
+
+  template <class Impl>
+  static constexpr vtable inline_vtable = {
+    [](void* ptr, message& msg) {
+      return (*static_cast<Impl*>(ptr))(msg);
+    },
+    [](void* from, void* to) noexcept {
+      auto src = static_cast<Impl*>(from);
+      new (to) Impl(std::move(*src));
+      src->~Impl();
+    },
+    [](void* ptr) noexcept { static_cast<Impl*>(ptr)->~Impl(); },
+    true,
+  };
+
+  template <class Impl>
+  static constexpr vtable heap_vtable = {
+    [](void* ptr, message& msg) {
+      return (**static_cast<Impl**>(ptr))(msg);
+    },
+    [](void* from, void* to) noexcept {
+      new (to) Impl*(*static_cast<Impl**>(from));
+    },
+    [](void* ptr) noexcept { delete *static_cast<Impl**>(ptr); },
+    false,
+  };
+
+  // -- member variables -------------------------------------------------------
+
+  alignas(std::max_align_t) byte storage_[storage_size];
+
+  const vtable* vtbl_;
+};
+
+} // namespace caf::detail
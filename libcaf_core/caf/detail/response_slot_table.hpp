@@ -0,0 +1,114 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/response_continuation.hpp"
+#include "caf/detail/timeout_token.hpp"
+#include "caf/message_id.hpp"
+
+namespace caf::detail {
+
+/// Stores the timeout tokens and continuations for pending requests of an
+/// actor, indexed by response ID. The table uses open addressing with linear
+/// probing and recycles its slots, i.e., it only allocates memory when the
+/// number of pending requests exceeds its capacity.
+class CAF_CORE_EXPORT response_slot_table {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Number of slots the table allocates on first use.
+  static constexpr size_t initial_capacity = 16;
+
+  // -- member types -----------------------------------------------------------
+
+  /// Stores the state for a single pending request.
+  struct slot {
+    /// Identifies the expected response. A default-constructed ID marks an
+    /// empty slot.
+    message_id id;
+
+    /// Allows the clock to discard the request timeout, if present.
+    timeout_token_ptr token;
+
+    /// Handles the response, if present.
+    response_continuation continuation;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  response_slot_table() = default;
+
+  response_slot_table(const response_slot_table&) = delete;
+
+  response_slot_table& operator=(const response_slot_table&) = delete;
+
+  ~response_slot_table();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of pending requests.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Queries whether the table contains no pending requests.
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /// Returns the number of pending requests with a continuation.
+  size_t continuations() const noexcept {
+    return continuations_;
+  }
+
+  /// Returns the number of slots in the table.
+  size_t capacity() const noexcept {
+    return slots_.size();
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Stores the token for the request timeout of `id`.
+  void set_token(message_id id, timeout_token_ptr token);
+
+  /// Stores the continuation for handling the response with ID `id`.
+  void set_continuation(message_id id, response_continuation f);
+
+  /// Disposes the timeout token for `id` and removes the slot for `id` unless
+  /// it still has a continuation.
+  void dispose_token(message_id id) noexcept;
+
+  /// Removes the slot for `id` and returns its continuation (if any).
+  response_continuation take_continuation(message_id id) noexcept;
+
+  /// Disposes all timeout tokens and destroys all continuations.
+  void clear() noexcept;
+
+private:
+  size_t index_of(message_id id) const noexcept {
+    return static_cast<size_t>(id.request_id().integer_value())
+           & (slots_.size() - 1);
+  }
+
+  slot* find(message_id id) noexcept;
+
+  slot& find_or_insert(message_id id);
+
+  void erase(slot& x) noexcept;
+
+  void grow();
+
+  std::vector<slot> slots_;
+
+  size_t size_ = 0;
+
+  size_t continuations_ = 0;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,51 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/error.hpp"
+#include "caf/fwd.hpp"
+#include "caf/telemetry/collector/shared_memory.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::detail {
+
+/// Periodically publishes the metrics of an actor system to a memory-mapped
+/// file from a background thread. The actor system runs an exporter when the
+/// configuration sets `caf.metrics-shm.path`.
+class CAF_CORE_EXPORT shared_memory_exporter {
+public:
+  shared_memory_exporter(actor_system& sys, timespan interval);
+
+  shared_memory_exporter(const shared_memory_exporter&) = delete;
+
+  shared_memory_exporter& operator=(const shared_memory_exporter&) = delete;
+
+  ~shared_memory_exporter();
+
+  /// Creates the file at `path` and starts the background thread.
+  error start(const std::string& path);
+
+  /// Stops the background thread and removes the file.
+  void stop();
+
+private:
+  void run();
+
+  actor_system& sys_;
+  timespan interval_;
+  telemetry::collector::shared_memory collector_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool stopped_ = false;
+  std::thread thread_;
+};
+
+} // namespace caf::detail
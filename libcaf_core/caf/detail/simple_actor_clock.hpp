@@ -5,11 +5,13 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <map>
 #include <memory>
 
 #include "caf/actor_clock.hpp"
 #include "caf/actor_control_block.hpp"
+#include "caf/config.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/make_unique.hpp"
 #include "caf/group.hpp"
@@ -63,8 +65,23 @@ public:
 
     virtual ~event();
 
+    /// Allocates an event from a free list of recycled events. Threads that
+    /// submit many timeouts reuse the memory of destroyed events instead of
+    /// calling `malloc` for each event.
+    static void* operator new(size_t size);
+
+    /// Returns the memory of an event to the free list.
+    static void operator delete(void* ptr, size_t size) noexcept;
+
     /// Identifies the actual type of this object.
     event_type subtype;
+
+    /// Intrusive link for submitting events to `thread_safe_actor_clock`.
+    event* next_submission = nullptr;
+
+    /// Orders submissions to `thread_safe_actor_clock` relative to
+    /// `cancel_all` and `cancel_dispatch_loop`.
+    uint64_t submission_epoch = 0;
   };
 
   /// An event with a timeout attached to it.
@@ -78,6 +95,26 @@ public:
 
     /// Links back to the actor lookup map.
     actor_lookup_map::iterator backlink;
+
+    // -- intrusive state for timing_wheel_actor_clock -------------------------
+
+    /// Previous element in the timing wheel slot.
+    delayed_event* prev = nullptr;
+
+    /// Next element in the timing wheel slot.
+    delayed_event* next = nullptr;
+
+    /// Previous element in the list of timeouts for the same actor.
+    delayed_event* prev_of_actor = nullptr;
+
+    /// Next element in the list of timeouts for the same actor.
+    delayed_event* next_of_actor = nullptr;
+
+    /// Discrete point in time when the timing wheel triggers this event.
+    uint64_t tick = 0;
+
+    /// Index of the timing wheel slot that currently stores this event.
+    uint32_t slot = 0;
   };
 
   /// An ordinary timeout event for actors. Only one timeout for any timeout
@@ -123,15 +160,20 @@ public:
   struct request_timeout final : delayed_event {
     static constexpr bool cancellable = true;
 
-    request_timeout(time_point due, strong_actor_ptr self, message_id id)
+    request_timeout(time_point due, strong_actor_ptr self, message_id id,
+                    timeout_token_ptr token = nullptr)
       : delayed_event(request_timeout_type, due),
         self(std::move(self)),
-        id(id) {
+        id(id),
+        token(std::move(token)) {
       // nop
     }
 
     strong_actor_ptr self;
     message_id id;
+
+    /// Allows the actor to discard the timeout without a cancellation event.
+    timeout_token_ptr token;
   };
 
   /// A delayed ::message to an actor.
@@ -254,6 +296,17 @@ public:
     return actor_lookup_;
   }
 
+  /// Returns whether no timeout or delayed message is pending.
+  bool empty() const noexcept {
+    return schedule_.empty();
+  }
+
+  /// Returns the time point of the next pending event.
+  /// @pre `!empty()`
+  time_point next_timeout() const noexcept {
+    return schedule_.begin()->first;
+  }
+
   // -- convenience functions --------------------------------------------------
 
   /// Triggers all timeouts with timestamp <= now.
@@ -261,6 +314,15 @@ public:
   /// @private
   size_t trigger_expired_timeouts();
 
+  /// Adds a delayed event or applies a cancellation that another thread has
+  /// submitted via `thread_safe_actor_clock`.
+  /// @private
+  void process(unique_event_ptr x);
+
+  /// Delivers the timeout or message stored in `x`.
+  /// @private
+  static void ship(delayed_event& x);
+
   // -- overridden member functions --------------------------------------------
 
   void set_ordinary_timeout(time_point t, abstract_actor* self,
@@ -272,6 +334,9 @@ public:
   void set_request_timeout(time_point t, abstract_actor* self,
                            message_id id) override;
 
+  void set_request_timeout(time_point t, abstract_actor* self, message_id id,
+                           timeout_token_ptr token) override;
+
   void cancel_ordinary_timeout(abstract_actor* self, std::string type) override;
 
   void cancel_request_timeout(abstract_actor* self, message_id id) override;
@@ -323,8 +388,6 @@ protected:
 
   void handle(const timeouts_cancellation& x);
 
-  void ship(delayed_event& x);
-
   template <class T>
   detail::enable_if_t<T::cancellable>
   add_schedule_entry(time_point t, std::unique_ptr<T> x) {
@@ -10,24 +10,55 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "caf/abstract_actor.hpp"
+#include "caf/config.hpp"
 #include "caf/detail/core_export.hpp"
-#include "caf/detail/ringbuffer.hpp"
 #include "caf/detail/simple_actor_clock.hpp"
+#include "caf/detail/timing_wheel_actor_clock.hpp"
 
 namespace caf::detail {
 
+/// Runs a simple actor clock (or a timing wheel) in a dedicated thread. Other
+/// threads submit events to lock-free buffers that the dispatch loop drains in
+/// batches, i.e., submitting events never blocks while waiting for the clock.
 class CAF_CORE_EXPORT thread_safe_actor_clock : public simple_actor_clock {
 public:
   // -- constants --------------------------------------------------------------
 
-  static constexpr size_t buffer_size = 64;
+  /// Number of submission buffers. Producers select a buffer based on the ID
+  /// of the actor an event belongs to. Hence, the dispatch loop sees all
+  /// events for the same actor in submission order, regardless of which
+  /// thread submitted them.
+  static constexpr size_t num_buffers = 32;
 
   // -- member types -----------------------------------------------------------
 
   using super = simple_actor_clock;
 
+  // -- constructors, destructors, and assignment operators --------------------
+
+  thread_safe_actor_clock();
+
+  thread_safe_actor_clock(const thread_safe_actor_clock&) = delete;
+
+  thread_safe_actor_clock& operator=(const thread_safe_actor_clock&) = delete;
+
+  ~thread_safe_actor_clock() override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Stores timeouts and delayed messages in a hierarchical timing wheel with
+  /// the given tick interval instead of a sorted map.
+  /// @pre The dispatch loop is not running yet.
+  void use_timing_wheel(duration_type tick_interval);
+
+  /// Returns the timing wheel if the clock uses one, `nullptr` otherwise.
+  const timing_wheel_actor_clock* wheel() const noexcept {
+    return wheel_.get();
+  }
+
   // -- member functions -------------------------------------------------------
 
   void set_ordinary_timeout(time_point t, abstract_actor* self,
@@ -36,6 +67,9 @@ public:
   void set_request_timeout(time_point t, abstract_actor* self,
                            message_id id) override;
 
+  void set_request_timeout(time_point t, abstract_actor* self, message_id id,
+                           timeout_token_ptr token) override;
+
   void set_multi_timeout(time_point t, abstract_actor* self, std::string type,
                          uint64_t id) override;
 
@@ -58,13 +92,62 @@ public:
   void cancel_dispatch_loop();
 
 private:
-  void push(event* ptr);
+  /// A lock-free stack of submitted events.
+  struct alignas(CAF_CACHE_LINE_SIZE) submission_buffer {
+    std::atomic<event*> head{nullptr};
+  };
+
+  /// Submits `ptr` to the buffer for `key`.
+  void push(event* ptr, actor_id key);
+
+  /// Submits a control event such as `drop_all` or `shutdown`. The dispatch
+  /// loop applies control events only after processing all events that other
+  /// threads submitted before, regardless of their buffer.
+  void push_control(event* ptr);
+
+  /// Adds `ptr` to `buf` and wakes up the dispatch loop if necessary.
+  void push(submission_buffer& buf, event* ptr);
+
+  /// Returns whether at least one buffer contains submitted events.
+  bool has_submissions() const noexcept;
+
+  /// Blocks until producers submit new events or until the next event of
+  /// `backend` becomes due.
+  /// @returns `false` on a timeout, `true` otherwise.
+  template <class Backend>
+  bool wait_for_submissions(Backend& backend);
+
+  template <class Backend>
+  void run_dispatch_loop(Backend& backend);
 
   /// Receives timer events from other threads.
-  detail::ringbuffer<unique_event_ptr, buffer_size> queue_;
+  std::array<submission_buffer, num_buffers> buffers_;
+
+  /// Receives control events from other threads.
+  submission_buffer control_;
+
+  /// Stores the epoch of the latest control event. Each event carries the
+  /// epoch at the time of its submission.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<uint64_t> epoch_;
+
+  /// Serializes the submission of control events.
+  std::mutex control_mtx_;
+
+  /// Stores drained events that belong to a control event that the dispatch
+  /// loop did not receive yet.
+  std::vector<event*> batch_;
+
+  /// Signals producers that the dispatch loop waits for new events.
+  std::atomic<bool> sleeping_;
+
+  /// Protects `cv_`.
+  std::mutex mtx_;
+
+  /// Wakes up the dispatch loop.
+  std::condition_variable cv_;
 
-  /// Locally caches events for processing.
-  std::array<unique_event_ptr, buffer_size> events_;
+  /// Replaces the schedule of the base type if set.
+  std::unique_ptr<timing_wheel_actor_clock> wheel_;
 };
 
 } // namespace caf::detail
@@ -0,0 +1,60 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <new>
+
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/memory_pool.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/raise_error.hpp"
+#include "caf/ref_counted.hpp"
+
+namespace caf::detail {
+
+/// Shared state between an actor and the clock for a single request timeout.
+/// The actor disposes the token when the response arrives, which causes the
+/// clock to discard the timeout instead of delivering a stale error.
+class CAF_CORE_EXPORT timeout_token : public ref_counted {
+public:
+  timeout_token() : disposed_(false) {
+    // nop
+  }
+
+  ~timeout_token() override;
+
+#ifdef CAF_ENABLE_MEMORY_POOL
+  /// Allocates tokens from the @ref memory_pool.
+  static void* operator new(size_t size) {
+    if (auto ptr = memory_pool::allocate(size))
+      return ptr;
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    memory_pool::deallocate(ptr);
+  }
+#endif // CAF_ENABLE_MEMORY_POOL
+
+  /// Marks the timeout as obsolete. Safe to call from any thread.
+  void dispose() noexcept {
+    disposed_.store(true, std::memory_order_relaxed);
+  }
+
+  /// Queries whether the owner disposed the timeout.
+  bool disposed() const noexcept {
+    return disposed_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<bool> disposed_;
+};
+
+/// @relates timeout_token
+using timeout_token_ptr = intrusive_ptr<timeout_token>;
+
+} // namespace caf::detail
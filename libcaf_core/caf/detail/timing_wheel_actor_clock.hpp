@@ -0,0 +1,240 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "caf/actor_clock.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/simple_actor_clock.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::detail {
+
+/// An actor clock that stores timeouts and delayed messages in a hierarchical
+/// timing wheel. Adding and cancelling events runs in constant time. In
+/// exchange, the clock triggers events at the granularity of its tick
+/// interval: an event fires at the first tick boundary after its due time
+/// and events that fall into the same tick fire in insertion order.
+class CAF_CORE_EXPORT timing_wheel_actor_clock : public actor_clock {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using event = simple_actor_clock::event;
+
+  using delayed_event = simple_actor_clock::delayed_event;
+
+  using unique_event_ptr = simple_actor_clock::unique_event_ptr;
+
+  using ordinary_timeout = simple_actor_clock::ordinary_timeout;
+
+  using multi_timeout = simple_actor_clock::multi_timeout;
+
+  using request_timeout = simple_actor_clock::request_timeout;
+
+  using actor_msg = simple_actor_clock::actor_msg;
+
+  using group_msg = simple_actor_clock::group_msg;
+
+  /// Intrusive list of events in a single slot.
+  struct slot_list {
+    delayed_event* head = nullptr;
+    delayed_event* tail = nullptr;
+  };
+
+  /// Identifies a request timeout.
+  using request_key = std::pair<actor_id, uint64_t>;
+
+  /// Hash function for request keys.
+  struct request_key_hash {
+    size_t operator()(const request_key& x) const noexcept {
+      return std::hash<uint64_t>{}(x.first * 0x9E3779B97F4A7C15ull ^ x.second);
+    }
+  };
+
+  // -- constants --------------------------------------------------------------
+
+  /// Number of bits for the slot index on each level.
+  static constexpr size_t slot_bits = 8;
+
+  /// Number of slots on each level.
+  static constexpr size_t num_slots = size_t{1} << slot_bits;
+
+  /// Number of levels. Events that lie more than `num_slots ^ num_levels`
+  /// ticks in the future wait in an overflow list.
+  static constexpr size_t num_levels = 4;
+
+  /// Slot index of the overflow list.
+  static constexpr uint32_t overflow_slot = num_levels * num_slots;
+
+  /// Slot index of the list for events that are already due.
+  static constexpr uint32_t expired_slot = overflow_slot + 1;
+
+  /// Default duration of a single tick.
+  static constexpr auto default_tick_interval = timespan{1'000'000};
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit timing_wheel_actor_clock(
+    duration_type tick_interval = default_tick_interval);
+
+  timing_wheel_actor_clock(const timing_wheel_actor_clock&) = delete;
+
+  timing_wheel_actor_clock& operator=(const timing_wheel_actor_clock&) = delete;
+
+  ~timing_wheel_actor_clock() override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the duration of a single tick.
+  duration_type tick_interval() const noexcept {
+    return tick_interval_;
+  }
+
+  /// Returns the number of pending timeouts and delayed messages.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns whether no timeout or delayed message is pending.
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /// Returns a time point that is no later than the next pending event. The
+  /// clock may have nothing to trigger at that time if it only needs to move
+  /// events from a higher level of the wheel to a lower one.
+  /// @pre `!empty()`
+  time_point next_timeout() const noexcept;
+
+  // -- convenience functions --------------------------------------------------
+
+  /// Triggers all timeouts with timestamp <= now.
+  /// @returns The number of triggered timeouts.
+  /// @private
+  size_t trigger_expired_timeouts();
+
+  /// Adds a delayed event or applies a cancellation that another thread has
+  /// submitted via `thread_safe_actor_clock`.
+  /// @private
+  void process(unique_event_ptr x);
+
+  // -- overridden member functions --------------------------------------------
+
+  void set_ordinary_timeout(time_point t, abstract_actor* self,
+                            std::string type, uint64_t id) override;
+
+  void set_multi_timeout(time_point t, abstract_actor* self, std::string type,
+                         uint64_t id) override;
+
+  void set_request_timeout(time_point t, abstract_actor* self,
+                           message_id id) override;
+
+  void set_request_timeout(time_point t, abstract_actor* self, message_id id,
+                           timeout_token_ptr token) override;
+
+  void cancel_ordinary_timeout(abstract_actor* self, std::string type) override;
+
+  void cancel_request_timeout(abstract_actor* self, message_id id) override;
+
+  void cancel_timeouts(abstract_actor* self) override;
+
+  void schedule_message(time_point t, strong_actor_ptr receiver,
+                        mailbox_element_ptr content) override;
+
+  void schedule_message(time_point t, group target, strong_actor_ptr sender,
+                        message content) override;
+
+  void cancel_all() override;
+
+private:
+  // -- time conversion --------------------------------------------------------
+
+  /// Returns the first tick at or after `t`.
+  uint64_t ceil_tick(time_point t) const noexcept;
+
+  /// Returns the last tick at or before `t`.
+  uint64_t floor_tick(time_point t) const noexcept;
+
+  // -- slot management --------------------------------------------------------
+
+  /// Returns the next tick at which the wheel needs to expire or cascade a
+  /// slot and stores the level of that slot in `level`.
+  /// @pre `size_ > 0`
+  uint64_t next_tick(size_t& level) const noexcept;
+
+  /// Returns the first non-empty slot on `level` with an index greater than
+  /// `pos` or `num_slots` if no such slot exists.
+  size_t find_next(size_t level, size_t pos) const noexcept;
+
+  /// Adds `x` to the slot matching `x->tick`.
+  void insert(delayed_event* x);
+
+  /// Removes `x` from its slot.
+  void erase_from_slot(delayed_event* x) noexcept;
+
+  /// Removes all events from the slot at `index` and returns them as list.
+  delayed_event* take_slot(uint32_t index) noexcept;
+
+  // -- event management -------------------------------------------------------
+
+  /// Takes ownership of `x` and schedules it.
+  void add(delayed_event* x);
+
+  /// Removes `x` from all data structures without destroying it.
+  void unlink(delayed_event* x) noexcept;
+
+  /// Removes and destroys `x`.
+  void drop(delayed_event* x) noexcept;
+
+  /// Removes `x` from all data structures and ships it.
+  void fire(delayed_event* x);
+
+  /// Returns the actor of a cancellable event or `nullptr` for messages.
+  static const strong_actor_ptr* owner(const delayed_event& x) noexcept;
+
+  /// Finds the ordinary timeout of type `type` for `aid`.
+  delayed_event* find_ordinary_timeout(actor_id aid, const std::string& type);
+
+  /// Cancels the ordinary timeout of type `type` for `aid`.
+  void cancel_ordinary_timeout(actor_id aid, const std::string& type);
+
+  /// Cancels the request timeout for `aid` and `id`.
+  void cancel_request_timeout(actor_id aid, message_id id);
+
+  /// Cancels all timeouts for `aid`.
+  void cancel_timeouts(actor_id aid);
+
+  // -- member variables -------------------------------------------------------
+
+  /// Duration of a single tick.
+  duration_type tick_interval_;
+
+  /// The last tick that the wheel processed.
+  uint64_t current_tick_;
+
+  /// Number of events in all slots.
+  size_t size_;
+
+  /// Stores all slots of all levels, followed by the overflow list and the
+  /// list of expired events.
+  std::array<slot_list, num_levels * num_slots + 2> slots_;
+
+  /// Marks non-empty slots on each level.
+  std::array<uint64_t, num_levels * num_slots / 64> bitmap_;
+
+  /// Maps actor IDs to the list of cancellable events for that actor.
+  std::unordered_map<actor_id, delayed_event*> actor_lookup_;
+
+  /// Maps request IDs to their timeout.
+  std::unordered_map<request_key, delayed_event*, request_key_hash>
+    request_lookup_;
+};
+
+} // namespace caf::detail
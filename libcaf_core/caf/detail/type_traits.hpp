@@ -446,7 +446,9 @@ public:
 
 CAF_HAS_MEMBER_TRAIT(clear);
 CAF_HAS_MEMBER_TRAIT(data);
+CAF_HAS_MEMBER_TRAIT(enable_per_thread_storage);
 CAF_HAS_MEMBER_TRAIT(make_behavior);
+CAF_HAS_MEMBER_TRAIT(prefetch_content);
 CAF_HAS_MEMBER_TRAIT(size);
 
 /// Checks whether F is convertible to either `std::function<void (T&)>`
@@ -91,6 +91,7 @@ class behavior;
 class binary_deserializer;
 class binary_serializer;
 class blocking_actor;
+class co_handler;
 class config_option;
 class config_option_adder;
 class config_option_set;
@@ -144,6 +145,7 @@ class stateful_actor;
 
 // -- structs ------------------------------------------------------------------
 
+struct backpressure_msg;
 struct down_msg;
 struct downstream_msg;
 struct downstream_msg_batch;
@@ -154,6 +156,7 @@ struct group_down_msg;
 struct illegal_message_element;
 struct invalid_actor_addr_t;
 struct invalid_actor_t;
+struct mailbox_element_deleter;
 struct node_down_msg;
 struct none_t;
 struct open_stream_msg;
@@ -352,6 +355,7 @@ class dynamic_message_data;
 class group_manager;
 class message_data;
 class private_thread;
+class shared_memory_exporter;
 
 struct meta_object;
 
@@ -377,7 +381,8 @@ using strong_actor_ptr = intrusive_ptr<actor_control_block>;
 
 // -- unique pointer aliases ---------------------------------------------------
 
-using mailbox_element_ptr = std::unique_ptr<mailbox_element>;
+using mailbox_element_ptr
+  = std::unique_ptr<mailbox_element, mailbox_element_deleter>;
 using tracing_data_ptr = std::unique_ptr<tracing_data>;
 
 } // namespace caf
@@ -10,6 +10,7 @@
 #include "caf/actor_clock.hpp"
 #include "caf/actor_control_block.hpp"
 #include "caf/credit_controller.hpp"
+#include "caf/detail/config_snapshot.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/size_based_credit_controller.hpp"
 #include "caf/detail/token_based_credit_controller.hpp"
@@ -54,23 +55,11 @@ public:
   template <class T>
   inbound_path(stream_manager* mgr, stream<T> in)
     : inbound_path(mgr, type_id_v<T>) {
-    auto& cfg = config();
-    auto set_default = [this, in] {
+    using policy = detail::config_snapshot::credit_policy;
+    if (credit_policy() == policy::token_based)
+      controller_ = detail::token_based_credit_controller::make(self(), in);
+    else
       controller_ = detail::size_based_credit_controller::make(self(), in);
-    };
-    if (auto str = get_if<std::string>(&cfg, "caf.stream.credit-policy")) {
-      if (*str == "token-based")
-        controller_ = detail::token_based_credit_controller::make(self(), in);
-      else if (*str == "size-based")
-        set_default();
-      else {
-        set_default();
-        CAF_LOG_WARNING("unrecognized credit policy:"
-                        << *str << "(falling back to 'size-based')");
-      }
-    } else {
-      set_default();
-    }
   }
 
   void init(strong_actor_ptr source_hdl, stream_slots id);
@@ -136,6 +125,9 @@ public:
   /// Returns the system-wide configuration.
   const settings& config() const noexcept;
 
+  /// Returns the configured credit policy for new paths.
+  detail::config_snapshot::credit_policy credit_policy() const noexcept;
+
   // -- callbacks --------------------------------------------------------------
 
   /// Updates `last_batch_id` and `assigned_credit` before dispatching to the
@@ -9,6 +9,7 @@
 
 #include "caf/config.hpp"
 
+#include "caf/detail/prefetch.hpp"
 #include "caf/intrusive/new_round_result.hpp"
 #include "caf/intrusive/task_queue.hpp"
 #include "caf/intrusive/task_result.hpp"
@@ -177,6 +178,8 @@ public:
       return {0, false};
     size_t consumed = 0;
     do {
+      // Start loading upcoming tasks while the consumer runs.
+      detail::prefetch_ahead(list_.peek());
       auto consumer_res = consumer(*ptr);
       switch (consumer_res) {
         case task_result::skip:
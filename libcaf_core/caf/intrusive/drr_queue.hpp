@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "caf/detail/prefetch.hpp"
 #include "caf/intrusive/new_round_result.hpp"
 #include "caf/intrusive/task_queue.hpp"
 #include "caf/intrusive/task_result.hpp"
@@ -88,6 +89,8 @@ public:
         return {0, false};
       do {
         ++consumed;
+        // Start loading upcoming tasks while the consumer runs.
+        detail::prefetch_ahead(super::peek());
         switch (consumer(*ptr)) {
           default:
             break;
@@ -61,6 +61,15 @@ public:
 
     /// Counts how many messages are currently waiting in the mailbox.
     telemetry::int_gauge* mailbox_size = nullptr;
+
+    /// Tracks how many messages the actor may consume per resume.
+    telemetry::int_gauge* throughput_budget = nullptr;
+
+    /// Tracks the average time the actor needs to process a message.
+    telemetry::dbl_gauge* message_cost = nullptr;
+
+    /// Counts messages that the actor discarded due to a full mailbox.
+    telemetry::int_counter* dropped_messages = nullptr;
   };
 
   /// Optional metrics for inbound stream traffic collected by individual actors
@@ -97,6 +106,10 @@ public:
   // constructor.
   void setup_metrics();
 
+  // Like `setup_metrics()`, but copies the metric handles from `prototype` if
+  // both actors have the same name. Allows bulk spawns to skip the lookups.
+  void setup_metrics(const local_actor& prototype);
+
   // -- pure virtual modifiers -------------------------------------------------
 
   virtual void launch(execution_unit* eu, bool lazy, bool hide) = 0;
@@ -110,7 +123,7 @@ public:
 
   /// Requests a new timeout for `mid`.
   /// @pre `mid.is_request()`
-  void request_response_timeout(timespan d, message_id mid);
+  virtual void request_response_timeout(timespan d, message_id mid);
 
   // -- spawn functions --------------------------------------------------------
 
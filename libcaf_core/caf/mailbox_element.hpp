@@ -10,6 +10,9 @@
 
 #include "caf/actor_control_block.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/memory_pool.hpp"
+#include "caf/detail/prefetch.hpp"
+#include "caf/raise_error.hpp"
 #include "caf/intrusive/singly_linked.hpp"
 #include "caf/message.hpp"
 #include "caf/message_id.hpp"
@@ -17,11 +20,22 @@
 
 namespace caf {
 
+/// Destroys mailbox elements, including elements that share their memory
+/// block with their content.
+/// @relates mailbox_element
+struct CAF_CORE_EXPORT mailbox_element_deleter {
+  void operator()(mailbox_element* ptr) const noexcept;
+};
+
 class CAF_CORE_EXPORT mailbox_element
   : public intrusive::singly_linked<mailbox_element> {
 public:
   using forwarding_stack = std::vector<strong_actor_ptr>;
 
+  /// Maximum size of the content (including padding) for storing the content
+  /// in the same memory block as the element.
+  static constexpr size_t max_inline_payload_size = 64;
+
   /// Source of this message and receiver of the final response.
   strong_actor_ptr sender;
 
@@ -72,11 +86,41 @@ public:
     return mid.category() == message_id::urgent_message_category;
   }
 
+  /// Hints the processor to load the content of this element into the cache
+  /// ahead of processing it. Reads the pointer to the content, i.e., callers
+  /// should prefetch the element itself first.
+  void prefetch_content() const noexcept {
+    detail::prefetch(static_cast<const void*>(payload.cptr()));
+  }
+
   mailbox_element(mailbox_element&&) = delete;
   mailbox_element(const mailbox_element&) = delete;
   mailbox_element& operator=(mailbox_element&&) = delete;
   mailbox_element& operator=(const mailbox_element&) = delete;
 
+#ifdef CAF_ENABLE_MEMORY_POOL
+  // -- memory management ------------------------------------------------------
+
+  static void* operator new(size_t size) {
+    if (auto ptr = detail::memory_pool::allocate(size))
+      return ptr;
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    detail::memory_pool::deallocate(ptr);
+  }
+#endif // CAF_ENABLE_MEMORY_POOL
+
+  // -- factory functions ------------------------------------------------------
+
+  /// Creates a mailbox element and its content with a single allocation.
+  /// @private
+  template <class... Ts>
+  static mailbox_element_ptr
+  make_inline(strong_actor_ptr sender, message_id mid, forwarding_stack stages,
+              Ts&&... xs);
+
   // -- backward compatibility -------------------------------------------------
 
   message& content() noexcept {
@@ -86,8 +130,43 @@ public:
   const message& content() const noexcept {
     return payload;
   }
+
+private:
+  friend struct mailbox_element_deleter;
+
+  /// Points to the content if it shares its memory block with this element.
+  detail::message_data* block_ = nullptr;
 };
 
+template <class... Ts>
+mailbox_element_ptr
+mailbox_element::make_inline(strong_actor_ptr sender, message_id mid,
+                             forwarding_stack stages, Ts&&... xs) {
+  using namespace detail;
+  static_assert((!std::is_pointer<strip_and_convert_t<Ts>>::value && ...));
+  static_assert((is_complete<type_id<strip_and_convert_t<Ts>>> && ...));
+  // The memory block starts with the message data, because the data frees the
+  // block once its last reference is gone.
+  static constexpr size_t data_size
+    = sizeof(message_data) + (padded_size_v<strip_and_convert_t<Ts>> + ...);
+  static constexpr size_t offset = (data_size + alignof(mailbox_element) - 1)
+                                   / alignof(mailbox_element)
+                                   * alignof(mailbox_element);
+  auto vptr = message_data::allocate(offset + sizeof(mailbox_element));
+  if (vptr == nullptr)
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  auto types = make_type_id_list<strip_and_convert_t<Ts>...>();
+  auto raw_data = new (vptr) message_data(types);
+  message::data_ptr data{raw_data, false};
+  raw_data->init(std::forward<Ts>(xs)...);
+  raw_data->add_element_ref();
+  auto result = ::new (static_cast<byte*>(vptr) + offset)
+    mailbox_element(std::move(sender), mid, std::move(stages),
+                    message{std::move(data)});
+  result->block_ = raw_data;
+  return mailbox_element_ptr{result};
+}
+
 /// @relates mailbox_element
 template <class Inspector>
 bool inspect(Inspector& f, mailbox_element& x) {
@@ -100,7 +179,8 @@ bool inspect(Inspector& f, mailbox_element& x) {
 }
 
 /// @relates mailbox_element
-using mailbox_element_ptr = std::unique_ptr<mailbox_element>;
+using mailbox_element_ptr
+  = std::unique_ptr<mailbox_element, mailbox_element_deleter>;
 
 /// @relates mailbox_element
 CAF_CORE_EXPORT mailbox_element_ptr
@@ -115,9 +195,18 @@ std::enable_if_t<!std::is_same<typename std::decay<T>::type, message>::value
 make_mailbox_element(strong_actor_ptr sender, message_id id,
                      mailbox_element::forwarding_stack stages, T&& x,
                      Ts&&... xs) {
-  return make_mailbox_element(std::move(sender), id, std::move(stages),
-                              make_message(std::forward<T>(x),
-                                           std::forward<Ts>(xs)...));
+  using detail::padded_size_v;
+  using detail::strip_and_convert_t;
+  if constexpr ((padded_size_v<strip_and_convert_t<T>> + ...
+                 + padded_size_v<strip_and_convert_t<Ts>>)
+                <= mailbox_element::max_inline_payload_size)
+    return mailbox_element::make_inline(std::move(sender), id,
+                                        std::move(stages), std::forward<T>(x),
+                                        std::forward<Ts>(xs)...);
+  else
+    return make_mailbox_element(std::move(sender), id, std::move(stages),
+                                make_message(std::forward<T>(x),
+                                             std::forward<Ts>(xs)...));
 }
 
 } // namespace caf
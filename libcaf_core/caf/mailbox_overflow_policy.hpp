@@ -0,0 +1,50 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "caf/default_enum_inspect.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+namespace caf {
+
+/// Selects how an actor with a bounded mailbox handles new messages once its
+/// mailbox reached the configured capacity. Rejected requests always receive
+/// `sec::mailbox_full` as response, regardless of the policy.
+enum class mailbox_overflow_policy : uint8_t {
+  /// Discards the new message.
+  drop_newest,
+  /// Accepts the new message and discards the oldest waiting message instead.
+  drop_oldest,
+  /// Discards the new message and sends `sec::mailbox_full` to the sender.
+  /// @note asynchronous senders receive the error as ordinary message, i.e.,
+  ///       the error handler of the sender runs.
+  reject,
+  /// Accepts the new message but sends a `backpressure_msg` to the sender.
+  signal,
+};
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT std::string to_string(mailbox_overflow_policy x);
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT bool from_string(string_view, mailbox_overflow_policy&);
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT bool
+from_integer(std::underlying_type_t<mailbox_overflow_policy>,
+             mailbox_overflow_policy&);
+
+/// @relates mailbox_overflow_policy
+template <class Inspector>
+bool inspect(Inspector& f, mailbox_overflow_policy& x) {
+  return default_enum_inspect(f, x);
+}
+
+} // namespace caf
@@ -16,8 +16,13 @@
 
 namespace caf {
 
-template <class T, class R = infer_handle_from_class_t<T>, class... Ts>
-R make_actor(actor_id aid, node_id nid, actor_system* sys, Ts&&... xs) {
+namespace detail {
+
+/// Creates a new actor of type `T` and calls `setup` on the new actor before
+/// returning the handle.
+template <class T, class R, class Setup, class... Ts>
+R make_actor_impl(Setup& setup, actor_id aid, node_id nid, actor_system* sys,
+                  Ts&&... xs) {
 #if CAF_LOG_LEVEL >= CAF_LOG_LEVEL_DEBUG
   if (logger::current_logger()->accepts(CAF_LOG_LEVEL_DEBUG,
                                         CAF_LOG_FLOW_COMPONENT)) {
@@ -30,15 +35,24 @@ R make_actor(actor_id aid, node_id nid, actor_system* sys, Ts&&... xs) {
                                  std::forward<Ts>(xs)...);
     }
     CAF_LOG_SPAWN_EVENT(ptr->data, args);
-    ptr->data.setup_metrics();
+    setup(ptr->data);
     return {&(ptr->ctrl), false};
   }
 #endif
   CAF_PUSH_AID(aid);
   auto ptr = new actor_storage<T>(aid, std::move(nid), sys,
                                   std::forward<Ts>(xs)...);
-  ptr->data.setup_metrics();
+  setup(ptr->data);
   return {&(ptr->ctrl), false};
 }
 
+} // namespace detail
+
+template <class T, class R = infer_handle_from_class_t<T>, class... Ts>
+R make_actor(actor_id aid, node_id nid, actor_system* sys, Ts&&... xs) {
+  auto setup = [](T& self) { self.setup_metrics(); };
+  return detail::make_actor_impl<T, R>(setup, aid, std::move(nid), sys,
+                                       std::forward<Ts>(xs)...);
+}
+
 } // namespace caf
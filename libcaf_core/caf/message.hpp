@@ -211,7 +211,7 @@ message make_message(Ts&&... xs) {
   static constexpr size_t data_size
     = sizeof(message_data) + (padded_size_v<strip_and_convert_t<Ts>> + ...);
   auto types = make_type_id_list<strip_and_convert_t<Ts>...>();
-  auto vptr = malloc(data_size);
+  auto vptr = message_data::allocate(data_size);
   if (vptr == nullptr)
     CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
   auto raw_ptr = new (vptr) message_data(types);
@@ -42,10 +42,10 @@ public:
   void init(actor_system& system) {
     alive_ = true;
     companion_ = actor_cast<strong_actor_ptr>(system.spawn<actor_companion>());
-    self()->on_enqueue([=](mailbox_element_ptr ptr) {
+    self()->on_enqueue([this](mailbox_element_ptr ptr) {
       qApp->postEvent(this, new event_type(std::move(ptr)));
     });
-    self()->on_exit([=] {
+    self()->on_exit([this] {
       // close widget if actor companion dies
       this->close();
     });
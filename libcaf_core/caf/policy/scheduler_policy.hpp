@@ -28,6 +28,11 @@ public:
   template <class Coordinator>
   void central_enqueue(Coordinator* self, resumable* job);
 
+  /// Enqueues multiple jobs to the coordinator, waking up each receiving
+  /// worker at most once.
+  template <class Coordinator>
+  void central_bulk_enqueue(Coordinator* self, span<resumable* const> jobs);
+
   /// Enqueues a new job to the worker's queue from an
   /// external source, i.e., from any other thread.
   template <class Worker>
@@ -47,6 +52,11 @@ public:
   template <class Worker>
   resumable* dequeue(Worker* self);
 
+  /// Initializes worker-specific state. Called from the thread of the worker
+  /// before it enters its scheduling loop.
+  template <class Worker>
+  void init_worker(Worker* self);
+
   /// Performs cleanup action before a shutdown takes place.
   template <class Worker>
   void before_shutdown(Worker* self);
@@ -6,6 +6,7 @@
 
 #include "caf/behavior.hpp"
 #include "caf/config.hpp"
+#include "caf/detail/response_continuation.hpp"
 #include "caf/detail/type_list.hpp"
 #include "caf/detail/type_traits.hpp"
 #include "caf/detail/typed_actor_util.hpp"
@@ -42,8 +43,9 @@ public:
 
   template <class Self, class F, class OnError>
   void then(Self* self, F&& f, OnError&& g) const {
-    behavior bhvr{std::forward<F>(f), std::forward<OnError>(g)};
-    self->add_multiplexed_response_handler(mid_, std::move(bhvr));
+    detail::response_continuation cont{std::forward<F>(f),
+                                       std::forward<OnError>(g)};
+    self->add_multiplexed_response_handler(mid_, std::move(cont));
   }
 
   template <class Self, class F, class OnError>
@@ -18,6 +18,22 @@ class CAF_CORE_EXPORT unprofiled {
 public:
   virtual ~unprofiled();
 
+  /// Initializes worker-specific state. Called from the thread of the worker
+  /// before it enters its scheduling loop.
+  template <class Worker>
+  void init_worker(Worker*) {
+    // nop
+  }
+
+  /// Enqueues multiple jobs to the coordinator. The default implementation
+  /// simply enqueues one job after another.
+  template <class Coordinator>
+  void central_bulk_enqueue(Coordinator* self, span<resumable* const> jobs) {
+    auto base = static_cast<scheduler::abstract_coordinator*>(self);
+    for (auto job : jobs)
+      base->enqueue(job);
+  }
+
   /// Performs cleanup action before a shutdown takes place.
   template <class Worker>
   void before_shutdown(Worker*) {
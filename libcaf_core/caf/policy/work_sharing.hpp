@@ -12,6 +12,7 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/policy/unprofiled.hpp"
 #include "caf/resumable.hpp"
+#include "caf/span.hpp"
 
 namespace caf::policy {
 
@@ -54,6 +55,19 @@ public:
     enqueue(self, job);
   }
 
+  template <class Coordinator>
+  void central_bulk_enqueue(Coordinator* self, span<resumable* const> jobs) {
+    if (jobs.empty())
+      return;
+    queue_type l{jobs.begin(), jobs.end()};
+    std::unique_lock<std::mutex> guard(d(self).lock);
+    d(self).queue.splice(d(self).queue.end(), l);
+    if (jobs.size() == 1)
+      d(self).cv.notify_one();
+    else
+      d(self).cv.notify_all();
+  }
+
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     enqueue(self->parent(), job);
@@ -4,20 +4,28 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <random>
 #include <thread>
+#include <utility>
 
 #include "caf/actor_system_config.hpp"
+#include "caf/detail/chase_lev_deque.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/parking_lot.hpp"
 #include "caf/policy/unprofiled.hpp"
 #include "caf/resumable.hpp"
+#include "caf/span.hpp"
+#include "caf/telemetry/counter.hpp"
 #include "caf/timespan.hpp"
 
 namespace caf::policy {
@@ -31,6 +39,9 @@ public:
   // A thread-safe queue implementation.
   using queue_type = detail::double_ended_queue<resumable>;
 
+  // A lock-free queue implementation that allows only the owner to push.
+  using local_queue_type = detail::chase_lev_deque<resumable>;
+
   // configuration for aggressive/moderate/relaxed poll strategies.
   struct poll_strategy {
     size_t attempts;
@@ -56,35 +67,84 @@ public:
     std::atomic<size_t> next_worker;
   };
 
+  // Groups other workers by their distance to a worker.
+  struct victim_group {
+    // IDs of all workers in this group.
+    std::vector<size_t> workers;
+    // Counts how many jobs the worker stole from this group.
+    telemetry::int_counter* stolen_jobs = nullptr;
+  };
+
   // Holds job job queue of a worker and a random number generator.
   struct worker_data {
     explicit worker_data(scheduler::abstract_coordinator* p);
     worker_data(const worker_data& other);
 
+    // Computes the victims for the worker and pins its thread if configured.
+    // Must get called from the thread of the worker.
+    void init(size_t worker_id, size_t num_workers);
+
     // This queue is exposed to other workers that may attempt to steal jobs
     // from it and the central scheduling unit can push new jobs to the queue.
     queue_type queue;
+    // Receives jobs that the worker enqueues itself. Only the worker pushes to
+    // and pops from this queue, other workers may steal from its front.
+    local_queue_type local_queue;
     // needed to generate pseudo random numbers
     std::default_random_engine rengine;
-    std::uniform_int_distribution<size_t> uniform;
     std::array<poll_strategy, 3> strategies;
     wait_strategy waitdata;
+    // CPU topology of the host if pinning or locality-aware stealing is on.
+    std::shared_ptr<const detail::cpu_topology> topology;
+    // Configures whether the worker pins its thread to a CPU.
+    bool pin_workers;
+    // Configures whether the worker prefers victims that are close by.
+    bool locality_aware;
+    // Stores the job that the worker enqueued last. Only the worker itself
+    // accesses this slot, i.e., other workers cannot steal this job.
+    resumable* lifo_slot = nullptr;
+    // Counts how many jobs in a row the worker took from its LIFO slot.
+    size_t lifo_runs = 0;
+    // Limits how many jobs in a row the worker may take from its LIFO slot
+    // before polling its queues again. A value of 0 disables the LIFO slot.
+    size_t max_lifo_runs;
+    // Allows idle workers to park instead of polling. Shared by all workers
+    // and `nullptr` if workers use the polling strategies instead.
+    std::shared_ptr<detail::parking_lot> lot;
+    // Families for counting stolen jobs by locality.
+    telemetry::int_counter_family* stolen_jobs;
+    // Potential victims for stealing, ordered by preference. Without
+    // locality-aware stealing, only the first group contains workers.
+    std::array<victim_group, 4> victims;
   };
 
+  template <class Worker>
+  void init_worker(Worker* self) {
+    d(self).init(self->id(), self->parent()->num_workers());
+  }
+
   // Goes on a raid in quest for a shiny new job.
   template <class Worker>
   resumable* try_steal(Worker* self) {
-    auto p = self->parent();
-    if (p->num_workers() < 2) {
-      // you can't steal from yourself, can you?
-      return nullptr;
+    // try one random victim per group, starting with the closest workers
+    for (auto& group : d(self).victims) {
+      auto& workers = group.workers;
+      if (workers.empty())
+        continue;
+      // roll the dice to pick a victim
+      std::uniform_int_distribution<size_t> uniform{0, workers.size() - 1};
+      auto victim = workers[uniform(d(self).rengine)];
+      // steal oldest element from the victim's queues
+      auto& data = d(self->parent()->worker_by_id(victim));
+      auto job = data.local_queue.steal();
+      if (job == nullptr)
+        job = data.queue.take_tail();
+      if (job != nullptr) {
+        group.stolen_jobs->inc();
+        return job;
+      }
     }
-    // roll the dice to pick a victim other than ourselves
-    auto victim = d(self).uniform(d(self).rengine);
-    if (victim == self->id())
-      victim = p->num_workers() - 1;
-    // steal oldest element from the victim's queue
-    return d(p->worker_by_id(victim)).queue.take_tail();
+    return nullptr;
   }
 
   template <class Coordinator>
@@ -93,9 +153,37 @@ public:
     w->external_enqueue(job);
   }
 
+  template <class Coordinator>
+  void central_bulk_enqueue(Coordinator* self, span<resumable* const> jobs) {
+    if (jobs.empty())
+      return;
+    // advance the round-robin counter only once for all jobs and then give
+    // the worker at offset i the jobs i, i + n, i + 2n, etc.
+    auto n = self->num_workers();
+    auto first = d(self).next_worker.fetch_add(jobs.size());
+    auto num_receivers = std::min(n, jobs.size());
+    for (size_t i = 0; i < num_receivers; ++i) {
+      auto w = self->worker_by_id((first + i) % n);
+      for (auto j = i; j < jobs.size(); j += n)
+        d(w).queue.append(jobs[j]);
+      notify(w);
+    }
+  }
+
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     d(self).queue.append(job);
+    notify(self);
+  }
+
+  // Wakes up the worker if it waits for new jobs in its queue.
+  template <class Worker>
+  void notify(Worker* self) {
+    if (auto lot = d(self).lot.get()) {
+      // only wakes up the worker (i.e., does a syscall) if it is parked
+      lot->unpark(self->id());
+      return;
+    }
     auto& lock = d(self).waitdata.lock;
     auto& cv = d(self).waitdata.cv;
     { // guard scope
@@ -108,7 +196,21 @@ public:
 
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
-    d(self).queue.prepend(job);
+    auto& data = d(self);
+    auto& local_queue = data.local_queue;
+    auto surplus = !local_queue.empty();
+    if (data.max_lifo_runs > 0) {
+      // run the new job next, since its working set is most likely still in
+      // the cache, and move the previous occupant of the slot to the queue
+      job = std::exchange(data.lifo_slot, job);
+      if (job == nullptr)
+        return;
+      surplus = true;
+    }
+    local_queue.push_back(job);
+    // wake up an idle worker to steal our surplus work
+    if (auto lot = data.lot.get(); surplus && lot && lot->has_parked())
+      lot->unpark_any();
   }
 
   template <class Worker>
@@ -118,18 +220,40 @@ public:
     d(self).queue.append(job);
   }
 
+  // Takes the next job from the worker's own queues, preferring jobs that the
+  // worker enqueued itself.
+  template <class Worker>
+  resumable* take_head(Worker* self) {
+    auto& data = d(self);
+    if (auto job = std::exchange(data.lifo_slot, nullptr)) {
+      if (data.lifo_runs < data.max_lifo_runs) {
+        ++data.lifo_runs;
+        return job;
+      }
+      // prevent two actors that keep waking each other up from starving all
+      // other jobs by moving the job to the end of the queue
+      data.queue.append(job);
+    }
+    data.lifo_runs = 0;
+    if (auto job = data.local_queue.pop_back())
+      return job;
+    return data.queue.take_head();
+  }
+
   template <class Worker>
   resumable* dequeue(Worker* self) {
     // we wait for new jobs by polling our external queue: first, we
     // assume an active work load on the machine and perform aggressive
     // polling, then we relax our polling a bit and wait 50 us between
-    // dequeue attempts
+    // dequeue attempts (unless parking replaces moderate polling)
     auto& strategies = d(self).strategies;
+    auto lot = d(self).lot.get();
     resumable* job = nullptr;
-    for (size_t k = 0; k < 2; ++k) { // iterate over the first two strategies
+    auto num_strategies = lot ? size_t{1} : size_t{2};
+    for (size_t k = 0; k < num_strategies; ++k) {
       for (size_t i = 0; i < strategies[k].attempts;
            i += strategies[k].step_size) {
-        job = d(self).queue.take_head();
+        job = take_head(self);
         if (job)
           return job;
         // try to steal every X poll attempts
@@ -153,10 +277,22 @@ public:
         }
       }
     }
+    auto& relaxed = strategies[2];
+    if (lot) {
+      // park until someone enqueues a job to our queue or wakes us up to
+      // steal, but still try to steal after the relaxed sleep duration
+      auto& queue = d(self).queue;
+      auto has_work = [&queue] { return !queue.empty(); };
+      for (;;) {
+        lot->park(self->id(), relaxed.sleep_duration, has_work);
+        if ((job = take_head(self)) != nullptr
+            || (job = try_steal(self)) != nullptr)
+          return job;
+      }
+    }
     // we assume pretty much nothing is going on so we can relax polling
     // and falling to sleep on a condition variable whose timeout is the one
     // of the relaxed polling strategy
-    auto& relaxed = strategies[2];
     auto& sleeping = d(self).waitdata.sleeping;
     auto& lock = d(self).waitdata.lock;
     auto& cv = d(self).waitdata.cv;
@@ -172,7 +308,7 @@ public:
         sleeping = false;
       }
       if (notimeout) {
-        job = d(self).queue.take_head();
+        job = take_head(self);
       } else {
         notimeout = true;
         if ((i % relaxed.steal_interval) == 0)
@@ -185,7 +321,7 @@ public:
 
   template <class Worker, class UnaryFunction>
   void foreach_resumable(Worker* self, UnaryFunction f) {
-    auto next = [&] { return d(self).queue.take_head(); };
+    auto next = [&] { return take_head(self); };
     for (auto job = next(); job != nullptr; job = next()) {
       f(job);
     }
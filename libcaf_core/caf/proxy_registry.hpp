@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <map>
 #include <mutex>
@@ -13,7 +14,9 @@
 #include "caf/actor_addr.hpp"
 #include "caf/actor_cast.hpp"
 #include "caf/actor_proxy.hpp"
+#include "caf/config.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/shared_spinlock.hpp"
 #include "caf/exit_reason.hpp"
 #include "caf/fwd.hpp"
 #include "caf/node_id.hpp"
@@ -36,6 +39,9 @@ public:
     virtual void set_last_hop(node_id* ptr) = 0;
   };
 
+  /// Number of independently locked partitions for the proxies.
+  static constexpr size_t num_shards = 64;
+
   proxy_registry(actor_system& sys, backend& be);
 
   proxy_registry(const proxy_registry&) = delete;
@@ -68,7 +74,7 @@ public:
   /// or creates a new (default) proxy instance.
   strong_actor_ptr get_or_put(const node_id& nid, actor_id aid);
 
-  /// Returns all known proxies.
+  /// Returns all known proxies for `node`, sorted by their actor ID.
   std::vector<strong_actor_ptr> get_all(const node_id& node) const;
 
   /// Deletes all proxies for `node`.
@@ -100,13 +106,37 @@ public:
   }
 
 private:
-  /// @pre mtx_ is locked
+  using node_map = std::unordered_map<node_id, proxy_map>;
+
+  /// Stores a partition of all proxies. Each shard occupies its own cache line
+  /// to avoid false sharing between lookups for different proxies.
+  struct alignas(CAF_CACHE_LINE_SIZE) shard {
+    mutable detail::shared_spinlock mtx;
+    node_map proxies;
+    /// Serializes the creation of new proxies. Creating a proxy spawns an
+    /// actor, so threads wait on a blocking mutex instead of spinning.
+    std::mutex creation_mtx;
+  };
+
+  static_assert((num_shards & (num_shards - 1)) == 0,
+                "num_shards must be a power of two");
+
+  /// Returns the partition for the proxy identified by `nid` and `aid`.
+  shard& shard_for(const node_id& nid, actor_id aid) noexcept;
+
+  /// Returns the partition for the proxy identified by `nid` and `aid`.
+  const shard& shard_for(const node_id& nid, actor_id aid) const noexcept;
+
   void kill_proxy(strong_actor_ptr&, error);
 
   actor_system& system_;
   backend& backend_;
-  mutable std::mutex mtx_;
-  std::unordered_map<node_id, proxy_map> proxies_;
+
+  /// Partitions the proxies by node and actor ID. Lookups for different
+  /// proxies of the same node usually go to different shards, since actor IDs
+  /// are assigned sequentially. Operations on all proxies of a node (e.g.,
+  /// erasing a node after losing the connection) visit all shards.
+  std::array<shard, num_shards> shards_;
 };
 
 } // namespace caf
@@ -8,6 +8,7 @@
 
 #include "caf/actor_traits.hpp"
 #include "caf/catch_all.hpp"
+#include "caf/co_handler.hpp"
 #include "caf/message_id.hpp"
 #include "caf/none.hpp"
 #include "caf/sec.hpp"
@@ -104,6 +105,20 @@ public:
     then(std::move(f), [self](error& err) { self->call_error_handler(err); });
   }
 
+#ifdef CAF_ENABLE_COROUTINES
+  /// Suspends the calling coroutine until the actor receives the response.
+  /// Evaluates to an `expected` that holds either the result or the error.
+  /// @note Only available in message handlers that return `co_handler`.
+  template <class T = traits, class P = policy_type,
+            class = detail::enable_if_t<T::is_non_blocking && P::is_trivial>>
+  auto operator co_await() const {
+    static_assert(detail::has_add_multiplexed_response_handler_v<ActorType>,
+                  "this actor type does not support multiplexed responses");
+    using awaiter_type = detail::response_awaiter<actor_type, response_type>;
+    return awaiter_type{self_, policy_.id()};
+  }
+#endif
+
   // -- blocking API -----------------------------------------------------------
 
   template <class T = traits, class F = none_t, class OnError = none_t,
@@ -10,6 +10,7 @@
 #  include <exception>
 #endif // CAF_ENABLE_EXCEPTIONS
 
+#include <atomic>
 #include <forward_list>
 #include <map>
 #include <type_traits>
@@ -18,6 +19,8 @@
 #include "caf/actor_traits.hpp"
 #include "caf/detail/behavior_stack.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/response_continuation.hpp"
+#include "caf/detail/response_slot_table.hpp"
 #include "caf/detail/unordered_flat_map.hpp"
 #include "caf/error.hpp"
 #include "caf/extend.hpp"
@@ -179,6 +182,9 @@ public:
   /// Function object for handling exit messages.
   using exit_handler = std::function<void(pointer, exit_msg&)>;
 
+  /// Function object for handling backpressure messages.
+  using backpressure_handler = std::function<void(pointer, backpressure_msg&)>;
+
 #ifdef CAF_ENABLE_EXCEPTIONS
   /// Function object for handling exit messages.
   using exception_handler = std::function<error(pointer, std::exception_ptr&)>;
@@ -194,6 +200,8 @@ public:
 
   static void default_exit_handler(pointer ptr, exit_msg& x);
 
+  static void default_backpressure_handler(pointer ptr, backpressure_msg& x);
+
 #ifdef CAF_ENABLE_EXCEPTIONS
   static error default_exception_handler(local_actor* ptr,
                                          std::exception_ptr& x);
@@ -229,6 +237,10 @@ public:
 
   bool cleanup(error&& fail_state, execution_unit* host) override;
 
+  /// Requests a new timeout for `mid` that the actor discards eagerly when
+  /// receiving the response.
+  void request_response_timeout(timespan d, message_id mid) override;
+
   // -- overridden functions of resumable --------------------------------------
 
   subtype_t subtype() const override;
@@ -344,6 +356,22 @@ public:
       [fun](scheduled_actor*, node_down_msg& x) { fun(x); });
   }
 
+  /// Sets a custom handler for backpressure messages.
+  void set_backpressure_handler(backpressure_handler fun) {
+    if (fun)
+      backpressure_handler_ = std::move(fun);
+    else
+      backpressure_handler_ = default_backpressure_handler;
+  }
+
+  /// Sets a custom handler for backpressure messages.
+  template <class T>
+  auto set_backpressure_handler(T fun)
+    -> decltype(fun(std::declval<backpressure_msg&>())) {
+    set_backpressure_handler(
+      [fun](scheduled_actor*, backpressure_msg& x) { fun(x); });
+  }
+
   /// Sets a custom handler for error messages.
   void set_exit_handler(exit_handler fun) {
     if (fun)
@@ -406,6 +434,10 @@ public:
   /// Adds a callback for a multiplexed response.
   void add_multiplexed_response_handler(message_id response_id, behavior bhvr);
 
+  /// Adds a single-shot continuation for a multiplexed response.
+  void add_multiplexed_response_handler(message_id response_id,
+                                        detail::response_continuation f);
+
   /// Returns the category of `x`.
   message_category categorize(mailbox_element& x);
 
@@ -618,7 +650,8 @@ public:
   /// @private
   bool alive() const noexcept {
     return !bhvr_stack_.empty() || !awaited_responses_.empty()
-           || !multiplexed_responses_.empty() || !stream_managers_.empty()
+           || !multiplexed_responses_.empty()
+           || pending_requests_.continuations() > 0 || !stream_managers_.empty()
            || !pending_stream_managers_.empty();
   }
 
@@ -626,6 +659,30 @@ public:
     return max_batch_delay_;
   }
 
+  /// Returns the smoothed average time the actor needs to process a message.
+  /// The actor only keeps track of this value when running in a scheduler
+  /// with time slicing enabled.
+  timespan message_cost() const noexcept {
+    return message_cost_;
+  }
+
+  /// Returns the maximum number of ordinary messages in the mailbox or 0 if
+  /// the mailbox is unbounded.
+  size_t mailbox_capacity() const noexcept {
+    return mailbox_capacity_;
+  }
+
+  /// Returns how the actor handles messages that exceed its capacity.
+  mailbox_overflow_policy mailbox_overflow() const noexcept {
+    return mailbox_overflow_;
+  }
+
+  /// Returns the number of ordinary messages that currently count towards the
+  /// mailbox capacity. Only bounded mailboxes keep track of this value.
+  size_t mailbox_depth() const noexcept {
+    return mailbox_depth_.load(std::memory_order_relaxed);
+  }
+
   void active_stream_managers(std::vector<stream_manager*>& result);
 
   std::vector<stream_manager*> active_stream_managers();
@@ -650,6 +707,9 @@ protected:
   /// Stores callbacks for multiplexed responses.
   detail::unordered_flat_map<message_id, behavior> multiplexed_responses_;
 
+  /// Stores timeout tokens and continuations for pending requests.
+  detail::response_slot_table pending_requests_;
+
   /// Customization point for setting a default `message` callback.
   default_handler default_handler_;
 
@@ -665,6 +725,9 @@ protected:
   /// Customization point for setting a default `exit_msg` callback.
   exit_handler exit_handler_;
 
+  /// Customization point for setting a default `backpressure_msg` callback.
+  backpressure_handler backpressure_handler_;
+
   /// Stores stream managers for established streams.
   stream_manager_map stream_managers_;
 
@@ -682,6 +745,19 @@ protected:
   /// Pointer to a private thread object associated with a detached actor.
   detail::private_thread* private_thread_;
 
+  /// Smoothed average time the actor needs to process a message.
+  timespan message_cost_;
+
+  /// Maximum number of ordinary messages in the mailbox. Zero if unbounded.
+  size_t mailbox_capacity_;
+
+  /// Selects how the actor handles messages that exceed `mailbox_capacity_`.
+  mailbox_overflow_policy mailbox_overflow_;
+
+  /// Counts ordinary messages in the mailbox when running with a bounded
+  /// mailbox. Producers increment and the actor itself decrements this value.
+  std::atomic<size_t> mailbox_depth_;
+
   /// Caches metric objects for inbound stream traffic.
   inbound_stream_metrics_map inbound_stream_metrics_;
 
@@ -710,6 +786,21 @@ private:
       return body();
     }
   }
+
+  /// Returns whether `x` counts towards the mailbox capacity.
+  static bool counts_towards_capacity(const mailbox_element& x) noexcept {
+    return x.mid.is_normal_message() && !x.mid.is_response();
+  }
+
+  /// Applies the overflow policy to `ptr` after the mailbox reached its
+  /// capacity.
+  /// @returns `true` if the actor still accepts `ptr`, `false` otherwise.
+  bool handle_mailbox_overflow(mailbox_element_ptr& ptr, size_t depth,
+                               execution_unit* eu);
+
+  /// Discards the oldest ordinary messages until the mailbox no longer exceeds
+  /// its capacity.
+  void trim_mailbox();
 };
 
 } // namespace caf
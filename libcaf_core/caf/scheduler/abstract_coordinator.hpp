@@ -16,6 +16,8 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/message.hpp"
+#include "caf/span.hpp"
+#include "caf/timespan.hpp"
 
 namespace caf::scheduler {
 
@@ -42,6 +44,12 @@ public:
   /// Puts `what` into the queue of a randomly chosen worker.
   virtual void enqueue(resumable* what) = 0;
 
+  /// Puts all `jobs` into the queues of the workers. Unlike calling `enqueue`
+  /// for each job, this function allows the scheduler to spread the jobs with
+  /// a single round-robin step and to wake up each receiving worker only once.
+  /// The default implementation calls `enqueue` for each job.
+  virtual void bulk_enqueue(span<resumable* const> jobs);
+
   actor_system& system() {
     return system_;
   }
@@ -52,6 +60,18 @@ public:
     return max_throughput_;
   }
 
+  /// Returns how long an actor may run before returning control to the
+  /// scheduler. A zero duration disables time slicing.
+  timespan time_slice() const noexcept {
+    return time_slice_;
+  }
+
+  /// Returns whether actors derive their throughput from `time_slice()` and
+  /// their average message processing time.
+  bool adaptive_throughput() const noexcept {
+    return adaptive_throughput_;
+  }
+
   size_t num_workers() const {
     return num_workers_;
   }
@@ -82,6 +102,12 @@ protected:
   /// Number of messages each actor is allowed to consume per resume.
   size_t max_throughput_;
 
+  /// Maximum time an actor may run per resume.
+  timespan time_slice_;
+
+  /// Enables a per-actor throughput based on the average message costs.
+  bool adaptive_throughput_;
+
   /// Configured number of workers.
   size_t num_workers_;
 
@@ -11,6 +11,8 @@
 #include <memory>
 #include <thread>
 
+#include "caf/actor_system_config.hpp"
+#include "caf/defaults.hpp"
 #include "caf/detail/set_thread_name.hpp"
 #include "caf/detail/thread_safe_actor_clock.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
@@ -44,6 +46,14 @@ public:
     return new coordinator(sys);
   }
 
+  void init(actor_system_config& cfg) override {
+    namespace cl = defaults::clock;
+    super::init(cfg);
+    if (get_or(cfg, "caf.clock.backend", cl::backend) == "timing-wheel")
+      clock_.use_timing_wheel(
+        get_or(cfg, "caf.clock.tick-interval", cl::tick_interval));
+  }
+
 protected:
   void start() override {
     // Create initial state for all workers.
@@ -130,6 +140,10 @@ protected:
     policy_.central_enqueue(this, ptr);
   }
 
+  void bulk_enqueue(span<resumable* const> jobs) override {
+    policy_.central_bulk_enqueue(this, jobs);
+  }
+
   detail::thread_safe_actor_clock& clock() noexcept override {
     return clock_;
   }
@@ -106,6 +106,37 @@ bool inspect(Inspector& f, node_down_msg& x) {
                             f.field("reason", x.reason));
 }
 
+/// Sent to the sender of a message when the receiver's mailbox exceeds its
+/// capacity and the receiver uses `mailbox_overflow_policy::signal`.
+/// @note Actors can override the default handler by calling
+///       `self->set_backpressure_handler(...)`.
+struct backpressure_msg {
+  /// The source of this message, i.e., the overloaded actor.
+  actor_addr source;
+
+  /// The number of messages in the mailbox of the overloaded actor.
+  uint64_t mailbox_size;
+};
+
+/// @relates backpressure_msg
+inline bool operator==(const backpressure_msg& x,
+                       const backpressure_msg& y) noexcept {
+  return x.source == y.source && x.mailbox_size == y.mailbox_size;
+}
+
+/// @relates backpressure_msg
+inline bool operator!=(const backpressure_msg& x,
+                       const backpressure_msg& y) noexcept {
+  return !(x == y);
+}
+
+/// @relates backpressure_msg
+template <class Inspector>
+bool inspect(Inspector& f, backpressure_msg& x) {
+  return f.object(x).fields(f.field("source", x.source),
+                            f.field("mailbox_size", x.mailbox_size));
+}
+
 /// Signalizes a timeout event.
 /// @note This message is handled implicitly by the runtime system.
 struct timeout_msg {
@@ -21,6 +21,11 @@ namespace caf::telemetry::collector {
 
 /// Collects system metrics and exports them to the text-based Prometheus
 /// format. For a documentation of the format, see: https://git.io/fjgDD.
+///
+/// The collector renders the static parts of the output, i.e., the meta
+/// information for each family and the variable names including all labels
+/// for each instance, only once and caches them across scrapes. Subsequent
+/// scrapes only format the current values.
 class CAF_CORE_EXPORT prometheus {
 public:
   // -- member types -----------------------------------------------------------
@@ -55,6 +60,13 @@ public:
     return {buf_.data(), buf_.size()};
   }
 
+  /// Exchanges the internal buffer with `other`, e.g., for taking over the
+  /// scrape result without copying it. Passing an empty buffer forces the
+  /// collector to start a new scrape on the next call to `collect_from`.
+  void swap_buffer(char_buffer& other) noexcept {
+    buf_.swap(other);
+  }
+
   /// Reverts the collector back to its initial state, clearing all buffers.
   void reset();
 
@@ -143,6 +155,11 @@ private:
   void set_current_family(const metric_family* family,
                           string_view prometheus_type);
 
+  /// Returns the cached variable name of `instance`, including all labels and
+  /// a trailing space.
+  const char_buffer& instance_info(const metric_family* family,
+                                   const metric* instance);
+
   void append_impl(const metric_family* family, string_view prometheus_type,
                    const metric* instance, int64_t value);
 
@@ -162,9 +179,16 @@ private:
   /// Current timestamp.
   timestamp last_scrape_ = timestamp{timespan{0}};
 
+  /// Caches the timestamp of the current scrape, including the leading space
+  /// and the trailing newline.
+  char_buffer timestamp_info_;
+
   /// Caches type information and help text for a metric.
   std::unordered_map<const metric_family*, char_buffer> family_info_;
 
+  /// Caches variable names for counters and gauges.
+  std::unordered_map<const metric*, char_buffer> instance_info_;
+
   /// Caches variable names for each bucket of a histogram as well as for the
   /// implicit sum and count fields.
   std::unordered_map<const metric*, std::vector<char_buffer>> histogram_info_;
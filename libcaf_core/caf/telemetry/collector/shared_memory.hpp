@@ -0,0 +1,136 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/error.hpp"
+#include "caf/fwd.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/gauge.hpp"
+#include "caf/telemetry/histogram.hpp"
+#include "caf/timestamp.hpp"
+
+namespace caf::telemetry::collector {
+
+/// Publishes system metrics into a memory-mapped file, allowing other
+/// processes on the same host to read the metrics at any frequency without
+/// involving the actor system. See `shared_memory_format` for the binary
+/// layout and `shared_memory_reader` for reading the file.
+///
+/// Each call to `collect_from` only writes the current values, unless the
+/// registry contains new metric instances. In this case, the collector
+/// rewrites the entire file.
+/// @note Only supported on POSIX systems.
+class CAF_CORE_EXPORT shared_memory {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  shared_memory() noexcept = default;
+
+  shared_memory(const shared_memory&) = delete;
+
+  shared_memory& operator=(const shared_memory&) = delete;
+
+  ~shared_memory();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns whether this collector has an open file.
+  [[nodiscard]] bool is_open() const noexcept {
+    return fd_ != -1;
+  }
+
+  /// Returns the path to the file.
+  [[nodiscard]] const std::string& path() const noexcept {
+    return path_;
+  }
+
+  // -- file management --------------------------------------------------------
+
+  /// Creates a new file at `path` for publishing metrics. Replaces any
+  /// existing file at `path` instead of reusing it, i.e., readers that still
+  /// map a previous file never observe a truncated file.
+  error open(const std::string& path);
+
+  /// Closes and removes the file.
+  void close();
+
+  // -- collect API ------------------------------------------------------------
+
+  /// Publishes all metrics in `registry`.
+  /// @pre `is_open()`
+  error collect_from(const metric_registry& registry,
+                     timestamp now = make_timestamp());
+
+  // -- call operators for the metric registry ---------------------------------
+
+  void operator()(const metric_family* family, const metric* instance,
+                  const dbl_counter* counter);
+
+  void operator()(const metric_family* family, const metric* instance,
+                  const int_counter* counter);
+
+  void operator()(const metric_family* family, const metric* instance,
+                  const dbl_gauge* gauge);
+
+  void operator()(const metric_family* family, const metric* instance,
+                  const int_gauge* gauge);
+
+  void operator()(const metric_family* family, const metric* instance,
+                  const dbl_histogram* val);
+
+  void operator()(const metric_family* family, const metric* instance,
+                  const int_histogram* val);
+
+private:
+  // -- implementation details -------------------------------------------------
+
+  struct entry {
+    const metric_family* family;
+    const metric* instance;
+    const void* impl;
+    metric_type type;
+    size_t num_buckets;
+  };
+
+  /// Rewrites the entire file, including all values, for the instances in
+  /// `entries_`.
+  error write_layout();
+
+  /// Writes the values of all instances in `layout_`.
+  void write_values();
+
+  /// Grows the file and the mapping to at least `size` bytes.
+  error reserve(size_t size);
+
+  // -- member variables -------------------------------------------------------
+
+  /// Stores the path to the file.
+  std::string path_;
+
+  /// Stores the file descriptor.
+  int fd_ = -1;
+
+  /// Points to the mapped file content.
+  std::byte* data_ = nullptr;
+
+  /// Stores the size of the mapping.
+  size_t mapped_size_ = 0;
+
+  /// Stores the instances of the current scrape.
+  std::vector<entry> entries_;
+
+  /// Stores the instances at the time of the last layout change.
+  std::vector<entry> layout_;
+
+  /// Stores the position of the value block for each entry in `layout_`.
+  std::vector<size_t> value_offsets_;
+};
+
+} // namespace caf::telemetry::collector
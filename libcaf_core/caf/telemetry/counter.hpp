@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <memory>
 #include <type_traits>
 
 #include "caf/config.hpp"
+#include "caf/detail/per_thread_cells.hpp"
 #include "caf/fwd.hpp"
 #include "caf/span.hpp"
 #include "caf/telemetry/gauge.hpp"
@@ -24,6 +26,10 @@ public:
 
   using family_setting = unit_t;
 
+  using cells_type = detail::per_thread_cells<value_type>;
+
+  using cells_ptr = std::shared_ptr<cells_type>;
+
   // -- constants --------------------------------------------------------------
 
   static constexpr metric_type runtime_type
@@ -46,32 +52,70 @@ public:
 
   /// Increments the counter by 1.
   void inc() noexcept {
-    gauge_.inc();
+    if (cells_)
+      cells_->add(cell_index_, 1);
+    else
+      gauge_.inc();
   }
 
   /// Increments the counter by `amount`.
   /// @pre `amount > 0`
   void inc(value_type amount) noexcept {
     CAF_ASSERT(amount > 0);
-    gauge_.inc(amount);
+    if (cells_)
+      cells_->add(cell_index_, amount);
+    else
+      gauge_.inc(amount);
   }
 
   /// Increments the counter by 1.
   /// @returns The new value of the counter.
+  /// @note Sums up all per-thread values when using per-thread storage.
   template <class T = ValueType>
   std::enable_if_t<std::is_same<T, int64_t>::value, T> operator++() noexcept {
+    if (cells_) {
+      cells_->add(cell_index_, 1);
+      return value();
+    }
     return ++gauge_;
   }
 
+  /// Makes this counter accumulate increments per thread instead of using a
+  /// single atomic value. Reading the counter then sums up the values of all
+  /// threads.
+  /// @pre No other thread accesses this counter yet.
+  void enable_per_thread_storage() {
+    use_per_thread_cells(std::make_shared<cells_type>(1), 0);
+  }
+
+  /// Makes this counter accumulate increments in the cell at `index` of
+  /// `cells`. Allows multiple counters to share a single allocation.
+  /// @pre No other thread accesses this counter yet.
+  /// @pre `index < cells->size()`
+  void use_per_thread_cells(cells_ptr cells, size_t index) noexcept {
+    CAF_ASSERT(cells != nullptr && index < cells->size());
+    cells_ = std::move(cells);
+    cell_index_ = index;
+  }
+
   // -- observers --------------------------------------------------------------
 
   /// Returns the current value of the counter.
   value_type value() const noexcept {
+    if (cells_)
+      return gauge_.value() + cells_->sum(cell_index_);
     return gauge_.value();
   }
 
+  /// Returns whether this counter accumulates increments per thread.
+  bool has_per_thread_storage() const noexcept {
+    return cells_ != nullptr;
+  }
+
 private:
   gauge<value_type> gauge_;
+  cells_ptr cells_;
+  size_t cell_index_ = 0;
 };
 
 /// Convenience alias for a counter with value type `double`.
@@ -5,15 +5,21 @@
 #pragma once
 
 #include <algorithm>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <type_traits>
+#include <vector>
 
 #include "caf/config.hpp"
+#include "caf/detail/per_thread_cells.hpp"
 #include "caf/fwd.hpp"
 #include "caf/settings.hpp"
 #include "caf/span.hpp"
 #include "caf/telemetry/counter.hpp"
 #include "caf/telemetry/gauge.hpp"
 #include "caf/telemetry/label.hpp"
+#include "caf/telemetry/log_linear_layout.hpp"
 #include "caf/telemetry/metric_type.hpp"
 
 namespace caf::telemetry {
@@ -55,6 +61,11 @@ public:
     // nop
   }
 
+  explicit histogram(const log_linear_layout<value_type>& layout)
+    : histogram({}, nullptr, layout.upper_bounds()) {
+    // nop
+  }
+
   histogram(const histogram&) = delete;
 
   histogram& operator=(const histogram&) = delete;
@@ -68,16 +79,23 @@ public:
   /// Increments the bucket where the observed value falls into and increments
   /// the sum of all observed values.
   void observe(value_type value) {
-    // The last bucket has an upper bound of +inf or int_max, so we'll always
-    // find a bucket and increment the counters.
-    for (size_t index = 0;; ++index) {
-      auto& [upper_bound, count] = buckets_[index];
-      if (value <= upper_bound) {
-        count.inc();
-        sum_.inc(value);
-        return;
-      }
-    }
+    buckets_[bucket_index(value)].count.inc();
+    if (sums_)
+      sums_->add(0, value);
+    else
+      sum_.inc(value);
+  }
+
+  /// Makes this histogram accumulate observations per thread instead of using
+  /// a single atomic value per bucket. Reading the buckets or the sum then
+  /// sums up the values of all threads. All buckets share one allocation.
+  /// @pre No other thread accesses this histogram yet.
+  void enable_per_thread_storage() {
+    using counts_type = typename int_counter::cells_type;
+    auto counts = std::make_shared<counts_type>(num_buckets_);
+    for (size_t index = 0; index < num_buckets_; ++index)
+      buckets_[index].count.use_per_thread_cells(counts, index);
+    sums_ = std::make_unique<detail::per_thread_cells<value_type>>(1);
   }
 
   // -- observers --------------------------------------------------------------
@@ -89,12 +107,80 @@ public:
 
   /// Returns the sum of all observed values.
   value_type sum() const noexcept {
+    if (sums_)
+      return sum_.value() + sums_->sum(0);
     return sum_.value();
   }
 
+  /// Returns whether this histogram accumulates observations per thread.
+  bool has_per_thread_storage() const noexcept {
+    return sums_ != nullptr;
+  }
+
+  /// Returns the log-linear layout of the buckets if the upper bounds match
+  /// such a layout. In this case, `observe` computes the bucket for a value in
+  /// constant time.
+  const std::optional<log_linear_layout<value_type>>& layout() const noexcept {
+    return layout_;
+  }
+
+  /// Estimates the `q`-quantile of all observed values by interpolating
+  /// linearly within the bucket that contains the quantile, like the function
+  /// `histogram_quantile` in Prometheus. The relative error of the estimate is
+  /// bounded by the relative width of that bucket, i.e., by `2^-precision` for
+  /// histograms with a log-linear layout.
+  /// @returns The estimated quantile or NaN if this histogram has no
+  ///          observations. Returns the largest finite upper bound if the
+  ///          quantile falls into the last bucket.
+  /// @pre `0 <= q && q <= 1`
+  double quantile(double q) const noexcept {
+    CAF_ASSERT(0 <= q && q <= 1);
+    std::vector<int64_t> counts;
+    counts.reserve(num_buckets_);
+    int64_t total = 0;
+    for (size_t index = 0; index < num_buckets_; ++index) {
+      counts.emplace_back(buckets_[index].count.value());
+      total += counts.back();
+    }
+    if (total == 0)
+      return std::numeric_limits<double>::quiet_NaN();
+    auto rank = q * static_cast<double>(total);
+    int64_t cumulative = 0;
+    size_t index = 0;
+    for (; index + 1 < num_buckets_; ++index) {
+      if (static_cast<double>(cumulative + counts[index]) >= rank
+          && counts[index] > 0)
+        break;
+      cumulative += counts[index];
+    }
+    if (index + 1 == num_buckets_) {
+      if (index == 0)
+        return std::numeric_limits<double>::quiet_NaN();
+      return static_cast<double>(buckets_[index - 1].upper_bound);
+    }
+    auto upper = static_cast<double>(buckets_[index].upper_bound);
+    auto lower = index > 0 ? static_cast<double>(buckets_[index - 1].upper_bound)
+                           : std::min(0.0, upper);
+    auto fraction = (rank - static_cast<double>(cumulative))
+                    / static_cast<double>(counts[index]);
+    return lower + (upper - lower) * std::max(0.0, fraction);
+  }
+
 private:
+  size_t bucket_index(value_type value) const noexcept {
+    if (layout_)
+      return layout_->index_of(value);
+    // The last bucket has an upper bound of +inf or int_max, so we'll always
+    // find a bucket.
+    size_t index = 0;
+    while (value > buckets_[index].upper_bound)
+      ++index;
+    return index;
+  }
+
   void init_buckets(span<const value_type> upper_bounds) {
     CAF_ASSERT(std::is_sorted(upper_bounds.begin(), upper_bounds.end()));
+    layout_ = log_linear_layout<value_type>::from_upper_bounds(upper_bounds);
     using limits = std::numeric_limits<value_type>;
     num_buckets_ = upper_bounds.size() + 1;
     buckets_ = new bucket_type[num_buckets_];
@@ -129,6 +215,8 @@ private:
   size_t num_buckets_;
   bucket_type* buckets_;
   gauge_type sum_;
+  std::unique_ptr<detail::per_thread_cells<value_type>> sums_;
+  std::optional<log_linear_layout<value_type>> layout_;
 };
 
 /// Convenience alias for a histogram with value type `double`.
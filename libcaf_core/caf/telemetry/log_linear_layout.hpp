@@ -0,0 +1,262 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "caf/config.hpp"
+#include "caf/span.hpp"
+
+namespace caf::telemetry {
+
+/// Describes a log-linear (HDR-style) bucket layout for histograms. The layout
+/// splits each interval `[2^e, 2^(e+1))` into `2^precision` buckets of equal
+/// width. Hence, the width of a bucket never exceeds `2^-precision` times its
+/// lower bound, which bounds the relative error when estimating values from
+/// bucket counts.
+///
+/// For `double`, the layout covers the values in `(2^min_exponent,
+/// 2^max_exponent]` and the first bucket collects all values up to
+/// `2^min_exponent`. For `int64_t`, the layout starts with buckets of width 1
+/// for all values up to `2^(precision + 1)` and covers values up to
+/// `2^max_exponent`. In both cases, histograms add a final bucket for all
+/// larger values.
+///
+/// Histograms with upper bounds that match a log-linear layout compute the
+/// bucket for an observed value in constant time from the binary exponent and
+/// the leading mantissa bits of the value instead of scanning all buckets.
+template <class ValueType>
+class log_linear_layout {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = ValueType;
+
+  // -- constants --------------------------------------------------------------
+
+  static constexpr bool is_floating_point
+    = std::is_floating_point<value_type>::value;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Creates a layout for `double` values.
+  /// @pre `-1022 <= min_exponent < max_exponent <= 1023`
+  /// @pre `precision <= 20`
+  template <class T = value_type,
+            class = std::enable_if_t<std::is_floating_point<T>::value>>
+  log_linear_layout(int min_exponent, int max_exponent, int precision) noexcept
+    : min_exponent_(min_exponent),
+      max_exponent_(max_exponent),
+      precision_(precision) {
+    CAF_ASSERT(-1022 <= min_exponent && min_exponent < max_exponent
+               && max_exponent <= 1023);
+    CAF_ASSERT(0 <= precision && precision <= 20);
+    min_bound_ = std::ldexp(1.0, min_exponent);
+    max_bound_ = std::ldexp(1.0, max_exponent);
+  }
+
+  /// Creates a layout for `int64_t` values.
+  /// @pre `precision < max_exponent <= 62`
+  template <class T = value_type,
+            class = std::enable_if_t<std::is_integral<T>::value>>
+  log_linear_layout(int max_exponent, int precision) noexcept
+    : min_exponent_(0), max_exponent_(max_exponent), precision_(precision) {
+    CAF_ASSERT(0 <= precision && precision < max_exponent
+               && max_exponent <= 62);
+    min_bound_ = 0;
+    max_bound_ = value_type{1} << max_exponent;
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  int min_exponent() const noexcept {
+    return min_exponent_;
+  }
+
+  int max_exponent() const noexcept {
+    return max_exponent_;
+  }
+
+  int precision() const noexcept {
+    return precision_;
+  }
+
+  /// Returns the number of upper bounds in this layout, i.e., the number of
+  /// buckets excluding the final bucket for all larger values.
+  size_t size() const noexcept {
+    size_t sub_buckets = size_t{1} << precision_;
+    if constexpr (is_floating_point)
+      return 1 + static_cast<size_t>(max_exponent_ - min_exponent_)
+                   * sub_buckets;
+    else
+      return static_cast<size_t>(max_exponent_ - precision_ + 1) * sub_buckets;
+  }
+
+  /// Returns the upper bound of the bucket at `index`.
+  /// @pre `index < size()`
+  value_type upper_bound(size_t index) const noexcept {
+    auto mask = (size_t{1} << precision_) - 1;
+    if constexpr (is_floating_point) {
+      if (index == 0)
+        return min_bound_;
+      --index;
+      auto exponent = min_exponent_ + static_cast<int>(index >> precision_);
+      auto sub_bucket = static_cast<double>((index & mask) + 1);
+      return std::ldexp(1.0 + std::ldexp(sub_bucket, -precision_), exponent);
+    } else {
+      if (index < (size_t{2} << precision_))
+        return static_cast<value_type>(index + 1);
+      auto shift = (index >> precision_) - 1;
+      auto sub_bucket = (size_t{1} << precision_) + (index & mask) + 1;
+      return static_cast<value_type>(sub_bucket << shift);
+    }
+  }
+
+  /// Returns all upper bounds of this layout in ascending order.
+  std::vector<value_type> upper_bounds() const {
+    std::vector<value_type> result;
+    result.reserve(size());
+    for (size_t index = 0; index < size(); ++index)
+      result.emplace_back(upper_bound(index));
+    return result;
+  }
+
+  // -- lookups ----------------------------------------------------------------
+
+  /// Returns the index of the bucket for `value`, i.e., the index of the
+  /// smallest upper bound that is greater than or equal to `value`. Returns
+  /// `size()` for values above the largest upper bound.
+  size_t index_of(value_type value) const noexcept {
+    if constexpr (is_floating_point) {
+      // Note: also catches NaN.
+      if (!(value > min_bound_))
+        return 0;
+      if (value > max_bound_)
+        return size();
+      // Going one step down to the next smaller double maps values on a
+      // bucket boundary to the bucket below, since upper bounds are inclusive.
+      uint64_t bits;
+      double x = value;
+      std::memcpy(&bits, &x, sizeof(bits));
+      --bits;
+      auto exponent = static_cast<int>((bits >> 52) & 0x7FF) - 1023;
+      auto sub_bucket = (bits >> (52 - precision_)) & sub_bucket_mask();
+      return 1
+             + (static_cast<size_t>(exponent - min_exponent_) << precision_)
+             + static_cast<size_t>(sub_bucket);
+    } else {
+      if (value <= 1)
+        return 0;
+      if (value > max_bound_)
+        return size();
+      // Shift by one to map values on a bucket boundary to the bucket below,
+      // since upper bounds are inclusive.
+      auto x = static_cast<uint64_t>(value - 1);
+      if (x < (uint64_t{2} << precision_))
+        return static_cast<size_t>(x);
+      auto shift = exponent_of(x) - precision_;
+      return (static_cast<size_t>(shift) << precision_)
+             + static_cast<size_t>(x >> shift);
+    }
+  }
+
+  // -- factories --------------------------------------------------------------
+
+  /// Returns the layout that generates exactly `bounds` or `std::nullopt` if
+  /// `bounds` does not describe a log-linear layout.
+  static std::optional<log_linear_layout>
+  from_upper_bounds(span<const value_type> bounds) {
+    auto matches = [&bounds](const log_linear_layout& layout) {
+      if (layout.size() != bounds.size())
+        return false;
+      for (size_t index = 0; index < bounds.size(); ++index)
+        if (layout.upper_bound(index) != bounds[index])
+          return false;
+      return true;
+    };
+    if (bounds.size() < 2)
+      return std::nullopt;
+    if constexpr (is_floating_point) {
+      // The first bound is 2^min_exponent and the second bound determines the
+      // width of all buckets in the first interval.
+      int min_exponent = 0;
+      if (!(bounds[0] > 0) || std::frexp(bounds[0], &min_exponent) != 0.5)
+        return std::nullopt;
+      --min_exponent;
+      auto width = (bounds[1] - bounds[0]) / bounds[0];
+      int precision = 0;
+      if (!(width > 0) || std::frexp(width, &precision) != 0.5)
+        return std::nullopt;
+      precision = 1 - precision;
+      if (precision < 0 || precision > 20)
+        return std::nullopt;
+      auto sub_buckets = size_t{1} << precision;
+      if ((bounds.size() - 1) % sub_buckets != 0)
+        return std::nullopt;
+      auto max_exponent = min_exponent
+                          + static_cast<int>((bounds.size() - 1) / sub_buckets);
+      if (min_exponent < -1022 || max_exponent > 1023)
+        return std::nullopt;
+      log_linear_layout result{min_exponent, max_exponent, precision};
+      if (!matches(result))
+        return std::nullopt;
+      return result;
+    } else {
+      // The layout consists of 2^(precision + 1) buckets of width 1, followed
+      // by intervals with 2^precision buckets each.
+      auto linear = size_t{0};
+      while (linear < bounds.size()
+             && bounds[linear] == static_cast<value_type>(linear + 1))
+        ++linear;
+      if (linear < 2 || (linear & (linear - 1)) != 0)
+        return std::nullopt;
+      auto precision = exponent_of(linear) - 1;
+      auto sub_buckets = size_t{1} << precision;
+      if (bounds.size() % sub_buckets != 0)
+        return std::nullopt;
+      auto max_exponent = static_cast<int>(bounds.size() / sub_buckets)
+                          + precision - 1;
+      if (max_exponent > 62)
+        return std::nullopt;
+      log_linear_layout result{max_exponent, precision};
+      if (!matches(result))
+        return std::nullopt;
+      return result;
+    }
+  }
+
+private:
+  uint64_t sub_bucket_mask() const noexcept {
+    return (uint64_t{1} << precision_) - 1;
+  }
+
+  /// Returns the position of the most significant bit in `x`.
+  /// @pre `x > 0`
+  static int exponent_of(uint64_t x) noexcept {
+    // Read the exponent from the binary representation of `x` as `double`.
+    // Rounding may push values just below a power of two up to the next
+    // exponent, which we detect and correct with a single shift.
+    uint64_t bits;
+    double dbl = static_cast<double>(x);
+    std::memcpy(&bits, &dbl, sizeof(bits));
+    auto result = static_cast<int>((bits >> 52) & 0x7FF) - 1023;
+    if ((x >> result) == 0)
+      --result;
+    return result;
+  }
+
+  int min_exponent_;
+  int max_exponent_;
+  int precision_;
+  value_type min_bound_;
+  value_type max_bound_;
+};
+
+} // namespace caf::telemetry
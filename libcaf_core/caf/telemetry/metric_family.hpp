@@ -68,6 +68,19 @@ public:
     return is_sum_;
   }
 
+  /// Returns whether new counter and histogram instances of this family
+  /// accumulate their values per thread.
+  bool per_thread_storage() const noexcept {
+    return per_thread_storage_;
+  }
+
+  /// Configures whether new counter and histogram instances of this family
+  /// accumulate their values per thread. Has no effect on existing instances
+  /// or on gauges.
+  void per_thread_storage(bool value) noexcept {
+    per_thread_storage_ = value;
+  }
+
 private:
   metric_type type_;
   std::string prefix_;
@@ -76,6 +89,7 @@ private:
   std::string helptext_;
   std::string unit_;
   bool is_sum_;
+  bool per_thread_storage_ = false;
 };
 
 } // namespace caf::telemetry
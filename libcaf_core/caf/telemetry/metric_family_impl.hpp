@@ -9,6 +9,8 @@
 #include <memory>
 #include <mutex>
 
+#include "caf/detail/metric_index.hpp"
+#include "caf/detail/type_traits.hpp"
 #include "caf/span.hpp"
 #include "caf/string_view.hpp"
 #include "caf/telemetry/label.hpp"
@@ -53,25 +55,30 @@ public:
     // nop
   }
 
+  /// Returns the instance with the label values `labels`, creating it on
+  /// first access. Looking up an existing instance never blocks.
   Type* get_or_add(span<const label_view> labels) {
-    auto has_label_values = [labels](const auto& metric_ptr) {
-      const auto& metric_labels = metric_ptr->labels();
-      return std::is_permutation(metric_labels.begin(), metric_labels.end(),
-                                 labels.begin(), labels.end());
-    };
+    auto hash = detail::metric_index::hash_of(labels);
+    if (auto ptr = index_.find(hash, labels))
+      return std::addressof(static_cast<impl_type*>(ptr)->impl());
     std::unique_lock<std::mutex> guard{mx_};
-    auto m = std::find_if(metrics_.begin(), metrics_.end(), has_label_values);
-    if (m == metrics_.end()) {
-      std::vector<label> cpy{labels.begin(), labels.end()};
-      std::sort(cpy.begin(), cpy.end());
-      std::unique_ptr<impl_type> ptr;
-      if constexpr (std::is_same<extra_setting_type, unit_t>::value)
-        ptr.reset(new impl_type(std::move(cpy)));
-      else
-        ptr.reset(new impl_type(std::move(cpy), config_, extra_setting_));
-      m = metrics_.emplace(m, std::move(ptr));
-    }
-    return std::addressof(m->get()->impl());
+    // Check again in case another thread added the instance in the meantime.
+    if (auto ptr = index_.find(hash, labels))
+      return std::addressof(static_cast<impl_type*>(ptr)->impl());
+    std::vector<label> cpy{labels.begin(), labels.end()};
+    std::sort(cpy.begin(), cpy.end());
+    std::unique_ptr<impl_type> ptr;
+    if constexpr (std::is_same<extra_setting_type, unit_t>::value)
+      ptr.reset(new impl_type(std::move(cpy)));
+    else
+      ptr.reset(new impl_type(std::move(cpy), config_, extra_setting_));
+    if constexpr (detail::has_enable_per_thread_storage_member<Type>::value)
+      if (per_thread_storage())
+        ptr->impl().enable_per_thread_storage();
+    auto result = ptr.get();
+    metrics_.emplace_back(std::move(ptr));
+    index_.insert(hash, result);
+    return std::addressof(result->impl());
   }
 
   Type* get_or_add(std::initializer_list<label_view> labels) {
@@ -100,6 +107,7 @@ private:
   extra_setting_type extra_setting_;
   mutable std::mutex mx_;
   std::vector<std::unique_ptr<impl_type>> metrics_;
+  detail::metric_index index_;
 };
 
 } // namespace caf::telemetry
@@ -209,6 +209,7 @@ public:
                                              to_sorted_vec(labels),
                                              to_string(helptext),
                                              to_string(unit), is_sum);
+    ptr->per_thread_storage(per_thread_storage(prefix, name));
     auto result = ptr.get();
     families_.emplace_back(std::move(ptr));
     return result;
@@ -243,6 +244,7 @@ public:
                                              to_sorted_vec(labels),
                                              to_string(helptext),
                                              to_string(unit), is_sum);
+    ptr->per_thread_storage(per_thread_storage(prefix, name));
     auto result = ptr.get();
     families_.emplace_back(std::move(ptr));
     return result;
@@ -369,6 +371,9 @@ public:
       sub_settings, to_string(prefix), to_string(name),
       to_sorted_vec(label_names), to_string(helptext), to_string(unit), is_sum,
       std::move(upper_bounds));
+    if (sub_settings != nullptr)
+      ptr->per_thread_storage(
+        get_or(*sub_settings, "per-thread-storage", false));
     auto result = ptr.get();
     families_.emplace_back(std::move(ptr));
     return result;
@@ -481,6 +486,10 @@ private:
   /// @pre `families_mx_` is locked.
   metric_family* fetch(const string_view& prefix, const string_view& name);
 
+  /// Returns whether the configuration enables per-thread storage for the
+  /// family `prefix.name`.
+  bool per_thread_storage(string_view prefix, string_view name) const;
+
   static std::vector<std::string> to_sorted_vec(span_t<string_view> xs);
 
   static std::vector<std::string> to_sorted_vec(span_t<label_view> xs);
@@ -0,0 +1,123 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/// Describes the binary layout of files written by
+/// `telemetry::collector::shared_memory`. All fields use the native byte order
+/// of the writer and all offsets are relative to the beginning of the file.
+///
+/// A file starts with a `header`, followed by `header::num_records` instances
+/// of `record` at `header::records_offset`. Each record describes one metric
+/// instance and points to its label names and values, its histogram bucket
+/// bounds (stored as `double`) and its value block. A value block consists of
+/// a sequence number followed by one 64-bit word per value: a single value for
+/// counters and gauges, or the (non-cumulative) count of each bucket followed
+/// by the sum for histograms. Words store either an `int64_t` or the binary
+/// representation of a `double`, depending on the metric type.
+///
+/// Two sequence locks (seqlocks) guard the content. The writer increments
+/// `header::layout_seq` before and after changing the records or any other
+/// static part of the file and increments the `seq` field of a value block
+/// before and after updating its values. Readers retry when observing an odd
+/// sequence number or when the sequence number changes while reading.
+namespace caf::telemetry::shared_memory_format {
+
+/// Identifies files in this format ("CAFMETRC" in ASCII).
+constexpr uint64_t magic = 0x4352'5445'4d46'4143;
+
+/// Current version of the binary layout.
+constexpr uint32_t version = 1;
+
+/// Refers to a string in the file.
+struct string_ref {
+  uint64_t offset;
+  uint64_t size;
+};
+
+/// Starts each file.
+struct header {
+  /// Always `shared_memory_format::magic`.
+  uint64_t magic;
+
+  /// Version of the binary layout.
+  uint32_t version;
+
+  /// Size of this struct, allowing future versions to add fields.
+  uint32_t header_size;
+
+  /// Guards all static content of the file. Odd while the writer changes the
+  /// layout.
+  std::atomic<uint64_t> layout_seq;
+
+  /// Number of bytes in use by the writer.
+  uint64_t file_size;
+
+  /// Number of metric instances.
+  uint64_t num_records;
+
+  /// Position of the first record.
+  uint64_t records_offset;
+
+  /// Nanoseconds since epoch at the last update of the values.
+  std::atomic<int64_t> last_update;
+
+  /// Reserved for future use.
+  uint64_t reserved;
+};
+
+/// Describes a single metric instance.
+struct record {
+  /// Stores a `telemetry::metric_type`.
+  uint8_t type;
+
+  /// Stores whether the metric family represents a sum.
+  uint8_t is_sum;
+
+  /// Reserved for future use.
+  uint16_t reserved;
+
+  /// Number of labels for this instance.
+  uint32_t num_labels;
+
+  string_ref prefix;
+
+  string_ref name;
+
+  string_ref unit;
+
+  string_ref helptext;
+
+  /// Position of `num_labels` pairs of `string_ref` for label names and
+  /// values.
+  uint64_t labels_offset;
+
+  /// Number of buckets for histograms, 0 otherwise.
+  uint64_t num_buckets;
+
+  /// Position of `num_buckets` upper bounds for histograms.
+  uint64_t bounds_offset;
+
+  /// Position of the value block.
+  uint64_t values_offset;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared memory export requires lock-free 64-bit atomics");
+
+static_assert(std::atomic<int64_t>::is_always_lock_free,
+              "shared memory export requires lock-free 64-bit atomics");
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t));
+
+/// Returns the number of bytes in a value block with `num_values` values. The
+/// first word of each block is the sequence number.
+constexpr uint64_t value_block_size(uint64_t num_values) noexcept {
+  return (num_values + 1) * sizeof(uint64_t);
+}
+
+} // namespace caf::telemetry::shared_memory_format
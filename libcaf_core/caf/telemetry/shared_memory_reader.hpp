@@ -0,0 +1,123 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/error.hpp"
+#include "caf/expected.hpp"
+#include "caf/telemetry/metric_type.hpp"
+#include "caf/timestamp.hpp"
+
+namespace caf::telemetry {
+
+/// Reads metrics from a file that `collector::shared_memory` publishes. Reading
+/// never blocks the writer: the reader copies the content and retries if the
+/// writer modified the content in the meantime.
+/// @note Only supported on POSIX systems.
+class CAF_CORE_EXPORT shared_memory_reader {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// A bucket of a histogram.
+  struct bucket {
+    /// The inclusive upper bound of this bucket. The last bucket has an upper
+    /// bound of positive infinity.
+    double upper_bound;
+
+    /// The number of observations in this bucket (not cumulative).
+    int64_t count;
+  };
+
+  /// A copy of a single metric instance.
+  struct sample {
+    metric_type type;
+    std::string prefix;
+    std::string name;
+    std::string unit;
+    std::string helptext;
+    bool is_sum;
+    std::vector<std::pair<std::string, std::string>> labels;
+
+    /// Stores the value of integer counters and gauges or the sum of integer
+    /// histograms.
+    int64_t int_value = 0;
+
+    /// Stores the value of floating point counters and gauges or the sum of
+    /// floating point histograms.
+    double dbl_value = 0;
+
+    /// Stores the buckets of histograms.
+    std::vector<bucket> buckets;
+  };
+
+  /// A consistent copy of all metrics in the file.
+  struct snapshot {
+    /// Time of the last update by the writer.
+    timestamp last_update;
+
+    /// All metric instances in the order of the writer.
+    std::vector<sample> samples;
+  };
+
+  // -- constants --------------------------------------------------------------
+
+  /// Maximum number of attempts for reading a consistent snapshot.
+  static constexpr size_t max_attempts = 1000;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  shared_memory_reader() noexcept = default;
+
+  shared_memory_reader(const shared_memory_reader&) = delete;
+
+  shared_memory_reader& operator=(const shared_memory_reader&) = delete;
+
+  ~shared_memory_reader();
+
+  // -- file management --------------------------------------------------------
+
+  /// Opens the file at `path`.
+  error open(const std::string& path);
+
+  /// Closes the file.
+  void close();
+
+  /// Returns whether this reader has an open file.
+  [[nodiscard]] bool is_open() const noexcept {
+    return fd_ != -1;
+  }
+
+  // -- reading ----------------------------------------------------------------
+
+  /// Copies all metrics from the file. Re-opens the file if the writer
+  /// replaced it since the last call.
+  expected<snapshot> read();
+
+private:
+  /// Maps at least `size` bytes of the file.
+  error remap(size_t size);
+
+  /// Re-opens the file if the writer replaced it.
+  error refresh();
+
+  /// Tries to copy the content of the file into `result`.
+  /// @returns `true` on success, `false` if the writer changed the content
+  ///          while reading or an error if the content is malformed.
+  expected<bool> try_read(snapshot& result);
+
+  std::string path_;
+  int fd_ = -1;
+  uint64_t inode_ = 0;
+  const std::byte* data_ = nullptr;
+  size_t mapped_size_ = 0;
+};
+
+} // namespace caf::telemetry
@@ -383,6 +383,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(core_module, 0)
 
   CAF_ADD_TYPE_ID(core_module, (caf::actor))
   CAF_ADD_TYPE_ID(core_module, (caf::actor_addr))
+  CAF_ADD_TYPE_ID(core_module, (caf::backpressure_msg))
   CAF_ADD_TYPE_ID(core_module, (caf::byte_buffer))
   CAF_ADD_TYPE_ID(core_module, (caf::config_value))
   CAF_ADD_TYPE_ID(core_module, (caf::dictionary<caf::config_value>) )
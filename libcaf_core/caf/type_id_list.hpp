@@ -154,4 +154,41 @@ constexpr type_id_list to_type_id_list() {
   return to_type_id_list_helper<List>::get();
 }
 
+/// Offset basis of the FNV-1a hash for type ID lists.
+constexpr uint64_t type_id_list_hash_seed = 14695981039346656037ull;
+
+/// Combines `seed` with the type ID `x` (FNV-1a on type IDs).
+constexpr uint64_t type_id_list_hash_step(uint64_t seed, type_id_t x) {
+  return (seed ^ x) * 1099511628211ull;
+}
+
+/// Computes a hash value over the type IDs in `xs`. Returns the same value as
+/// `to_type_id_list_hash` for the corresponding list of types.
+inline uint64_t type_id_list_hash(type_id_list xs) noexcept {
+  auto result = type_id_list_hash_seed;
+  for (auto x : xs)
+    result = type_id_list_hash_step(result, x);
+  return result;
+}
+
+template <class List>
+struct to_type_id_list_hash_helper;
+
+template <class... Ts>
+struct to_type_id_list_hash_helper<type_list<Ts...>> {
+  static constexpr uint64_t get() {
+    [[maybe_unused]] auto result = type_id_list_hash_seed;
+    ((result = type_id_list_hash_step(
+        result, type_id_v<typename strip_param<Ts>::type>)),
+     ...);
+    return result;
+  }
+};
+
+/// Computes the hash of `to_type_id_list<List>()` at compile time.
+template <class List>
+constexpr uint64_t to_type_id_list_hash() {
+  return to_type_id_list_hash_helper<List>::get();
+}
+
 } // namespace caf::detail
@@ -259,6 +259,11 @@ public:
                                                    std::move(bhvr));
   }
 
+  void add_multiplexed_response_handler(message_id response_id,
+                                        detail::response_continuation f) {
+    return self_->add_multiplexed_response_handler(response_id, std::move(f));
+  }
+
   template <class Handle, class... Ts>
   auto delegate(const Handle& dest, Ts&&... xs) {
     return self_->delegate(dest, std::forward<Ts>(xs)...);
@@ -10,6 +10,7 @@
 #include "caf/send.hpp"
 #include "caf/default_attachable.hpp"
 
+#include "caf/detail/batching_execution_unit.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
 
 namespace caf {
@@ -36,13 +37,20 @@ actor_pool::policy actor_pool::round_robin() {
 
 namespace {
 
-void broadcast_dispatch(actor_system&, actor_pool::uplock&,
+void broadcast_dispatch(actor_system& sys, actor_pool::uplock&,
                         const actor_pool::actor_vec& vec,
                         mailbox_element_ptr& ptr, execution_unit* host) {
   CAF_ASSERT(!vec.empty());
   auto msg = ptr->payload;
+  if (host != nullptr) {
+    for (auto& worker : vec)
+      worker->enqueue(ptr->sender, ptr->mid, msg, host);
+    return;
+  }
+  // Collect all workers that become ready and schedule them at once.
+  detail::batching_execution_unit batch{&sys};
   for (auto& worker : vec)
-    worker->enqueue(ptr->sender, ptr->mid, msg, host);
+    worker->enqueue(ptr->sender, ptr->mid, msg, &batch);
 }
 
 } // namespace
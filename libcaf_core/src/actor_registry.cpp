@@ -39,9 +39,10 @@ actor_registry::actor_registry(actor_system& sys) : system_(sys) {
 }
 
 strong_actor_ptr actor_registry::get_impl(actor_id key) const {
-  shared_guard guard(instances_mtx_);
-  auto i = entries_.find(key);
-  if (i != entries_.end())
+  auto& x = shard_for(key);
+  shared_guard guard{x.mtx};
+  auto i = x.instances.find(key);
+  if (i != x.instances.end())
     return i->second;
   CAF_LOG_DEBUG("key invalid, assume actor no longer exists:" << CAF_ARG(key));
   return nullptr;
@@ -52,8 +53,9 @@ void actor_registry::put_impl(actor_id key, strong_actor_ptr val) {
   if (!val)
     return;
   { // lifetime scope of guard
-    exclusive_guard guard(instances_mtx_);
-    if (!entries_.emplace(key, val).second)
+    auto& x = shard_for(key);
+    exclusive_guard guard{x.mtx};
+    if (!x.instances.emplace(key, val).second)
       return;
   }
   // attach functor without lock
@@ -71,11 +73,12 @@ void actor_registry::erase(actor_id key) {
   // that in turn calls this function and we can end up in a deadlock.
   strong_actor_ptr ref;
   { // Lifetime scope of guard.
-    exclusive_guard guard{instances_mtx_};
-    auto i = entries_.find(key);
-    if (i != entries_.end()) {
+    auto& x = shard_for(key);
+    exclusive_guard guard{x.mtx};
+    auto i = x.instances.find(key);
+    if (i != x.instances.end()) {
       ref.swap(i->second);
-      entries_.erase(i);
+      x.instances.erase(i);
     }
   }
 }
@@ -84,6 +87,12 @@ size_t actor_registry::inc_running() {
   return ++*system_.base_metrics().running_actors;
 }
 
+size_t actor_registry::inc_running(size_t n) {
+  auto& gauge = *system_.base_metrics().running_actors;
+  gauge.inc(static_cast<int64_t>(n));
+  return static_cast<size_t>(gauge.value());
+}
+
 size_t actor_registry::running() const {
   return static_cast<size_t>(system_.base_metrics().running_actors->value());
 }
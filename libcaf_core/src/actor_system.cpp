@@ -9,7 +9,9 @@
 #include "caf/actor.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/defaults.hpp"
+#include "caf/detail/memory_pool.hpp"
 #include "caf/detail/meta_object.hpp"
+#include "caf/detail/shared_memory_exporter.hpp"
 #include "caf/event_based_actor.hpp"
 #include "caf/policy/work_sharing.hpp"
 #include "caf/policy/work_stealing.hpp"
@@ -214,9 +216,40 @@ auto make_base_metrics(telemetry::metric_registry& reg) {
                         "Number of currently running actors."),
     reg.gauge_singleton("caf.system", "queued-messages",
                         "Number of messages in all mailboxes.", "1", true),
+    reg.counter_singleton("caf.system", "discarded-timeouts",
+                          "Number of obsolete request timeouts discarded by "
+                          "the clock.",
+                          "1", true),
   };
 }
 
+#ifdef CAF_ENABLE_MEMORY_POOL
+
+auto make_memory_pool_metrics(telemetry::metric_registry& reg) {
+  return actor_system::memory_pool_metrics_t{
+    reg.counter_singleton("caf.memory-pool", "allocations",
+                          "Number of blocks served from thread caches.", "1",
+                          true),
+    reg.counter_singleton("caf.memory-pool", "deallocations",
+                          "Number of blocks that returned to their thread "
+                          "cache.",
+                          "1", true),
+    reg.counter_singleton("caf.memory-pool", "remote-deallocations",
+                          "Number of blocks that returned to their thread "
+                          "cache from another thread.",
+                          "1", true),
+    reg.counter_singleton("caf.memory-pool", "fallback-allocations",
+                          "Number of allocations that bypassed the thread "
+                          "caches.",
+                          "1", true),
+    reg.gauge_singleton("caf.memory-pool", "reserved-memory",
+                        "Memory that the pool requested from the system.",
+                        "bytes"),
+  };
+}
+
+#endif // CAF_ENABLE_MEMORY_POOL
+
 auto make_actor_metric_families(telemetry::metric_registry& reg) {
   // Handling a single message generally should take microseconds. Going up to
   // several milliseconds usually indicates a problem (or blocking operations)
@@ -243,6 +276,14 @@ auto make_actor_metric_families(telemetry::metric_registry& reg) {
       "Time a message waits in the mailbox before processing.", "seconds"),
     reg.gauge_family("caf.actor", "mailbox-size", {"name"},
                      "Number of messages in the mailbox."),
+    reg.gauge_family("caf.actor", "throughput-budget", {"name"},
+                     "Number of messages an actor may consume per run."),
+    reg.gauge_family<double>("caf.actor", "message-cost", {"name"},
+                             "Average time an actor needs per message.",
+                             "seconds"),
+    reg.counter_family("caf.actor", "dropped-messages", {"name"},
+                       "Number of messages dropped due to a full mailbox.",
+                       "1", true),
     {
       reg.counter_family("caf.actor.stream", "processed-elements",
                          {"name", "type"},
@@ -292,6 +333,9 @@ actor_system::actor_system(actor_system_config& cfg)
     metrics_actors_excludes_ = std::move(*lst);
   if (!metrics_actors_includes_.empty())
     actor_metric_families_ = make_actor_metric_families(metrics_);
+#ifdef CAF_ENABLE_MEMORY_POOL
+  memory_pool_metrics_ = make_memory_pool_metrics(metrics_);
+#endif
   // Spin up modules.
   for (auto& f : cfg.module_factories) {
     auto mod_ptr = f(*this);
@@ -351,6 +395,9 @@ actor_system::actor_system(actor_system_config& cfg)
   // adapt the system configuration.
   logger_->init(cfg);
   CAF_SET_LOGGER_SYS(this);
+  // Read the snapshot only after initializing the logger, since reading the
+  // configuration may log warnings for invalid values.
+  config_snapshot_ = detail::config_snapshot{cfg};
   for (auto& mod : modules_)
     if (mod)
       mod->init(cfg);
@@ -369,6 +416,18 @@ actor_system::actor_system(actor_system_config& cfg)
       mod->start();
   groups_.start();
   logger_->start();
+  // Publish metrics to a memory-mapped file if configured.
+  if (auto path = get_as<std::string>(cfg, "caf.metrics-shm.path")) {
+    auto interval = get_or(cfg, "caf.metrics-shm.interval",
+                           defaults::metrics_shm::interval);
+    auto exporter = std::make_unique<detail::shared_memory_exporter>(*this,
+                                                                     interval);
+    if (auto err = exporter->start(*path))
+      std::cerr << "[WARNING] unable to publish metrics to " << *path << ": "
+                << to_string(err) << std::endl;
+    else
+      shm_exporter_ = std::move(exporter);
+  }
 }
 
 actor_system::~actor_system() {
@@ -377,6 +436,7 @@ actor_system::~actor_system() {
     CAF_LOG_DEBUG("shutdown actor system");
     if (await_actors_before_shutdown_)
       await_all_actors_done();
+    shm_exporter_.reset();
     // shutdown internal actors
     auto drop = [&](auto& x) {
       anon_send_exit(x, exit_reason::user_shutdown);
@@ -470,6 +530,10 @@ actor_id actor_system::next_actor_id() {
   return ++ids_;
 }
 
+actor_id actor_system::next_actor_ids(size_t n) {
+  return ids_.fetch_add(n) + 1;
+}
+
 actor_id actor_system::latest_actor_id() const {
   return ids_.load();
 }
@@ -504,6 +568,26 @@ size_t actor_system::detached_actors() const noexcept {
   return private_threads_.running();
 }
 
+void actor_system::update_memory_pool_metrics() {
+#ifdef CAF_ENABLE_MEMORY_POOL
+  // The pool statistics only grow, so we advance each counter by the
+  // difference. Concurrent exporters serialize on the mutex.
+  auto advance = [](telemetry::int_counter* ptr, uint64_t value) {
+    auto delta = static_cast<int64_t>(value) - ptr->value();
+    if (delta > 0)
+      ptr->inc(delta);
+  };
+  std::unique_lock<std::mutex> guard{memory_pool_metrics_mtx_};
+  auto stats = detail::memory_pool::stats();
+  auto& m = memory_pool_metrics_;
+  advance(m.allocations, stats.allocations);
+  advance(m.deallocations, stats.deallocations);
+  advance(m.remote_deallocations, stats.remote_deallocations);
+  advance(m.fallback_allocations, stats.fallback_allocations);
+  m.reserved_memory->value(static_cast<int64_t>(stats.reserved_bytes));
+#endif // CAF_ENABLE_MEMORY_POOL
+}
+
 void actor_system::thread_started() {
   for (auto& hook : cfg_.thread_hooks_)
     hook->thread_started();
@@ -72,9 +72,15 @@ actor_system_config::actor_system_config()
     .add<string>("policy", "'stealing' (default) or 'sharing'")
     .add<size_t>("max-threads", "maximum number of worker threads")
     .add<size_t>("max-throughput", "nr. of messages actors can consume per run")
+    .add<timespan>("time-slice", "max. time actors may run per resume (0: off)")
+    .add<bool>("adaptive-throughput",
+               "adapts the throughput to the message costs of each actor")
     .add<bool>("enable-profiling", "enables profiler output")
     .add<timespan>("profiling-resolution", "data collection rate")
     .add<string>("profiling-output-file", "output file for the profiler");
+  opt_group{custom_options_, "caf.clock"}
+    .add<string>("backend", "'map' (default) or 'timing-wheel'")
+    .add<timespan>("tick-interval", "granularity of the timing wheel");
   opt_group(custom_options_, "caf.work-stealing")
     .add<size_t>("aggressive-poll-attempts", "nr. of aggressive steal attempts")
     .add<size_t>("aggressive-steal-interval",
@@ -87,7 +93,16 @@ actor_system_config::actor_system_config()
     .add<size_t>("relaxed-steal-interval",
                  "frequency of relaxed steal attempts")
     .add<timespan>("relaxed-sleep-duration",
-                   "sleep duration between relaxed steal attempts");
+                   "sleep duration between relaxed steal attempts")
+    .add<string>("idle-strategy", "'park' (default) or 'poll' for idle workers")
+    .add<bool>("pin-workers", "pins each worker thread to a single CPU")
+    .add<bool>("locality-aware-stealing",
+               "steals from workers on nearby CPUs first")
+    .add<string>("sysfs-cpu-path", "location of the CPU topology in the sysfs")
+    .add<bool>("lifo-slot", "runs the most recently woken actor next")
+    .add<size_t>("max-lifo-runs",
+                 "max. consecutive jobs from the LIFO slot before polling "
+                 "the queues");
   opt_group{custom_options_, "caf.logger"} //
     .add<bool>("inline-output", "disable logger thread (for testing only!)");
   opt_group{custom_options_, "caf.logger.file"}
@@ -103,6 +118,9 @@ actor_system_config::actor_system_config()
   opt_group{custom_options_, "caf.metrics-filters.actors"}
     .add<string_list>("includes", "selects actors for run-time metrics")
     .add<string_list>("excludes", "excludes actors from run-time metrics");
+  opt_group{custom_options_, "caf.metrics-shm"}
+    .add<string>("path", "publishes all metrics to a memory-mapped file")
+    .add<timespan>("interval", "time between updates of the file");
 }
 
 settings actor_system_config::dump_content() const {
@@ -122,10 +140,17 @@ settings actor_system_config::dump_content() const {
   put_missing(scheduler_group, "policy", defaults::scheduler::policy);
   put_missing(scheduler_group, "max-throughput",
               defaults::scheduler::max_throughput);
+  put_missing(scheduler_group, "time-slice", defaults::scheduler::time_slice);
+  put_missing(scheduler_group, "adaptive-throughput",
+              defaults::scheduler::adaptive_throughput);
   put_missing(scheduler_group, "enable-profiling", false);
   put_missing(scheduler_group, "profiling-resolution",
               defaults::scheduler::profiling_resolution);
   put_missing(scheduler_group, "profiling-output-file", std::string{});
+  // -- clock parameters
+  auto& clock_group = caf_group["clock"].as_dictionary();
+  put_missing(clock_group, "backend", defaults::clock::backend);
+  put_missing(clock_group, "tick-interval", defaults::clock::tick_interval);
   // -- work-stealing parameters
   auto& work_stealing_group = caf_group["work-stealing"].as_dictionary();
   put_missing(work_stealing_group, "aggressive-poll-attempts",
@@ -142,6 +167,18 @@ settings actor_system_config::dump_content() const {
               defaults::work_stealing::relaxed_steal_interval);
   put_missing(work_stealing_group, "relaxed-sleep-duration",
               defaults::work_stealing::relaxed_sleep_duration);
+  put_missing(work_stealing_group, "idle-strategy",
+              defaults::work_stealing::idle_strategy);
+  put_missing(work_stealing_group, "pin-workers",
+              defaults::work_stealing::pin_workers);
+  put_missing(work_stealing_group, "locality-aware-stealing",
+              defaults::work_stealing::locality_aware_stealing);
+  put_missing(work_stealing_group, "sysfs-cpu-path",
+              defaults::work_stealing::sysfs_cpu_path);
+  put_missing(work_stealing_group, "lifo-slot",
+              defaults::work_stealing::lifo_slot);
+  put_missing(work_stealing_group, "max-lifo-runs",
+              defaults::work_stealing::max_lifo_runs);
   // -- logger parameters
   auto& logger_group = caf_group["logger"].as_dictionary();
   put_missing(logger_group, "inline-output", false);
@@ -0,0 +1,32 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/batching_execution_unit.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+namespace caf::detail {
+
+batching_execution_unit::batching_execution_unit(actor_system* sys)
+  : super(sys) {
+  // nop
+}
+
+batching_execution_unit::~batching_execution_unit() {
+  flush();
+}
+
+void batching_execution_unit::exec_later(resumable* ptr) {
+  jobs_.emplace_back(ptr);
+}
+
+void batching_execution_unit::flush() {
+  if (jobs_.empty())
+    return;
+  system().scheduler().bulk_enqueue(jobs_);
+  jobs_.clear();
+}
+
+} // namespace caf::detail
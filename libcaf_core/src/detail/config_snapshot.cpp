@@ -0,0 +1,43 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/config_snapshot.hpp"
+
+#include <string>
+
+#include "caf/actor_system_config.hpp"
+#include "caf/logger.hpp"
+#include "caf/settings.hpp"
+
+namespace caf::detail {
+
+config_snapshot::config_snapshot(const actor_system_config& cfg) {
+  stream_max_batch_delay = get_or(cfg, "caf.stream.max-batch-delay",
+                                  defaults::stream::max_batch_delay);
+  if (auto str = get_if<std::string>(&cfg, "caf.stream.credit-policy")) {
+    if (*str == "token-based") {
+      stream_credit_policy = credit_policy::token_based;
+    } else if (*str != "size-based") {
+      CAF_LOG_WARNING("unrecognized credit policy:"
+                      << *str << "(falling back to 'size-based')");
+    }
+  }
+  if (auto section = get_if<settings>(&cfg, "caf.stream.size-based-policy")) {
+    auto& x = size_policy;
+    x.bytes_per_batch = get_or(*section, "bytes-per-batch", x.bytes_per_batch);
+    x.buffer_capacity = get_or(*section, "buffer-capacity", x.buffer_capacity);
+    x.sampling_rate = get_or(*section, "sampling-rate", x.sampling_rate);
+    x.calibration_interval = get_or(*section, "calibration-interval",
+                                    x.calibration_interval);
+    x.smoothing_factor = get_or(*section, "smoothing-factor",
+                                x.smoothing_factor);
+  }
+  if (auto section = get_if<settings>(&cfg, "caf.stream.token-based-policy")) {
+    auto& x = token_policy;
+    x.batch_size = get_or(*section, "batch-size", x.batch_size);
+    x.buffer_size = get_or(*section, "buffer-size", x.buffer_size);
+  }
+}
+
+} // namespace caf::detail
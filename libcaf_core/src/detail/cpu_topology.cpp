@@ -0,0 +1,204 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/config.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#ifdef CAF_LINUX
+#  include <dirent.h>
+#  include <pthread.h>
+#  include <sched.h>
+#endif // CAF_LINUX
+
+namespace caf::detail {
+
+namespace {
+
+#ifdef CAF_LINUX
+
+bool read_file(const std::string& path, std::string& result) {
+  std::ifstream in{path};
+  if (!in)
+    return false;
+  result.assign(std::istreambuf_iterator<char>{in},
+                std::istreambuf_iterator<char>{});
+  while (!result.empty() && isspace(result.back()))
+    result.pop_back();
+  return true;
+}
+
+int read_int(const std::string& path, int fallback) {
+  std::string str;
+  if (!read_file(path, str) || str.empty())
+    return fallback;
+  int result = 0;
+  for (auto c : str) {
+    if (!isdigit(c))
+      return fallback;
+    result = result * 10 + (c - '0');
+  }
+  return result;
+}
+
+// Searches for an entry `node<N>` in the directory of a CPU.
+int read_numa_node(const std::string& cpu_path, int fallback) {
+  auto dir = opendir(cpu_path.c_str());
+  if (dir == nullptr)
+    return fallback;
+  auto result = fallback;
+  while (auto entry = readdir(dir)) {
+    string_view name{entry->d_name};
+    if (name.size() > 4 && name.compare(0, 4, "node") == 0
+        && std::all_of(name.begin() + 4, name.end(),
+                       [](char c) { return isdigit(c) != 0; })) {
+      result = std::stoi(std::string{name.begin() + 4, name.end()});
+      break;
+    }
+  }
+  closedir(dir);
+  return result;
+}
+
+// Picks the smallest CPU IDs that share the L2 cache and the highest-level
+// cache with the CPU. Both default to `id` if the sysfs has no information.
+std::pair<int, int> read_cache_groups(const std::string& cpu_path, int id) {
+  auto l2_group = id;
+  auto llc_group = id;
+  auto max_level = 0;
+  for (int index = 0;; ++index) {
+    auto prefix = cpu_path + "/cache/index" + std::to_string(index);
+    auto level = read_int(prefix + "/level", -1);
+    if (level < 0)
+      break;
+    std::string shared;
+    if (level < 2 || !read_file(prefix + "/shared_cpu_list", shared))
+      continue;
+    auto ids = cpu_topology::parse_cpu_list(shared);
+    if (ids.empty())
+      continue;
+    if (level == 2)
+      l2_group = ids.front();
+    if (level >= max_level) {
+      max_level = level;
+      llc_group = ids.front();
+    }
+  }
+  return {l2_group, llc_group};
+}
+
+#endif // CAF_LINUX
+
+} // namespace
+
+cpu_topology::cpu_topology(std::vector<cpu_info> cpus) : cpus_(std::move(cpus)) {
+  auto key = [](const cpu_info& x) {
+    return std::make_tuple(x.numa_node, x.package, x.llc_group, x.l2_group,
+                           x.id);
+  };
+  std::sort(cpus_.begin(), cpus_.end(),
+            [&](const cpu_info& x, const cpu_info& y) {
+              return key(x) < key(y);
+            });
+}
+
+cpu_topology cpu_topology::read(string_view path) {
+#ifdef CAF_LINUX
+  auto root = to_string(path);
+  std::string online;
+  if (!read_file(root + "/online", online))
+    return {};
+  std::vector<cpu_info> cpus;
+  for (auto id : parse_cpu_list(online)) {
+    auto cpu_path = root + "/cpu" + std::to_string(id);
+    auto package = read_int(cpu_path + "/topology/physical_package_id", 0);
+    auto numa_node = read_numa_node(cpu_path, package);
+    auto [l2_group, llc_group] = read_cache_groups(cpu_path, id);
+    cpus.emplace_back(cpu_info{id, numa_node, package, l2_group, llc_group});
+  }
+  return cpu_topology{std::move(cpus)};
+#else
+  CAF_IGNORE_UNUSED(path);
+  return {};
+#endif
+}
+
+cpu_topology::locality cpu_topology::distance(const cpu_info& x,
+                                              const cpu_info& y) noexcept {
+  if (x.l2_group == y.l2_group)
+    return locality::l2;
+  if (x.llc_group == y.llc_group)
+    return locality::llc;
+  if (x.numa_node == y.numa_node)
+    return locality::numa;
+  return locality::remote;
+}
+
+std::vector<int> cpu_topology::parse_cpu_list(string_view str) {
+  std::vector<int> result;
+  auto i = str.begin();
+  auto e = str.end();
+  auto read_num = [&](int& x) {
+    if (i == e || !isdigit(*i))
+      return false;
+    x = 0;
+    while (i != e && isdigit(*i))
+      x = x * 10 + (*i++ - '0');
+    return true;
+  };
+  while (i != e) {
+    int first = 0;
+    if (!read_num(first))
+      return {};
+    auto last = first;
+    if (i != e && *i == '-') {
+      ++i;
+      if (!read_num(last) || last < first)
+        return {};
+    }
+    for (auto id = first; id <= last; ++id)
+      result.emplace_back(id);
+    if (i != e && *i++ != ',')
+      return {};
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+bool cpu_topology::pin_this_thread(int cpu_id) {
+#ifdef CAF_LINUX
+  if (cpu_id < 0 || cpu_id >= CPU_SETSIZE)
+    return false;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu_id, &cpus);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus) == 0;
+#else
+  CAF_IGNORE_UNUSED(cpu_id);
+  return false;
+#endif
+}
+
+std::string to_string(cpu_topology::locality x) {
+  switch (x) {
+    case cpu_topology::locality::l2:
+      return "l2";
+    case cpu_topology::locality::llc:
+      return "llc";
+    case cpu_topology::locality::numa:
+      return "numa";
+    default:
+      return "remote";
+  }
+}
+
+} // namespace caf::detail
@@ -5,6 +5,7 @@
 #include "caf/detail/local_group_module.hpp"
 
 #include "caf/actor_system.hpp"
+#include "caf/detail/batching_execution_unit.hpp"
 #include "caf/event_based_actor.hpp"
 #include "caf/make_counted.hpp"
 #include "caf/send.hpp"
@@ -68,9 +69,19 @@ local_group_module::impl::~impl() {
 
 void local_group_module::impl::enqueue(strong_actor_ptr sender, message_id mid,
                                        message content, execution_unit* host) {
+  if (host != nullptr) {
+    std::unique_lock<std::mutex> guard{mtx_};
+    for (auto subscriber : subscribers_)
+      subscriber->enqueue(sender, mid, content, host);
+    return;
+  }
+  // Collect all subscribers that become ready and schedule them at once.
+  batching_execution_unit batch{&system()};
   std::unique_lock<std::mutex> guard{mtx_};
   for (auto subscriber : subscribers_)
-    subscriber->enqueue(sender, mid, content, host);
+    subscriber->enqueue(sender, mid, content, &batch);
+  guard.unlock();
+  batch.flush();
 }
 
 bool local_group_module::impl::subscribe(strong_actor_ptr who) {
@@ -0,0 +1,232 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/memory_pool.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#include "caf/byte.hpp"
+#include "caf/config.hpp"
+
+namespace caf::detail {
+
+namespace {
+
+struct thread_cache;
+
+// Marks blocks that bypass the pool.
+constexpr uint32_t no_size_class = 0xFFFFFFFF;
+
+// Precedes each block. Never changes while the block exists.
+struct block_header {
+  thread_cache* owner;
+  uint32_t size_class;
+};
+
+static_assert(sizeof(block_header) <= memory_pool::header_size);
+
+// Occupies the payload of free blocks.
+struct free_block {
+  free_block* next;
+};
+
+void* to_payload(block_header* hdr) noexcept {
+  return reinterpret_cast<byte*>(hdr) + memory_pool::header_size;
+}
+
+block_header* to_header(void* ptr) noexcept {
+  return reinterpret_cast<block_header*>(static_cast<byte*>(ptr)
+                                         - memory_pool::header_size);
+}
+
+// Increments a counter that has only one writer.
+void bump(std::atomic<uint64_t>& x, uint64_t n = 1) noexcept {
+  x.store(x.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// Stores the free lists of a single thread. Thread caches are never destroyed,
+// because other threads may still return blocks to a cache after its thread
+// terminated.
+struct thread_cache {
+  // Blocks that the owner may use without synchronization.
+  std::array<free_block*, memory_pool::num_size_classes> local{};
+
+  // Blocks that other threads returned to this cache.
+  std::array<std::atomic<free_block*>, memory_pool::num_size_classes> remote{};
+
+  // Counters for the statistics. Only the owner writes to these counters,
+  // except for `remote_deallocations`.
+  std::atomic<uint64_t> allocations{0};
+  std::atomic<uint64_t> deallocations{0};
+  std::atomic<uint64_t> remote_deallocations{0};
+  std::atomic<uint64_t> reserved_bytes{0};
+
+  // Links all caches together.
+  thread_cache* next_cache = nullptr;
+
+  // Links caches without owner together.
+  thread_cache* next_orphan = nullptr;
+
+  void push_remote(size_t index, void* ptr) noexcept {
+    auto blk = static_cast<free_block*>(ptr);
+    auto& head = remote[index];
+    blk->next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(blk->next, blk,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+      // repeat
+    }
+    remote_deallocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Fills the local free list for `index` from a new slab.
+  bool refill(size_t index) noexcept {
+    auto block_size = memory_pool::min_block_size << index;
+    auto slab = static_cast<byte*>(malloc(memory_pool::slab_size));
+    if (slab == nullptr)
+      return false;
+    bump(reserved_bytes, memory_pool::slab_size);
+    auto num_blocks = memory_pool::slab_size / block_size;
+    for (size_t i = num_blocks; i > 0; --i) {
+      auto hdr = new (slab + (i - 1) * block_size) block_header;
+      hdr->owner = this;
+      hdr->size_class = static_cast<uint32_t>(index);
+      auto blk = static_cast<free_block*>(to_payload(hdr));
+      blk->next = local[index];
+      local[index] = blk;
+    }
+    return true;
+  }
+};
+
+// Keeps track of all caches.
+struct cache_registry {
+  std::mutex mtx;
+  thread_cache* caches = nullptr;
+  thread_cache* orphans = nullptr;
+  std::atomic<uint64_t> fallback_allocations{0};
+
+  thread_cache* acquire() {
+    std::unique_lock<std::mutex> guard{mtx};
+    if (orphans != nullptr) {
+      auto result = orphans;
+      orphans = result->next_orphan;
+      result->next_orphan = nullptr;
+      return result;
+    }
+    auto result = new thread_cache;
+    result->next_cache = caches;
+    caches = result;
+    return result;
+  }
+
+  void release(thread_cache* ptr) {
+    std::unique_lock<std::mutex> guard{mtx};
+    ptr->next_orphan = orphans;
+    orphans = ptr;
+  }
+};
+
+// The registry outlives all threads and is intentionally never destroyed.
+cache_registry& registry() {
+  static auto instance = new cache_registry;
+  return *instance;
+}
+
+// Binds a cache to the current thread and orphans the cache when the thread
+// terminates.
+struct cache_binding {
+  thread_cache* ptr = nullptr;
+  bool destroyed = false;
+
+  ~cache_binding() {
+    if (ptr != nullptr)
+      registry().release(ptr);
+    ptr = nullptr;
+    destroyed = true;
+  }
+};
+
+thread_local cache_binding binding;
+
+// Returns the cache of the current thread or `nullptr` during thread shutdown.
+thread_cache* current_cache() {
+  if (binding.ptr == nullptr && !binding.destroyed)
+    binding.ptr = registry().acquire();
+  return binding.ptr;
+}
+
+void* fallback_allocate(size_t size) noexcept {
+  registry().fallback_allocations.fetch_add(1, std::memory_order_relaxed);
+  auto hdr = static_cast<block_header*>(malloc(size + memory_pool::header_size));
+  if (hdr == nullptr)
+    return nullptr;
+  hdr->owner = nullptr;
+  hdr->size_class = no_size_class;
+  return to_payload(hdr);
+}
+
+} // namespace
+
+void* memory_pool::allocate(size_t size) noexcept {
+  auto index = size_class(size);
+  if (index == num_size_classes)
+    return fallback_allocate(size);
+  auto self = current_cache();
+  if (self == nullptr)
+    return fallback_allocate(size);
+  auto& head = self->local[index];
+  if (head == nullptr) {
+    head = self->remote[index].exchange(nullptr, std::memory_order_acquire);
+    if (head == nullptr && !self->refill(index))
+      return nullptr;
+  }
+  auto result = head;
+  head = result->next;
+  bump(self->allocations);
+  return result;
+}
+
+void memory_pool::deallocate(void* ptr) noexcept {
+  if (ptr == nullptr)
+    return;
+  auto hdr = to_header(ptr);
+  if (hdr->size_class == no_size_class) {
+    free(hdr);
+    return;
+  }
+  auto owner = hdr->owner;
+  auto index = hdr->size_class;
+  if (owner == current_cache()) {
+    auto blk = static_cast<free_block*>(ptr);
+    blk->next = owner->local[index];
+    owner->local[index] = blk;
+    bump(owner->deallocations);
+  } else {
+    owner->push_remote(index, ptr);
+  }
+}
+
+memory_pool::statistics memory_pool::stats() noexcept {
+  statistics result;
+  auto& reg = registry();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  for (auto ptr = reg.caches; ptr != nullptr; ptr = ptr->next_cache) {
+    auto remote = ptr->remote_deallocations.load(std::memory_order_relaxed);
+    result.allocations += ptr->allocations.load(std::memory_order_relaxed);
+    result.deallocations += ptr->deallocations.load(std::memory_order_relaxed)
+                            + remote;
+    result.remote_deallocations += remote;
+    result.reserved_bytes += ptr->reserved_bytes.load(std::memory_order_relaxed);
+  }
+  result.fallback_allocations
+    = reg.fallback_allocations.load(std::memory_order_relaxed);
+  return result;
+}
+
+} // namespace caf::detail
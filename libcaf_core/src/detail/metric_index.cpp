@@ -0,0 +1,122 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/metric_index.hpp"
+
+#include <algorithm>
+
+#include "caf/hash/fnv.hpp"
+#include "caf/telemetry/label.hpp"
+#include "caf/telemetry/label_view.hpp"
+#include "caf/telemetry/metric.hpp"
+
+namespace caf::detail {
+
+namespace {
+
+constexpr size_t initial_capacity = 16;
+
+template <class Label>
+size_t hash_of_impl(span<const Label> labels) noexcept {
+  // Combining the hash values with a commutative operation makes the result
+  // independent of the order of the labels.
+  size_t result = 0;
+  for (const auto& lbl : labels)
+    result += hash::fnv<size_t>::compute(lbl.name(), '=', lbl.value());
+  return result;
+}
+
+bool same_labels(const telemetry::metric* instance,
+                 span<const telemetry::label_view> labels) noexcept {
+  const auto& instance_labels = instance->labels();
+  return instance_labels.size() == labels.size()
+         && std::is_permutation(instance_labels.begin(), instance_labels.end(),
+                                labels.begin());
+}
+
+} // namespace
+
+// -- nested types -------------------------------------------------------------
+
+metric_index::table::table(size_t capacity)
+  : mask(capacity - 1), slots(new slot[capacity]) {
+  // nop
+}
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+metric_index::metric_index() noexcept : table_(nullptr), size_(0) {
+  // nop
+}
+
+metric_index::~metric_index() {
+  // nop
+}
+
+// -- hashing ------------------------------------------------------------------
+
+size_t metric_index::hash_of(span<const telemetry::label_view> labels) noexcept {
+  return hash_of_impl(labels);
+}
+
+size_t metric_index::hash_of(span<const telemetry::label> labels) noexcept {
+  return hash_of_impl(labels);
+}
+
+// -- lookups ------------------------------------------------------------------
+
+telemetry::metric*
+metric_index::find(size_t hash,
+                   span<const telemetry::label_view> labels) const noexcept {
+  auto tbl = table_.load(std::memory_order_acquire);
+  if (tbl == nullptr)
+    return nullptr;
+  // The writer never exceeds a load factor of 1/2, i.e., each probe sequence
+  // ends at an empty slot.
+  for (auto pos = hash & tbl->mask;; pos = (pos + 1) & tbl->mask) {
+    auto& entry = tbl->slots[pos];
+    auto instance = entry.instance.load(std::memory_order_acquire);
+    if (instance == nullptr)
+      return nullptr;
+    if (entry.hash == hash && same_labels(instance, labels))
+      return instance;
+  }
+}
+
+// -- modifiers ----------------------------------------------------------------
+
+void metric_index::insert(size_t hash, telemetry::metric* instance) {
+  CAF_ASSERT(instance != nullptr);
+  auto tbl = table_.load(std::memory_order_relaxed);
+  if (tbl == nullptr || (size_ + 1) * 2 > tbl->mask + 1) {
+    // Fill a new table before publishing it to make sure that readers never
+    // miss an instance.
+    auto capacity = tbl == nullptr ? initial_capacity : (tbl->mask + 1) * 2;
+    auto new_tbl = std::make_unique<table>(capacity);
+    if (tbl != nullptr) {
+      for (size_t pos = 0; pos <= tbl->mask; ++pos) {
+        auto& entry = tbl->slots[pos];
+        if (auto ptr = entry.instance.load(std::memory_order_relaxed))
+          place(*new_tbl, entry.hash, ptr);
+      }
+    }
+    tbl = new_tbl.get();
+    tables_.emplace_back(std::move(new_tbl));
+    table_.store(tbl, std::memory_order_release);
+  }
+  place(*tbl, hash, instance);
+  ++size_;
+}
+
+void metric_index::place(table& tbl, size_t hash,
+                         telemetry::metric* instance) {
+  auto pos = hash & tbl.mask;
+  while (tbl.slots[pos].instance.load(std::memory_order_relaxed) != nullptr)
+    pos = (pos + 1) & tbl.mask;
+  auto& entry = tbl.slots[pos];
+  entry.hash = hash;
+  entry.instance.store(instance, std::memory_order_release);
+}
+
+} // namespace caf::detail
@@ -0,0 +1,86 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/parking_lot.hpp"
+
+#include <chrono>
+
+#ifdef CAF_LINUX
+#  include <ctime>
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif // CAF_LINUX
+
+namespace caf::detail {
+
+parking_lot::parking_lot(size_t num_workers)
+  : num_slots_(num_workers),
+    slots_(new slot[num_workers]),
+    mask_((num_workers + 63) / 64) {
+  for (auto& word : mask_)
+    word.store(0, std::memory_order_relaxed);
+}
+
+parking_lot::~parking_lot() {
+  // nop
+}
+
+bool parking_lot::unpark_any() {
+  for (size_t index = 0; index < mask_.size(); ++index) {
+    auto word = mask_[index].load(std::memory_order_seq_cst);
+    while (word != 0) {
+      // Pick the lowest bit and try to wake up the corresponding worker.
+      size_t bit = 0;
+      while ((word & (uint64_t{1} << bit)) == 0)
+        ++bit;
+      if (unpark(index * 64 + bit))
+        return true;
+      word &= ~(uint64_t{1} << bit);
+    }
+  }
+  return false;
+}
+
+#ifdef CAF_LINUX
+
+void parking_lot::wait(slot& x, timespan timeout) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  // The kernel only blocks if the state still equals `parked`. Repeat on
+  // spurious wakeups (e.g., EINTR) until reaching the deadline.
+  while (x.state.load(std::memory_order_seq_cst) == parked) {
+    auto left = deadline - std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+    if (ns <= 0)
+      return;
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&x.state),
+            FUTEX_WAIT_PRIVATE, parked, &ts, nullptr, 0);
+  }
+}
+
+void parking_lot::wake(slot& x) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&x.state), FUTEX_WAKE_PRIVATE,
+          1, nullptr, nullptr, 0);
+}
+
+#else // CAF_LINUX
+
+void parking_lot::wait(slot& x, timespan timeout) {
+  std::unique_lock<std::mutex> guard{x.mtx};
+  x.cv.wait_for(guard, timeout, [&x] {
+    return x.state.load(std::memory_order_seq_cst) != parked;
+  });
+}
+
+void parking_lot::wake(slot& x) {
+  std::unique_lock<std::mutex> guard{x.mtx};
+  x.cv.notify_one();
+}
+
+#endif // CAF_LINUX
+
+} // namespace caf::detail
@@ -0,0 +1,139 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/response_slot_table.hpp"
+
+#include "caf/config.hpp"
+
+namespace caf::detail {
+
+response_slot_table::~response_slot_table() {
+  clear();
+}
+
+void response_slot_table::set_token(message_id id, timeout_token_ptr token) {
+  find_or_insert(id).token = std::move(token);
+}
+
+void response_slot_table::set_continuation(message_id id,
+                                           response_continuation f) {
+  auto& x = find_or_insert(id);
+  if (!x.continuation)
+    ++continuations_;
+  x.continuation = std::move(f);
+}
+
+void response_slot_table::dispose_token(message_id id) noexcept {
+  if (auto x = find(id); x != nullptr && x->token != nullptr) {
+    x->token->dispose();
+    x->token.reset();
+    if (!x->continuation)
+      erase(*x);
+  }
+}
+
+response_continuation
+response_slot_table::take_continuation(message_id id) noexcept {
+  response_continuation result;
+  if (auto x = find(id)) {
+    if (x->token != nullptr)
+      x->token->dispose();
+    if (x->continuation)
+      --continuations_;
+    result = std::move(x->continuation);
+    erase(*x);
+  }
+  return result;
+}
+
+void response_slot_table::clear() noexcept {
+  for (auto& x : slots_) {
+    if (x.token != nullptr) {
+      x.token->dispose();
+      x.token.reset();
+    }
+    x.continuation.reset();
+    x.id = message_id{};
+  }
+  size_ = 0;
+  continuations_ = 0;
+}
+
+response_slot_table::slot* response_slot_table::find(message_id id) noexcept {
+  if (size_ == 0)
+    return nullptr;
+  auto mask = slots_.size() - 1;
+  for (auto i = index_of(id);; i = (i + 1) & mask) {
+    auto& x = slots_[i];
+    if (x.id == id)
+      return &x;
+    if (x.id == message_id{})
+      return nullptr;
+  }
+}
+
+response_slot_table::slot& response_slot_table::find_or_insert(message_id id) {
+  CAF_ASSERT(id != message_id{});
+  if (auto x = find(id))
+    return *x;
+  // Keep the load factor at or below 50% to keep probe sequences short.
+  if ((size_ + 1) * 2 > slots_.size())
+    grow();
+  auto mask = slots_.size() - 1;
+  auto i = index_of(id);
+  while (slots_[i].id != message_id{})
+    i = (i + 1) & mask;
+  ++size_;
+  slots_[i].id = id;
+  return slots_[i];
+}
+
+void response_slot_table::erase(slot& x) noexcept {
+  CAF_ASSERT(!x.continuation);
+  --size_;
+  // Shift subsequent entries of the probe sequence backwards instead of
+  // leaving a tombstone.
+  auto mask = slots_.size() - 1;
+  auto i = static_cast<size_t>(&x - slots_.data());
+  auto j = i;
+  for (;;) {
+    j = (j + 1) & mask;
+    auto& y = slots_[j];
+    if (y.id == message_id{})
+      break;
+    auto k = index_of(y.id);
+    // Move `y` to `i` unless its home slot `k` lies cyclically in (i, j].
+    if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+      continue;
+    auto& z = slots_[i];
+    z.id = y.id;
+    z.token = std::move(y.token);
+    z.continuation = std::move(y.continuation);
+    i = j;
+  }
+  auto& z = slots_[i];
+  z.id = message_id{};
+  z.token.reset();
+  z.continuation.reset();
+}
+
+void response_slot_table::grow() {
+  auto new_capacity = slots_.empty() ? initial_capacity : slots_.size() * 2;
+  std::vector<slot> tmp(new_capacity);
+  tmp.swap(slots_);
+  auto mask = new_capacity - 1;
+  for (auto& x : tmp) {
+    if (x.id == message_id{})
+      continue;
+    auto i = index_of(x.id);
+    while (slots_[i].id != message_id{})
+      i = (i + 1) & mask;
+    auto& y = slots_[i];
+    y.id = x.id;
+    y.token = std::move(x.token);
+    y.continuation = std::move(x.continuation);
+  }
+}
+
+} // namespace caf::detail
@@ -0,0 +1,55 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/shared_memory_exporter.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/logger.hpp"
+
+namespace caf::detail {
+
+shared_memory_exporter::shared_memory_exporter(actor_system& sys,
+                                               timespan interval)
+  : sys_(sys), interval_(interval) {
+  // nop
+}
+
+shared_memory_exporter::~shared_memory_exporter() {
+  stop();
+}
+
+error shared_memory_exporter::start(const std::string& path) {
+  if (auto err = collector_.open(path))
+    return err;
+  sys_.update_memory_pool_metrics();
+  if (auto err = collector_.collect_from(sys_.metrics()))
+    return err;
+  thread_ = sys_.launch_thread("caf.metrics.shm", [this] { run(); });
+  return none;
+}
+
+void shared_memory_exporter::stop() {
+  if (thread_.joinable()) {
+    {
+      std::unique_lock<std::mutex> guard{mtx_};
+      stopped_ = true;
+      cv_.notify_all();
+    }
+    thread_.join();
+  }
+  collector_.close();
+}
+
+void shared_memory_exporter::run() {
+  std::unique_lock<std::mutex> guard{mtx_};
+  while (!cv_.wait_for(guard, interval_, [this] { return stopped_; })) {
+    sys_.update_memory_pool_metrics();
+    if (auto err = collector_.collect_from(sys_.metrics())) {
+      CAF_LOG_ERROR("failed to publish metrics:" << err);
+      return;
+    }
+  }
+}
+
+} // namespace caf::detail
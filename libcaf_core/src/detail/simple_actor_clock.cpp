@@ -4,12 +4,107 @@
 
 #include "caf/detail/simple_actor_clock.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <new>
+
 #include "caf/actor_cast.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/logger.hpp"
 #include "caf/sec.hpp"
 #include "caf/system_messages.hpp"
+#include "caf/telemetry/counter.hpp"
 
 namespace caf::detail {
 
+namespace {
+
+using sac = simple_actor_clock;
+
+// All event types fit into blocks of this size.
+constexpr size_t event_block_size = std::max({
+  sizeof(sac::ordinary_timeout),
+  sizeof(sac::multi_timeout),
+  sizeof(sac::request_timeout),
+  sizeof(sac::actor_msg),
+  sizeof(sac::group_msg),
+  sizeof(sac::ordinary_timeout_cancellation),
+  sizeof(sac::multi_timeout_cancellation),
+  sizeof(sac::request_timeout_cancellation),
+  sizeof(sac::timeouts_cancellation),
+  sizeof(sac::drop_all),
+  sizeof(sac::shutdown),
+});
+
+struct free_event_block {
+  free_event_block* next;
+};
+
+// Stores the blocks of destroyed events. Any thread may push blocks. Threads
+// that allocate events only ever take the entire stack at once, which rules
+// out the ABA problem of popping single elements from a lock-free stack. The
+// blocks stay in the process until it terminates.
+std::atomic<free_event_block*> free_event_blocks;
+
+// Adds the blocks from `first` to `last` to the shared stack.
+void release_event_blocks(free_event_block* first,
+                          free_event_block* last) noexcept {
+  auto head = free_event_blocks.load(std::memory_order_relaxed);
+  do {
+    last->next = head;
+  } while (!free_event_blocks.compare_exchange_weak(head, first,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed));
+}
+
+// Caches the blocks that the current thread took from the shared stack and
+// returns them to the shared stack when the thread terminates.
+struct event_block_cache {
+  free_event_block* head = nullptr;
+  bool destroyed = false;
+
+  ~event_block_cache() {
+    if (head != nullptr) {
+      auto last = head;
+      while (last->next != nullptr)
+        last = last->next;
+      release_event_blocks(head, last);
+      head = nullptr;
+    }
+    destroyed = true;
+  }
+};
+
+thread_local event_block_cache event_blocks;
+
+} // namespace
+
+void* simple_actor_clock::event::operator new(size_t size) {
+  if (size > event_block_size)
+    return ::operator new(size);
+  // Always allocate full blocks, since `operator delete` recycles them.
+  auto& cache = event_blocks;
+  if (cache.destroyed)
+    return ::operator new(event_block_size);
+  if (cache.head == nullptr)
+    cache.head = free_event_blocks.exchange(nullptr, std::memory_order_acquire);
+  if (auto blk = cache.head) {
+    cache.head = blk->next;
+    return blk;
+  }
+  return ::operator new(event_block_size);
+}
+
+void simple_actor_clock::event::operator delete(void* ptr,
+                                                size_t size) noexcept {
+  if (size <= event_block_size) {
+    auto blk = static_cast<free_event_block*>(ptr);
+    release_event_blocks(blk, blk);
+    return;
+  }
+  ::operator delete(ptr);
+}
+
 simple_actor_clock::event::~event() {
   // nop
 }
@@ -30,6 +125,12 @@ void simple_actor_clock::set_request_timeout(time_point t, abstract_actor* self,
   new_schedule_entry<request_timeout>(t, self->ctrl(), id);
 }
 
+void simple_actor_clock::set_request_timeout(time_point t, abstract_actor* self,
+                                             message_id id,
+                                             timeout_token_ptr token) {
+  new_schedule_entry<request_timeout>(t, self->ctrl(), id, std::move(token));
+}
+
 void simple_actor_clock::cancel_ordinary_timeout(abstract_actor* self,
                                                  std::string type) {
   ordinary_timeout_cancellation tmp{self->id(), std::move(type)};
@@ -88,6 +189,11 @@ void simple_actor_clock::ship(delayed_event& x) {
     case request_timeout_type: {
       auto& dref = static_cast<request_timeout&>(x);
       auto& self = dref.self;
+      if (dref.token != nullptr && dref.token->disposed()) {
+        // The response arrived in time, no need to bother the actor.
+        self->home_system->base_metrics().discarded_timeouts->inc();
+        break;
+      }
       self->get()->eq_impl(dref.id, self, nullptr, sec::request_timeout);
       break;
     }
@@ -164,6 +270,59 @@ size_t simple_actor_clock::trigger_expired_timeouts() {
   return result;
 }
 
+void simple_actor_clock::process(unique_event_ptr x) {
+  CAF_ASSERT(x != nullptr);
+  switch (x->subtype) {
+    case ordinary_timeout_cancellation_type: {
+      handle(static_cast<ordinary_timeout_cancellation&>(*x));
+      break;
+    }
+    case request_timeout_cancellation_type: {
+      handle(static_cast<request_timeout_cancellation&>(*x));
+      break;
+    }
+    case timeouts_cancellation_type: {
+      handle(static_cast<timeouts_cancellation&>(*x));
+      break;
+    }
+    case drop_all_type:
+    case shutdown_type: {
+      schedule_.clear();
+      actor_lookup_.clear();
+      break;
+    }
+    case ordinary_timeout_type: {
+      auto dptr = static_cast<ordinary_timeout*>(x.release());
+      add_schedule_entry(std::unique_ptr<ordinary_timeout>{dptr});
+      break;
+    }
+    case multi_timeout_type: {
+      auto dptr = static_cast<multi_timeout*>(x.release());
+      add_schedule_entry(std::unique_ptr<multi_timeout>{dptr});
+      break;
+    }
+    case request_timeout_type: {
+      auto dptr = static_cast<request_timeout*>(x.release());
+      add_schedule_entry(std::unique_ptr<request_timeout>{dptr});
+      break;
+    }
+    case actor_msg_type: {
+      auto dptr = static_cast<actor_msg*>(x.release());
+      add_schedule_entry(std::unique_ptr<actor_msg>{dptr});
+      break;
+    }
+    case group_msg_type: {
+      auto dptr = static_cast<group_msg*>(x.release());
+      add_schedule_entry(std::unique_ptr<group_msg>{dptr});
+      break;
+    }
+    default: {
+      CAF_LOG_ERROR("unexpected event type");
+      break;
+    }
+  }
+}
+
 void simple_actor_clock::add_schedule_entry(
   time_point t, std::unique_ptr<ordinary_timeout> x) {
   auto aid = x->self->id();
@@ -21,24 +21,11 @@ namespace caf::detail {
 
 size_based_credit_controller::size_based_credit_controller(local_actor* ptr)
   : self_(ptr), inspector_(ptr->system()) {
-  namespace fallback = defaults::stream::size_policy;
-  // Initialize from the config parameters.
-  auto& cfg = ptr->system().config();
-  if (auto section = get_if<settings>(&cfg, "caf.stream.size-based-policy")) {
-    bytes_per_batch_ = get_or(*section, "bytes-per-batch",
-                              fallback::bytes_per_batch);
-    buffer_capacity_ = get_or(*section, "buffer-capacity",
-                              fallback::buffer_capacity);
-    calibration_interval_ = get_or(*section, "calibration-interval",
-                                   fallback::calibration_interval);
-    smoothing_factor_ = get_or(*section, "smoothing-factor",
-                               fallback::smoothing_factor);
-  } else {
-    buffer_capacity_ = fallback::buffer_capacity;
-    bytes_per_batch_ = fallback::bytes_per_batch;
-    calibration_interval_ = fallback::calibration_interval;
-    smoothing_factor_ = fallback::smoothing_factor;
-  }
+  const auto& policy = ptr->home_system().config_snapshot().size_policy;
+  bytes_per_batch_ = policy.bytes_per_batch;
+  buffer_capacity_ = policy.buffer_capacity;
+  calibration_interval_ = policy.calibration_interval;
+  smoothing_factor_ = policy.smoothing_factor;
 }
 
 size_based_credit_controller::~size_based_credit_controller() {
@@ -72,9 +59,8 @@ credit_controller::calibration size_based_credit_controller::calibrate() {
   } else {
     // After our first run, we continue with the actual sampling rate.
     initializing_ = false;
-    sampling_rate_ = get_or(self_->config(),
-                            "caf.stream.size-based-policy.sampling-rate",
-                            defaults::stream::size_policy::sampling_rate);
+    const auto& snapshot = self_->home_system().config_snapshot();
+    sampling_rate_ = snapshot.size_policy.sampling_rate;
     bytes_per_element_ = clamp_i32(sampled_total_size_ / sampled_elements_);
   }
   sampled_elements_ = 0;
@@ -4,6 +4,8 @@
 
 #include "caf/detail/thread_safe_actor_clock.hpp"
 
+#include <algorithm>
+
 #include "caf/actor_control_block.hpp"
 #include "caf/logger.hpp"
 #include "caf/sec.hpp"
@@ -11,141 +13,237 @@
 
 namespace caf::detail {
 
+namespace {
+
+actor_id key_of(const strong_actor_ptr& ptr) noexcept {
+  return ptr != nullptr ? ptr->id() : actor_id{0};
+}
+
+// Deletes all events in the intrusive list starting at `ptr`.
+void delete_all(simple_actor_clock::event* ptr) noexcept {
+  while (ptr != nullptr) {
+    auto next = ptr->next_submission;
+    delete ptr;
+    ptr = next;
+  }
+}
+
+// Reverses the intrusive list starting at `ptr`. Buffers are LIFO stacks, so
+// reversing a list restores the order of submission.
+simple_actor_clock::event* reverse(simple_actor_clock::event* ptr) noexcept {
+  simple_actor_clock::event* head = nullptr;
+  while (ptr != nullptr) {
+    auto next = ptr->next_submission;
+    ptr->next_submission = head;
+    head = ptr;
+    ptr = next;
+  }
+  return head;
+}
+
+} // namespace
+
+thread_safe_actor_clock::thread_safe_actor_clock()
+  : epoch_(0), sleeping_(false) {
+  // nop
+}
+
+thread_safe_actor_clock::~thread_safe_actor_clock() {
+  for (auto& buf : buffers_)
+    delete_all(buf.head.load());
+  delete_all(control_.head.load());
+  for (auto ptr : batch_)
+    delete ptr;
+}
+
 void thread_safe_actor_clock::set_ordinary_timeout(time_point t,
                                                    abstract_actor* self,
                                                    std::string type,
                                                    uint64_t id) {
-  push(new ordinary_timeout(t, self->ctrl(), type, id));
+  push(new ordinary_timeout(t, self->ctrl(), std::move(type), id), self->id());
 }
 
 void thread_safe_actor_clock::set_request_timeout(time_point t,
                                                   abstract_actor* self,
                                                   message_id id) {
-  push(new request_timeout(t, self->ctrl(), id));
+  push(new request_timeout(t, self->ctrl(), id), self->id());
+}
+
+void thread_safe_actor_clock::set_request_timeout(time_point t,
+                                                  abstract_actor* self,
+                                                  message_id id,
+                                                  timeout_token_ptr token) {
+  push(new request_timeout(t, self->ctrl(), id, std::move(token)), self->id());
 }
 
 void thread_safe_actor_clock::set_multi_timeout(time_point t,
                                                 abstract_actor* self,
                                                 std::string type, uint64_t id) {
-  push(new multi_timeout(t, self->ctrl(), type, id));
+  push(new multi_timeout(t, self->ctrl(), std::move(type), id), self->id());
 }
 
 void thread_safe_actor_clock::cancel_ordinary_timeout(abstract_actor* self,
                                                       std::string type) {
-  push(new ordinary_timeout_cancellation(self->id(), type));
+  push(new ordinary_timeout_cancellation(self->id(), std::move(type)),
+       self->id());
 }
 
 void thread_safe_actor_clock::cancel_request_timeout(abstract_actor* self,
                                                      message_id id) {
-  push(new request_timeout_cancellation(self->id(), id));
+  push(new request_timeout_cancellation(self->id(), id), self->id());
 }
 
 void thread_safe_actor_clock::cancel_timeouts(abstract_actor* self) {
-  push(new timeouts_cancellation(self->id()));
+  push(new timeouts_cancellation(self->id()), self->id());
 }
 
 void thread_safe_actor_clock::schedule_message(time_point t,
                                                strong_actor_ptr receiver,
                                                mailbox_element_ptr content) {
-  push(new actor_msg(t, std::move(receiver), std::move(content)));
+  auto key = key_of(receiver);
+  push(new actor_msg(t, std::move(receiver), std::move(content)), key);
 }
 
 void thread_safe_actor_clock::schedule_message(time_point t, group target,
                                                strong_actor_ptr sender,
                                                message content) {
+  auto key = key_of(sender);
   auto ptr = new group_msg(t, std::move(target), std::move(sender),
                            std::move(content));
-  push(ptr);
+  push(ptr, key);
 }
 
 void thread_safe_actor_clock::cancel_all() {
-  push(new drop_all);
+  push_control(new drop_all);
+}
+
+void thread_safe_actor_clock::use_timing_wheel(duration_type tick_interval) {
+  wheel_ = std::make_unique<timing_wheel_actor_clock>(tick_interval);
 }
 
 void thread_safe_actor_clock::run_dispatch_loop() {
+  if (wheel_)
+    run_dispatch_loop(*wheel_);
+  else
+    run_dispatch_loop(*this);
+}
+
+template <class Backend>
+void thread_safe_actor_clock::run_dispatch_loop(Backend& backend) {
+  // Epoch of the last control event that we have applied. A previous run of
+  // the dispatch loop may have applied control events already.
+  auto applied_epoch = epoch_.load(std::memory_order_acquire);
   for (;;) {
-    // Wait until queue is non-empty.
-    if (schedule_.empty()) {
-      queue_.wait_nonempty();
-    } else {
-      auto t = schedule_.begin()->second->due;
-      if (!queue_.wait_nonempty(t)) {
-        // Handle timeout by shipping timed-out events and starting anew.
-        trigger_expired_timeouts();
-        continue;
-      }
+    // Wait until producers submit new events.
+    if (!wait_for_submissions(backend)) {
+      // Handle timeout by shipping timed-out events and starting anew.
+      backend.trigger_expired_timeouts();
+      continue;
+    }
+    // Fetch control events before draining the buffers: any event that a
+    // thread submitted before a control event is then part of this batch.
+    auto ctrl = reverse(control_.head.exchange(nullptr,
+                                               std::memory_order_acquire));
+    // Drain all buffers, keeping the events from the last round that are
+    // waiting for their control event.
+    for (auto& buf : buffers_) {
+      auto ptr = reverse(buf.head.exchange(nullptr, std::memory_order_acquire));
+      for (; ptr != nullptr; ptr = ptr->next_submission)
+        batch_.push_back(ptr);
     }
-    // Push all elements from the queue to the events buffer.
-    auto i = events_.begin();
-    auto e = queue_.get_all(i);
-    for (; i != e; ++i) {
-      auto& x = *i;
-      CAF_ASSERT(x != nullptr);
-      switch (x->subtype) {
-        case ordinary_timeout_cancellation_type: {
-          handle(static_cast<ordinary_timeout_cancellation&>(*x));
-          break;
-        }
-        case request_timeout_cancellation_type: {
-          handle(static_cast<request_timeout_cancellation&>(*x));
-          break;
-        }
-        case timeouts_cancellation_type: {
-          handle(static_cast<timeouts_cancellation&>(*x));
-          break;
-        }
-        case drop_all_type: {
-          schedule_.clear();
-          actor_lookup_.clear();
-          break;
-        }
-        case shutdown_type: {
-          schedule_.clear();
-          actor_lookup_.clear();
-          // Call it a day.
-          return;
-        }
-        case ordinary_timeout_type: {
-          auto dptr = static_cast<ordinary_timeout*>(x.release());
-          add_schedule_entry(std::unique_ptr<ordinary_timeout>{dptr});
-          break;
-        }
-        case multi_timeout_type: {
-          auto dptr = static_cast<multi_timeout*>(x.release());
-          add_schedule_entry(std::unique_ptr<multi_timeout>{dptr});
-          break;
-        }
-        case request_timeout_type: {
-          auto dptr = static_cast<request_timeout*>(x.release());
-          add_schedule_entry(std::unique_ptr<request_timeout>{dptr});
-          break;
-        }
-        case actor_msg_type: {
-          auto dptr = static_cast<actor_msg*>(x.release());
-          add_schedule_entry(std::unique_ptr<actor_msg>{dptr});
-          break;
-        }
-        case group_msg_type: {
-          auto dptr = static_cast<group_msg*>(x.release());
-          add_schedule_entry(std::unique_ptr<group_msg>{dptr});
-          break;
-        }
-        default: {
-          CAF_LOG_ERROR("unexpected event type");
-          break;
-        }
+    // Events from different buffers only need sorting after a control event.
+    auto by_epoch = [](const event* x, const event* y) {
+      return x->submission_epoch < y->submission_epoch;
+    };
+    if (!std::is_sorted(batch_.begin(), batch_.end(), by_epoch))
+      std::stable_sort(batch_.begin(), batch_.end(), by_epoch);
+    auto first = batch_.begin();
+    auto process_until = [&](uint64_t epoch) {
+      for (; first != batch_.end() && (*first)->submission_epoch < epoch;
+           ++first) {
+        (*first)->next_submission = nullptr;
+        backend.process(unique_event_ptr{*first});
       }
-      x.reset();
+    };
+    // Apply each control event after all events that precede it.
+    while (ctrl != nullptr) {
+      auto next = ctrl->next_submission;
+      ctrl->next_submission = nullptr;
+      process_until(ctrl->submission_epoch);
+      applied_epoch = ctrl->submission_epoch;
+      if (ctrl->subtype == shutdown_type) {
+        // Call it a day.
+        backend.process(unique_event_ptr{ctrl});
+        delete_all(next);
+        std::for_each(first, batch_.end(), [](event* ptr) { delete ptr; });
+        batch_.clear();
+        return;
+      }
+      backend.process(unique_event_ptr{ctrl});
+      ctrl = next;
     }
+    // Events with a larger epoch belong after a control event that became
+    // visible only after fetching `ctrl`. They wait for the next round.
+    process_until(applied_epoch + 1);
+    batch_.erase(batch_.begin(), first);
   }
 }
 
 void thread_safe_actor_clock::cancel_dispatch_loop() {
-  push(new shutdown);
+  push_control(new shutdown);
+}
+
+void thread_safe_actor_clock::push(event* ptr, actor_id key) {
+  ptr->submission_epoch = epoch_.load(std::memory_order_acquire);
+  push(buffers_[key % num_buffers], ptr);
+}
+
+void thread_safe_actor_clock::push_control(event* ptr) {
+  std::unique_lock<std::mutex> guard{control_mtx_};
+  ptr->submission_epoch = epoch_.load(std::memory_order_relaxed) + 1;
+  push(control_, ptr);
+  // Publish the new epoch only after submitting the control event. Hence, the
+  // dispatch loop always finds the control event for an epoch.
+  epoch_.store(ptr->submission_epoch, std::memory_order_release);
+}
+
+void thread_safe_actor_clock::push(submission_buffer& buf, event* ptr) {
+  auto& head = buf.head;
+  auto next = head.load(std::memory_order_relaxed);
+  do {
+    ptr->next_submission = next;
+  } while (!head.compare_exchange_weak(next, ptr));
+  // Only the first producer after the dispatch loop went to sleep needs to
+  // wake it up. The loop drains all buffers after waking up.
+  if (sleeping_.load() && sleeping_.exchange(false)) {
+    std::unique_lock<std::mutex> guard{mtx_};
+    cv_.notify_one();
+  }
+}
+
+bool thread_safe_actor_clock::has_submissions() const noexcept {
+  for (auto& buf : buffers_)
+    if (buf.head.load() != nullptr)
+      return true;
+  return control_.head.load() != nullptr;
 }
 
-void thread_safe_actor_clock::push(event* ptr) {
-  queue_.push_back(unique_event_ptr{ptr});
+template <class Backend>
+bool thread_safe_actor_clock::wait_for_submissions(Backend& backend) {
+  if (has_submissions())
+    return true;
+  std::unique_lock<std::mutex> guard{mtx_};
+  // Producers check the flag after submitting an event. Hence, checking the
+  // buffers after setting the flag either finds their event or they wake us.
+  sleeping_ = true;
+  auto pred = [this] { return has_submissions(); };
+  auto result = true;
+  if (backend.empty())
+    cv_.wait(guard, pred);
+  else
+    result = cv_.wait_until(guard, backend.next_timeout(), pred);
+  sleeping_ = false;
+  return result;
 }
 
 } // namespace caf::detail
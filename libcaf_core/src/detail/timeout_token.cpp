@@ -0,0 +1,13 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/timeout_token.hpp"
+
+namespace caf::detail {
+
+timeout_token::~timeout_token() {
+  // nop
+}
+
+} // namespace caf::detail
@@ -0,0 +1,436 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/timing_wheel_actor_clock.hpp"
+
+#include "caf/config.hpp"
+
+#ifdef CAF_MSVC
+#  include <intrin.h>
+#endif
+
+#include "caf/abstract_actor.hpp"
+#include "caf/logger.hpp"
+
+namespace caf::detail {
+
+namespace {
+
+constexpr size_t words_per_level = timing_wheel_actor_clock::num_slots / 64;
+
+size_t count_trailing_zeros(uint64_t x) noexcept {
+  CAF_ASSERT(x != 0);
+#ifdef CAF_MSVC
+  unsigned long result;
+  _BitScanForward64(&result, x);
+  return static_cast<size_t>(result);
+#else
+  return static_cast<size_t>(__builtin_ctzll(x));
+#endif
+}
+
+} // namespace
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+timing_wheel_actor_clock::timing_wheel_actor_clock(duration_type tick_interval)
+  : tick_interval_(tick_interval), current_tick_(0), size_(0) {
+  if (tick_interval_.count() <= 0)
+    tick_interval_ = duration_type{1};
+  bitmap_.fill(0);
+}
+
+timing_wheel_actor_clock::~timing_wheel_actor_clock() {
+  cancel_all();
+}
+
+// -- properties ---------------------------------------------------------------
+
+timing_wheel_actor_clock::time_point
+timing_wheel_actor_clock::next_timeout() const noexcept {
+  CAF_ASSERT(size_ > 0);
+  auto tick = current_tick_;
+  if (slots_[expired_slot].head == nullptr) {
+    size_t level;
+    tick = next_tick(level);
+  }
+  return time_point{duration_type{static_cast<duration_type::rep>(tick)
+                                  * tick_interval_.count()}};
+}
+
+// -- convenience functions ----------------------------------------------------
+
+size_t timing_wheel_actor_clock::trigger_expired_timeouts() {
+  size_t result = 0;
+  auto target = floor_tick(now());
+  for (;;) {
+    while (auto x = slots_[expired_slot].head) {
+      fire(x);
+      ++result;
+    }
+    if (size_ == 0)
+      break;
+    size_t level;
+    auto tick = next_tick(level);
+    if (tick > target)
+      break;
+    // Re-inserting all events of the slot either moves them to a lower level
+    // or to the list of expired events.
+    current_tick_ = tick;
+    auto index = static_cast<uint32_t>(overflow_slot);
+    if (level < num_levels) {
+      auto pos = (tick >> (level * slot_bits)) & (num_slots - 1);
+      index = static_cast<uint32_t>(level * num_slots + pos);
+    }
+    auto x = take_slot(index);
+    while (x != nullptr) {
+      auto next = x->next;
+      insert(x);
+      x = next;
+    }
+  }
+  // No slot needs processing until `target`, so we can skip ahead.
+  if (target > current_tick_)
+    current_tick_ = target;
+  return result;
+}
+
+void timing_wheel_actor_clock::process(unique_event_ptr x) {
+  CAF_ASSERT(x != nullptr);
+  using sac = simple_actor_clock;
+  switch (x->subtype) {
+    case sac::ordinary_timeout_cancellation_type: {
+      auto& dref = static_cast<sac::ordinary_timeout_cancellation&>(*x);
+      cancel_ordinary_timeout(dref.aid, dref.type);
+      break;
+    }
+    case sac::request_timeout_cancellation_type: {
+      auto& dref = static_cast<sac::request_timeout_cancellation&>(*x);
+      cancel_request_timeout(dref.aid, dref.id);
+      break;
+    }
+    case sac::timeouts_cancellation_type: {
+      cancel_timeouts(static_cast<sac::timeouts_cancellation&>(*x).aid);
+      break;
+    }
+    case sac::drop_all_type:
+    case sac::shutdown_type: {
+      cancel_all();
+      break;
+    }
+    case sac::ordinary_timeout_type: {
+      auto& dref = static_cast<ordinary_timeout&>(*x);
+      cancel_ordinary_timeout(dref.self->id(), dref.type);
+      add(static_cast<delayed_event*>(x.release()));
+      break;
+    }
+    case sac::multi_timeout_type:
+    case sac::request_timeout_type:
+    case sac::actor_msg_type:
+    case sac::group_msg_type: {
+      add(static_cast<delayed_event*>(x.release()));
+      break;
+    }
+    default: {
+      CAF_LOG_ERROR("unexpected event type");
+      break;
+    }
+  }
+}
+
+// -- overridden member functions ----------------------------------------------
+
+void timing_wheel_actor_clock::set_ordinary_timeout(time_point t,
+                                                    abstract_actor* self,
+                                                    std::string type,
+                                                    uint64_t id) {
+  cancel_ordinary_timeout(self->id(), type);
+  add(new ordinary_timeout(t, self->ctrl(), std::move(type), id));
+}
+
+void timing_wheel_actor_clock::set_multi_timeout(time_point t,
+                                                 abstract_actor* self,
+                                                 std::string type,
+                                                 uint64_t id) {
+  add(new multi_timeout(t, self->ctrl(), std::move(type), id));
+}
+
+void timing_wheel_actor_clock::set_request_timeout(time_point t,
+                                                   abstract_actor* self,
+                                                   message_id id) {
+  add(new request_timeout(t, self->ctrl(), id));
+}
+
+void timing_wheel_actor_clock::set_request_timeout(time_point t,
+                                                   abstract_actor* self,
+                                                   message_id id,
+                                                   timeout_token_ptr token) {
+  add(new request_timeout(t, self->ctrl(), id, std::move(token)));
+}
+
+void timing_wheel_actor_clock::cancel_ordinary_timeout(abstract_actor* self,
+                                                       std::string type) {
+  cancel_ordinary_timeout(self->id(), type);
+}
+
+void timing_wheel_actor_clock::cancel_request_timeout(abstract_actor* self,
+                                                      message_id id) {
+  cancel_request_timeout(self->id(), id);
+}
+
+void timing_wheel_actor_clock::cancel_timeouts(abstract_actor* self) {
+  cancel_timeouts(self->id());
+}
+
+void timing_wheel_actor_clock::schedule_message(time_point t,
+                                                strong_actor_ptr receiver,
+                                                mailbox_element_ptr content) {
+  add(new actor_msg(t, std::move(receiver), std::move(content)));
+}
+
+void timing_wheel_actor_clock::schedule_message(time_point t, group target,
+                                                strong_actor_ptr sender,
+                                                message content) {
+  add(new group_msg(t, std::move(target), std::move(sender),
+                    std::move(content)));
+}
+
+void timing_wheel_actor_clock::cancel_all() {
+  for (auto& slot : slots_) {
+    auto x = slot.head;
+    while (x != nullptr) {
+      auto next = x->next;
+      delete x;
+      x = next;
+    }
+    slot = slot_list{};
+  }
+  bitmap_.fill(0);
+  actor_lookup_.clear();
+  request_lookup_.clear();
+  size_ = 0;
+}
+
+// -- time conversion ----------------------------------------------------------
+
+uint64_t timing_wheel_actor_clock::ceil_tick(time_point t) const noexcept {
+  auto ticks = t.time_since_epoch().count();
+  auto interval = tick_interval_.count();
+  if (ticks <= 0)
+    return 0;
+  return static_cast<uint64_t>(ticks / interval + (ticks % interval != 0));
+}
+
+uint64_t timing_wheel_actor_clock::floor_tick(time_point t) const noexcept {
+  auto ticks = t.time_since_epoch().count();
+  if (ticks <= 0)
+    return 0;
+  return static_cast<uint64_t>(ticks / tick_interval_.count());
+}
+
+// -- slot management ----------------------------------------------------------
+
+uint64_t timing_wheel_actor_clock::next_tick(size_t& level) const noexcept {
+  // All events on a level share the higher digits with the current tick, so
+  // the first non-empty slot after the current digit on the lowest level
+  // determines the next tick that needs processing.
+  for (size_t lvl = 0; lvl < num_levels; ++lvl) {
+    auto shift = lvl * slot_bits;
+    auto pos = (current_tick_ >> shift) & (num_slots - 1);
+    auto index = find_next(lvl, pos);
+    if (index < num_slots) {
+      level = lvl;
+      auto high = (current_tick_ >> (shift + slot_bits)) << (shift + slot_bits);
+      return high | (uint64_t{index} << shift);
+    }
+  }
+  // Check the overflow list whenever the highest level wraps around.
+  level = num_levels;
+  auto shift = num_levels * slot_bits;
+  return ((current_tick_ >> shift) + 1) << shift;
+}
+
+size_t timing_wheel_actor_clock::find_next(size_t level,
+                                           size_t pos) const noexcept {
+  auto first = pos + 1;
+  for (auto word = first / 64; word < words_per_level; ++word) {
+    auto bits = bitmap_[level * words_per_level + word];
+    if (word == first / 64)
+      bits &= ~uint64_t{0} << (first % 64);
+    if (bits != 0)
+      return word * 64 + count_trailing_zeros(bits);
+  }
+  return num_slots;
+}
+
+void timing_wheel_actor_clock::insert(delayed_event* x) {
+  auto index = expired_slot;
+  if (x->tick > current_tick_) {
+    // The highest digit that differs from the current tick selects the level.
+    auto diff = x->tick ^ current_tick_;
+    size_t level = 0;
+    while (level < num_levels && (diff >> ((level + 1) * slot_bits)) != 0)
+      ++level;
+    if (level == num_levels) {
+      index = overflow_slot;
+    } else {
+      auto pos = (x->tick >> (level * slot_bits)) & (num_slots - 1);
+      index = static_cast<uint32_t>(level * num_slots + pos);
+      bitmap_[index / 64] |= uint64_t{1} << (index % 64);
+    }
+  }
+  auto& slot = slots_[index];
+  x->slot = index;
+  x->next = nullptr;
+  x->prev = slot.tail;
+  if (slot.tail != nullptr)
+    slot.tail->next = x;
+  else
+    slot.head = x;
+  slot.tail = x;
+}
+
+void timing_wheel_actor_clock::erase_from_slot(delayed_event* x) noexcept {
+  auto& slot = slots_[x->slot];
+  if (x->prev != nullptr)
+    x->prev->next = x->next;
+  else
+    slot.head = x->next;
+  if (x->next != nullptr)
+    x->next->prev = x->prev;
+  else
+    slot.tail = x->prev;
+  x->prev = nullptr;
+  x->next = nullptr;
+  if (slot.head == nullptr && x->slot < overflow_slot)
+    bitmap_[x->slot / 64] &= ~(uint64_t{1} << (x->slot % 64));
+}
+
+timing_wheel_actor_clock::delayed_event*
+timing_wheel_actor_clock::take_slot(uint32_t index) noexcept {
+  auto& slot = slots_[index];
+  auto result = slot.head;
+  slot = slot_list{};
+  if (index < overflow_slot)
+    bitmap_[index / 64] &= ~(uint64_t{1} << (index % 64));
+  return result;
+}
+
+// -- event management ---------------------------------------------------------
+
+void timing_wheel_actor_clock::add(delayed_event* x) {
+  CAF_ASSERT(x != nullptr);
+  // Skip ahead while idle to keep new events on the lowest possible level.
+  if (size_ == 0) {
+    auto tick = floor_tick(now());
+    if (tick > current_tick_)
+      current_tick_ = tick;
+  }
+  x->tick = ceil_tick(x->due);
+  if (auto self = owner(*x)) {
+    auto aid = (*self)->id();
+    if (x->subtype == simple_actor_clock::request_timeout_type) {
+      auto id = static_cast<request_timeout*>(x)->id;
+      cancel_request_timeout(aid, id);
+      request_lookup_.emplace(request_key{aid, id.integer_value()}, x);
+    }
+    auto& head = actor_lookup_[aid];
+    x->prev_of_actor = nullptr;
+    x->next_of_actor = head;
+    if (head != nullptr)
+      head->prev_of_actor = x;
+    head = x;
+  }
+  insert(x);
+  ++size_;
+}
+
+void timing_wheel_actor_clock::unlink(delayed_event* x) noexcept {
+  erase_from_slot(x);
+  --size_;
+  auto self = owner(*x);
+  if (self == nullptr)
+    return;
+  auto aid = (*self)->id();
+  if (x->subtype == simple_actor_clock::request_timeout_type) {
+    auto id = static_cast<request_timeout*>(x)->id;
+    request_lookup_.erase(request_key{aid, id.integer_value()});
+  }
+  if (x->prev_of_actor != nullptr) {
+    x->prev_of_actor->next_of_actor = x->next_of_actor;
+  } else {
+    auto i = actor_lookup_.find(aid);
+    CAF_ASSERT(i != actor_lookup_.end());
+    if (x->next_of_actor != nullptr)
+      i->second = x->next_of_actor;
+    else
+      actor_lookup_.erase(i);
+  }
+  if (x->next_of_actor != nullptr)
+    x->next_of_actor->prev_of_actor = x->prev_of_actor;
+  x->prev_of_actor = nullptr;
+  x->next_of_actor = nullptr;
+}
+
+void timing_wheel_actor_clock::drop(delayed_event* x) noexcept {
+  unlink(x);
+  delete x;
+}
+
+void timing_wheel_actor_clock::fire(delayed_event* x) {
+  unlink(x);
+  std::unique_ptr<delayed_event> guard{x};
+  simple_actor_clock::ship(*x);
+}
+
+const strong_actor_ptr*
+timing_wheel_actor_clock::owner(const delayed_event& x) noexcept {
+  switch (x.subtype) {
+    case simple_actor_clock::ordinary_timeout_type:
+      return &static_cast<const ordinary_timeout&>(x).self;
+    case simple_actor_clock::multi_timeout_type:
+      return &static_cast<const multi_timeout&>(x).self;
+    case simple_actor_clock::request_timeout_type:
+      return &static_cast<const request_timeout&>(x).self;
+    default:
+      return nullptr;
+  }
+}
+
+timing_wheel_actor_clock::delayed_event*
+timing_wheel_actor_clock::find_ordinary_timeout(actor_id aid,
+                                                const std::string& type) {
+  auto i = actor_lookup_.find(aid);
+  if (i == actor_lookup_.end())
+    return nullptr;
+  for (auto x = i->second; x != nullptr; x = x->next_of_actor)
+    if (x->subtype == simple_actor_clock::ordinary_timeout_type
+        && static_cast<ordinary_timeout*>(x)->type == type)
+      return x;
+  return nullptr;
+}
+
+void timing_wheel_actor_clock::cancel_ordinary_timeout(
+  actor_id aid, const std::string& type) {
+  if (auto x = find_ordinary_timeout(aid, type))
+    drop(x);
+}
+
+void timing_wheel_actor_clock::cancel_request_timeout(actor_id aid,
+                                                      message_id id) {
+  auto i = request_lookup_.find(request_key{aid, id.integer_value()});
+  if (i != request_lookup_.end())
+    drop(i->second);
+}
+
+void timing_wheel_actor_clock::cancel_timeouts(actor_id aid) {
+  for (;;) {
+    auto i = actor_lookup_.find(aid);
+    if (i == actor_lookup_.end())
+      return;
+    drop(i->second);
+  }
+}
+
+} // namespace caf::detail
@@ -15,16 +15,9 @@
 namespace caf::detail {
 
 token_based_credit_controller::token_based_credit_controller(local_actor* ptr) {
-  namespace fallback = defaults::stream::token_policy;
-  // Initialize from the config parameters.
-  auto& cfg = ptr->system().config();
-  if (auto section = get_if<settings>(&cfg, "caf.stream.token-based-policy")) {
-    batch_size_ = get_or(*section, "batch-size", fallback::batch_size);
-    buffer_size_ = get_or(*section, "buffer-size", fallback::buffer_size);
-  } else {
-    batch_size_ = fallback::batch_size;
-    buffer_size_ = fallback::buffer_size;
-  }
+  const auto& policy = ptr->home_system().config_snapshot().token_policy;
+  batch_size_ = policy.batch_size;
+  buffer_size_ = policy.buffer_size;
 }
 
 token_based_credit_controller::~token_based_credit_controller() {
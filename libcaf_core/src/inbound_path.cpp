@@ -74,6 +74,11 @@ const settings& inbound_path::config() const noexcept {
   return content(mgr->self()->config());
 }
 
+detail::config_snapshot::credit_policy
+inbound_path::credit_policy() const noexcept {
+  return mgr->self()->home_system().config_snapshot().stream_credit_policy;
+}
+
 // -- callbacks ----------------------------------------------------------------
 
 void inbound_path::handle(downstream_msg::batch& batch) {
@@ -5,6 +5,7 @@
 #include "caf/local_actor.hpp"
 
 #include <condition_variable>
+#include <cstring>
 #include <string>
 
 #include "caf/actor_cast.hpp"
@@ -39,6 +40,9 @@ local_actor::metrics_t make_instance_metrics(local_actor* self) {
       nullptr,
       nullptr,
       nullptr,
+      nullptr,
+      nullptr,
+      nullptr,
     };
   self->setf(abstract_actor::collects_metrics_flag);
   const auto& families = sys.actor_metric_families();
@@ -47,6 +51,9 @@ local_actor::metrics_t make_instance_metrics(local_actor* self) {
     families.processing_time->get_or_add({{"name", sv}}),
     families.mailbox_time->get_or_add({{"name", sv}}),
     families.mailbox_size->get_or_add({{"name", sv}}),
+    families.throughput_budget->get_or_add({{"name", sv}}),
+    families.message_cost->get_or_add({{"name", sv}}),
+    families.dropped_messages->get_or_add({{"name", sv}}),
   };
 }
 
@@ -80,6 +87,16 @@ void local_actor::setup_metrics() {
   metrics_ = make_instance_metrics(this);
 }
 
+void local_actor::setup_metrics(const local_actor& prototype) {
+  if (strcmp(name(), prototype.name()) != 0) {
+    setup_metrics();
+    return;
+  }
+  metrics_ = prototype.metrics_;
+  if (prototype.getf(abstract_actor::collects_metrics_flag))
+    setf(abstract_actor::collects_metrics_flag);
+}
+
 auto local_actor::now() const noexcept -> clock_type::time_point {
   return clock().now();
 }
@@ -43,6 +43,15 @@ message_id dynamic_category_correction(const message& msg, message_id mid) {
 
 } // namespace
 
+void mailbox_element_deleter::operator()(mailbox_element* ptr) const noexcept {
+  if (auto block = ptr->block_) {
+    ptr->~mailbox_element();
+    block->release_element_ref();
+  } else {
+    delete ptr;
+  }
+}
+
 mailbox_element::mailbox_element(strong_actor_ptr sender, message_id mid,
                                  forwarding_stack stages, message payload)
   : sender(std::move(sender)),
@@ -56,8 +65,8 @@ mailbox_element_ptr
 make_mailbox_element(strong_actor_ptr sender, message_id id,
                      mailbox_element::forwarding_stack stages,
                      message payload) {
-  return std::make_unique<mailbox_element>(
-    std::move(sender), id, std::move(stages), std::move(payload));
+  return mailbox_element_ptr{new mailbox_element(
+    std::move(sender), id, std::move(stages), std::move(payload))};
 }
 
 } // namespace caf
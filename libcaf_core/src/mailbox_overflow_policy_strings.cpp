@@ -0,0 +1,65 @@
+// clang-format off
+// DO NOT EDIT: this file is auto-generated by caf-generate-enum-strings.
+// Run the target update-enum-strings if this file is out of sync.
+#include "caf/config.hpp"
+#include "caf/string_view.hpp"
+
+CAF_PUSH_DEPRECATED_WARNING
+
+#include "caf/mailbox_overflow_policy.hpp"
+
+#include <string>
+
+namespace caf {
+
+std::string to_string(mailbox_overflow_policy x) {
+  switch(x) {
+    default:
+      return "???";
+    case mailbox_overflow_policy::drop_newest:
+      return "caf::mailbox_overflow_policy::drop_newest";
+    case mailbox_overflow_policy::drop_oldest:
+      return "caf::mailbox_overflow_policy::drop_oldest";
+    case mailbox_overflow_policy::reject:
+      return "caf::mailbox_overflow_policy::reject";
+    case mailbox_overflow_policy::signal:
+      return "caf::mailbox_overflow_policy::signal";
+  };
+}
+
+bool from_string(string_view in, mailbox_overflow_policy& out) {
+  if (in == "caf::mailbox_overflow_policy::drop_newest") {
+    out = mailbox_overflow_policy::drop_newest;
+    return true;
+  } else if (in == "caf::mailbox_overflow_policy::drop_oldest") {
+    out = mailbox_overflow_policy::drop_oldest;
+    return true;
+  } else if (in == "caf::mailbox_overflow_policy::reject") {
+    out = mailbox_overflow_policy::reject;
+    return true;
+  } else if (in == "caf::mailbox_overflow_policy::signal") {
+    out = mailbox_overflow_policy::signal;
+    return true;
+  } else {
+    return false;
+  }
+}
+
+bool from_integer(std::underlying_type_t<mailbox_overflow_policy> in,
+                  mailbox_overflow_policy& out) {
+  auto result = static_cast<mailbox_overflow_policy>(in);
+  switch(result) {
+    default:
+      return false;
+    case mailbox_overflow_policy::drop_newest:
+    case mailbox_overflow_policy::drop_oldest:
+    case mailbox_overflow_policy::reject:
+    case mailbox_overflow_policy::signal:
+      out = result;
+      return true;
+  };
+}
+
+} // namespace caf
+
+CAF_POP_WARNINGS
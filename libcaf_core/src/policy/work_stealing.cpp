@@ -7,7 +7,9 @@
 #include "caf/actor_system_config.hpp"
 #include "caf/config_value.hpp"
 #include "caf/defaults.hpp"
+#include "caf/logger.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 
 #define CONFIG(str_name, var_name)                                             \
   get_or(p->config(), "caf.work-stealing." str_name,                           \
@@ -21,9 +23,6 @@ work_stealing::~work_stealing() {
 
 work_stealing::worker_data::worker_data(scheduler::abstract_coordinator* p)
   : rengine(std::random_device{}()),
-    // no need to worry about wrap-around; if `p->num_workers() < 2`,
-    // `uniform` will not be used anyway
-    uniform(0, p->num_workers() - 2),
     strategies{
       {{CONFIG("aggressive-poll-attempts", aggressive_poll_attempts), 1,
         CONFIG("aggressive-steal-interval", aggressive_steal_interval),
@@ -32,15 +31,73 @@ work_stealing::worker_data::worker_data(scheduler::abstract_coordinator* p)
         CONFIG("moderate-steal-interval", moderate_steal_interval),
         CONFIG("moderate-sleep-duration", moderate_sleep_duration)},
        {1, 0, CONFIG("relaxed-steal-interval", relaxed_steal_interval),
-        CONFIG("relaxed-sleep-duration", relaxed_sleep_duration)}}} {
-  // nop
+        CONFIG("relaxed-sleep-duration", relaxed_sleep_duration)}}},
+    pin_workers(CONFIG("pin-workers", pin_workers)),
+    locality_aware(CONFIG("locality-aware-stealing", locality_aware_stealing)),
+    max_lifo_runs(CONFIG("lifo-slot", lifo_slot)
+                    ? CONFIG("max-lifo-runs", max_lifo_runs)
+                    : size_t{0}) {
+  auto idle_strategy = CONFIG("idle-strategy", idle_strategy);
+  if (idle_strategy == "park") {
+    lot = std::make_shared<detail::parking_lot>(p->num_workers());
+  } else if (idle_strategy != "poll") {
+    CAF_LOG_WARNING("unrecognized idle strategy" << idle_strategy
+                                                 << "falling back to 'park'");
+    lot = std::make_shared<detail::parking_lot>(p->num_workers());
+  }
+  if (pin_workers || locality_aware) {
+    auto path = CONFIG("sysfs-cpu-path", sysfs_cpu_path);
+    topology = std::make_shared<detail::cpu_topology>(
+      detail::cpu_topology::read(path));
+    if (topology->empty()) {
+      CAF_LOG_WARNING("unable to read the CPU topology from" << path);
+      topology = nullptr;
+    }
+  }
+  stolen_jobs = p->system().metrics().counter_family(
+    "caf.scheduler", "stolen-jobs", {"locality"},
+    "Number of jobs that workers stole from other workers.", "1", true);
 }
 
 work_stealing::worker_data::worker_data(const worker_data& other)
   : rengine(std::random_device{}()),
-    uniform(other.uniform),
-    strategies(other.strategies) {
+    strategies(other.strategies),
+    topology(other.topology),
+    pin_workers(other.pin_workers),
+    locality_aware(other.locality_aware),
+    max_lifo_runs(other.max_lifo_runs),
+    lot(other.lot),
+    stolen_jobs(other.stolen_jobs) {
   // nop
 }
 
+void work_stealing::worker_data::init(size_t worker_id, size_t num_workers) {
+  using locality = detail::cpu_topology::locality;
+  if (topology && pin_workers) {
+    auto cpu = topology->cpu_for_worker(worker_id).id;
+    if (!detail::cpu_topology::pin_this_thread(cpu))
+      CAF_LOG_WARNING("unable to pin worker" << worker_id << "to CPU" << cpu);
+  }
+  if (topology && locality_aware) {
+    auto& self_cpu = topology->cpu_for_worker(worker_id);
+    for (auto x : {locality::l2, locality::llc, locality::numa,
+                   locality::remote})
+      victims[static_cast<size_t>(x)].stolen_jobs
+        = stolen_jobs->get_or_add({{"locality", to_string(x)}});
+    for (size_t id = 0; id < num_workers; ++id) {
+      if (id == worker_id)
+        continue;
+      auto dist = detail::cpu_topology::distance(self_cpu,
+                                                 topology->cpu_for_worker(id));
+      victims[static_cast<size_t>(dist)].workers.emplace_back(id);
+    }
+  } else {
+    auto& group = victims[0];
+    group.stolen_jobs = stolen_jobs->get_or_add({{"locality", "unknown"}});
+    for (size_t id = 0; id < num_workers; ++id)
+      if (id != worker_id)
+        group.workers.emplace_back(id);
+  }
+}
+
 } // namespace caf::policy
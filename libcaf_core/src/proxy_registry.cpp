@@ -13,10 +13,18 @@
 #include "caf/serializer.hpp"
 
 #include "caf/actor_registry.hpp"
+#include "caf/locks.hpp"
 #include "caf/logger.hpp"
 
 namespace caf {
 
+namespace {
+
+using exclusive_guard = unique_lock<detail::shared_spinlock>;
+using shared_guard = shared_lock<detail::shared_spinlock>;
+
+} // namespace
+
 proxy_registry::backend::~backend() {
   // nop
 }
@@ -31,15 +39,21 @@ proxy_registry::~proxy_registry() {
 }
 
 size_t proxy_registry::count_proxies(const node_id& node) const {
-  std::unique_lock<std::mutex> guard{mtx_};
-  auto i = proxies_.find(node);
-  return i != proxies_.end() ? i->second.size() : 0;
+  size_t result = 0;
+  for (auto& x : shards_) {
+    shared_guard guard{x.mtx};
+    auto i = x.proxies.find(node);
+    if (i != x.proxies.end())
+      result += i->second.size();
+  }
+  return result;
 }
 
 strong_actor_ptr proxy_registry::get(const node_id& node, actor_id aid) const {
-  std::unique_lock<std::mutex> guard{mtx_};
-  auto i = proxies_.find(node);
-  if (i == proxies_.end())
+  auto& x = shard_for(node, aid);
+  shared_guard guard{x.mtx};
+  auto i = x.proxies.find(node);
+  if (i == x.proxies.end())
     return nullptr;
   auto j = i->second.find(aid);
   return j != i->second.end() ? j->second : nullptr;
@@ -47,47 +61,68 @@ strong_actor_ptr proxy_registry::get(const node_id& node, actor_id aid) const {
 
 strong_actor_ptr proxy_registry::get_or_put(const node_id& nid, actor_id aid) {
   CAF_LOG_TRACE(CAF_ARG(nid) << CAF_ARG(aid));
-  std::unique_lock<std::mutex> guard{mtx_};
-  auto& result = proxies_[nid][aid];
-  if (!result)
-    result = backend_.make_proxy(nid, aid);
+  auto& x = shard_for(nid, aid);
+  // Optimistically assume that the proxy exists.
+  if (auto result = get(nid, aid))
+    return result;
+  // Create the proxy outside of the spinlock to keep readers of this shard
+  // from spinning while the backend spawns the proxy. Holding the creation
+  // mutex makes sure that only one thread creates a proxy for `nid` and `aid`.
+  std::unique_lock<std::mutex> creation_guard{x.creation_mtx};
+  if (auto result = get(nid, aid))
+    return result;
+  auto result = backend_.make_proxy(nid, aid);
+  if (result) {
+    exclusive_guard guard{x.mtx};
+    x.proxies[nid][aid] = result;
+  }
   return result;
 }
 
 std::vector<strong_actor_ptr>
 proxy_registry::get_all(const node_id& node) const {
-  // Reserve at least some memory outside of the critical section.
+  // Reserve at least some memory outside of the critical sections.
   std::vector<strong_actor_ptr> result;
   result.reserve(128);
-  std::unique_lock<std::mutex> guard{mtx_};
-  auto i = proxies_.find(node);
-  if (i != proxies_.end())
-    for (auto& kvp : i->second)
-      result.emplace_back(kvp.second);
+  for (auto& x : shards_) {
+    shared_guard guard{x.mtx};
+    auto i = x.proxies.find(node);
+    if (i != x.proxies.end())
+      for (auto& kvp : i->second)
+        result.emplace_back(kvp.second);
+  }
+  auto id_less = [](const strong_actor_ptr& x, const strong_actor_ptr& y) {
+    return x->id() < y->id();
+  };
+  std::sort(result.begin(), result.end(), id_less);
   return result;
 }
 
 bool proxy_registry::empty() const {
-  std::unique_lock<std::mutex> guard{mtx_};
-  return proxies_.empty();
+  return std::all_of(shards_.begin(), shards_.end(), [](const shard& x) {
+    shared_guard guard{x.mtx};
+    return x.proxies.empty();
+  });
 }
 
 void proxy_registry::erase(const node_id& nid) {
   CAF_LOG_TRACE(CAF_ARG(nid));
-  // Move submap for `nid` to a local variable.
-  proxy_map tmp;
-  {
-    using std::swap;
-    std::unique_lock<std::mutex> guard{mtx_};
-    auto i = proxies_.find(nid);
-    if (i == proxies_.end())
-      return;
-    swap(i->second, tmp);
-    proxies_.erase(i);
+  for (auto& x : shards_) {
+    // Move submap for `nid` to a local variable.
+    proxy_map tmp;
+    {
+      using std::swap;
+      exclusive_guard guard{x.mtx};
+      auto i = x.proxies.find(nid);
+      if (i == x.proxies.end())
+        continue;
+      swap(i->second, tmp);
+      x.proxies.erase(i);
+    }
+    // Call kill_proxy outside the critical section.
+    for (auto& kvp : tmp)
+      kill_proxy(kvp.second, exit_reason::remote_link_unreachable);
   }
-  // Call kill_proxy outside the critical section.
-  for (auto& kvp : tmp)
-    kill_proxy(kvp.second, exit_reason::remote_link_unreachable);
 }
 
 void proxy_registry::erase(const node_id& nid, actor_id aid, error rsn) {
@@ -96,9 +131,10 @@ void proxy_registry::erase(const node_id& nid, actor_id aid, error rsn) {
   strong_actor_ptr erased_proxy;
   {
     using std::swap;
-    std::unique_lock<std::mutex> guard{mtx_};
-    auto i = proxies_.find(nid);
-    if (i != proxies_.end()) {
+    auto& x = shard_for(nid, aid);
+    exclusive_guard guard{x.mtx};
+    auto i = x.proxies.find(nid);
+    if (i != x.proxies.end()) {
       auto& submap = i->second;
       auto j = submap.find(aid);
       if (j == submap.end())
@@ -106,7 +142,7 @@ void proxy_registry::erase(const node_id& nid, actor_id aid, error rsn) {
       swap(j->second, erased_proxy);
       submap.erase(j);
       if (submap.empty())
-        proxies_.erase(i);
+        x.proxies.erase(i);
     }
   }
   // Call kill_proxy outside the critical section.
@@ -116,18 +152,31 @@ void proxy_registry::erase(const node_id& nid, actor_id aid, error rsn) {
 
 void proxy_registry::clear() {
   CAF_LOG_TRACE("");
-  // Move the content of proxies_ to a local variable.
-  std::unordered_map<node_id, proxy_map> tmp;
-  {
-    using std::swap;
-    std::unique_lock<std::mutex> guard{mtx_};
-    swap(proxies_, tmp);
+  for (auto& x : shards_) {
+    // Move the content of the shard to a local variable.
+    node_map tmp;
+    {
+      using std::swap;
+      exclusive_guard guard{x.mtx};
+      swap(x.proxies, tmp);
+    }
+    // Call kill_proxy outside the critical section.
+    for (auto& kvp : tmp)
+      for (auto& sub_kvp : kvp.second)
+        kill_proxy(sub_kvp.second, exit_reason::remote_link_unreachable);
   }
-  // Call kill_proxy outside the critical section.
-  for (auto& kvp : tmp)
-    for (auto& sub_kvp : kvp.second)
-      kill_proxy(sub_kvp.second, exit_reason::remote_link_unreachable);
-  proxies_.clear();
+}
+
+proxy_registry::shard& proxy_registry::shard_for(const node_id& nid,
+                                                 actor_id aid) noexcept {
+  auto key = std::hash<node_id>{}(nid) ^ static_cast<size_t>(aid);
+  return shards_[key & (num_shards - 1)];
+}
+
+const proxy_registry::shard&
+proxy_registry::shard_for(const node_id& nid, actor_id aid) const noexcept {
+  auto key = std::hash<node_id>{}(nid) ^ static_cast<size_t>(aid);
+  return shards_[key & (num_shards - 1)];
 }
 
 void proxy_registry::kill_proxy(strong_actor_ptr& ptr, error rsn) {
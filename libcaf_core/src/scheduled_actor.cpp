@@ -4,6 +4,9 @@
 
 #include "caf/scheduled_actor.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #include "caf/actor_ostream.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/config.hpp"
@@ -11,6 +14,7 @@
 #include "caf/detail/default_invoke_result_visitor.hpp"
 #include "caf/detail/meta_object.hpp"
 #include "caf/detail/private_thread.hpp"
+#include "caf/detail/scope_guard.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
 #include "caf/inbound_path.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
@@ -84,6 +88,11 @@ void scheduled_actor::default_exit_handler(scheduled_actor* ptr, exit_msg& x) {
     default_error_handler(ptr, x.reason);
 }
 
+void scheduled_actor::default_backpressure_handler(scheduled_actor*,
+                                                   backpressure_msg&) {
+  // nop
+}
+
 #ifdef CAF_ENABLE_EXCEPTIONS
 error scheduled_actor::default_exception_handler(local_actor* ptr,
                                                  std::exception_ptr& x) {
@@ -117,15 +126,18 @@ scheduled_actor::scheduled_actor(actor_config& cfg)
     down_handler_(default_down_handler),
     node_down_handler_(default_node_down_handler),
     exit_handler_(default_exit_handler),
-    private_thread_(nullptr)
+    backpressure_handler_(default_backpressure_handler),
+    private_thread_(nullptr),
+    message_cost_(0),
+    mailbox_capacity_(cfg.mailbox_capacity),
+    mailbox_overflow_(cfg.mailbox_overflow),
+    mailbox_depth_(0)
 #ifdef CAF_ENABLE_EXCEPTIONS
     ,
     exception_handler_(default_exception_handler)
 #endif // CAF_ENABLE_EXCEPTIONS
 {
-  auto& sys_cfg = home_system().config();
-  max_batch_delay_ = get_or(sys_cfg, "caf.stream.max_batch_delay",
-                            defaults::stream::max_batch_delay);
+  max_batch_delay_ = home_system().config_snapshot().stream_max_batch_delay;
 }
 
 scheduled_actor::~scheduled_actor() {
@@ -142,6 +154,12 @@ void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   auto mid = ptr->mid;
   auto sender = ptr->sender;
   auto collects_metrics = getf(abstract_actor::collects_metrics_flag);
+  auto bounded = mailbox_capacity_ > 0 && counts_towards_capacity(*ptr);
+  if (bounded) {
+    auto depth = mailbox_depth_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (depth > mailbox_capacity_ && !handle_mailbox_overflow(ptr, depth, eu))
+      return;
+  }
   if (collects_metrics) {
     ptr->set_enqueue_time();
     metrics_.mailbox_size->inc();
@@ -163,6 +181,8 @@ void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
       home_system().base_metrics().rejected_messages->inc();
       if (collects_metrics)
         metrics_.mailbox_size->dec();
+      if (bounded)
+        mailbox_depth_.fetch_sub(1, std::memory_order_relaxed);
       if (mid.is_request()) {
         detail::sync_request_bouncer f{exit_reason()};
         f(sender, mid);
@@ -214,6 +234,17 @@ void scheduled_actor::launch(execution_unit* ctx, bool lazy, bool hide) {
   }
 }
 
+void scheduled_actor::request_response_timeout(timespan timeout,
+                                               message_id mid) {
+  CAF_LOG_TRACE(CAF_ARG(timeout) << CAF_ARG(mid));
+  if (timeout == infinite)
+    return;
+  auto rid = mid.response_id();
+  auto token = make_counted<detail::timeout_token>();
+  clock().set_request_timeout(clock().now() + timeout, this, rid, token);
+  pending_requests_.set_token(rid, std::move(token));
+}
+
 bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
   CAF_LOG_TRACE(CAF_ARG(fail_state));
   // Shutdown hosting thread when running detached.
@@ -222,6 +253,7 @@ bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
   // Clear state for open requests.
   awaited_responses_.clear();
   multiplexed_responses_.clear();
+  pending_requests_.clear();
   // Clear state for open streams.
   for (auto& kvp : stream_managers_)
     kvp.second->stop(fail_state);
@@ -270,6 +302,47 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
   if (!activate(ctx))
     return resumable::done;
   size_t consumed = 0;
+  // With time slicing, the actor also stops after running for `time_slice`.
+  // With adaptive throughput, the actor additionally picks a message budget
+  // that fits into the time slice based on its previous message costs.
+  auto& sched = home_system().scheduler();
+  auto time_slice = sched.time_slice();
+  auto budget = max_throughput;
+  auto adaptive = false;
+  clock_type::time_point t0;
+  clock_type::time_point deadline;
+  if (time_slice.count() > 0) {
+    t0 = clock_type::now();
+    deadline = t0 + time_slice;
+    if (sched.adaptive_throughput() && message_cost_.count() > 0) {
+      auto n = static_cast<size_t>(time_slice / message_cost_);
+      budget = std::max(size_t{1}, std::min(n, max_throughput));
+      adaptive = true;
+    }
+  }
+  // Updates the message costs when leaving this function.
+  auto guard = detail::make_scope_guard([&] {
+    if (time_slice.count() == 0 || consumed == 0)
+      return;
+    auto sample = (clock_type::now() - t0) / consumed;
+    if (message_cost_.count() == 0)
+      message_cost_ = sample;
+    else
+      message_cost_ += (sample - message_cost_) / 8;
+    if (metrics_.message_cost) {
+      // Without an adaptive budget, `budget` is the (unbounded) maximum
+      // throughput of the scheduler and has no meaning for the gauge.
+      using dbl_seconds = std::chrono::duration<double>;
+      if (adaptive)
+        metrics_.throughput_budget->value(static_cast<int64_t>(budget));
+      metrics_.message_cost->value(dbl_seconds{message_cost_}.count());
+    }
+  });
+  // Returns whether the actor may consume more messages in this run.
+  auto has_budget = [&] {
+    return consumed < budget
+           && (time_slice.count() == 0 || clock_type::now() < deadline);
+  };
   actor_clock::time_point tout{actor_clock::duration_type{0}};
   auto reset_timeouts_if_needed = [&] {
     // Set a new receive timeout if we called our behavior at least once.
@@ -284,24 +357,29 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
     }
   };
   // Callback for handling urgent and normal messages.
-  auto handle_async = [this, max_throughput, &consumed](mailbox_element& x) {
-    return run_with_metrics(x, [this, max_throughput, &consumed, &x] {
+  auto handle_async = [this, &consumed, &has_budget](mailbox_element& x) {
+    auto res = run_with_metrics(x, [this, &consumed, &has_budget, &x] {
       switch (reactivate(x)) {
         case activation_result::terminated:
           return intrusive::task_result::stop;
         case activation_result::success:
-          return ++consumed < max_throughput ? intrusive::task_result::resume
-                                             : intrusive::task_result::stop_all;
+          ++consumed;
+          return has_budget() ? intrusive::task_result::resume
+                              : intrusive::task_result::stop_all;
         case activation_result::skipped:
           return intrusive::task_result::skip;
         default:
           return intrusive::task_result::resume;
       }
     });
+    if (res != intrusive::task_result::skip && mailbox_capacity_ > 0
+        && counts_towards_capacity(x))
+      mailbox_depth_.fetch_sub(1, std::memory_order_relaxed);
+    return res;
   };
   // Callback for handling upstream messages (e.g., ACKs).
-  auto handle_umsg = [this, max_throughput, &consumed](mailbox_element& x) {
-    return run_with_metrics(x, [this, max_throughput, &consumed, &x] {
+  auto handle_umsg = [this, &consumed, &has_budget](mailbox_element& x) {
+    return run_with_metrics(x, [this, &consumed, &has_budget, &x] {
       current_mailbox_element(&x);
       CAF_LOG_RECEIVE_EVENT((&x));
       CAF_BEFORE_PROCESSING(this, x);
@@ -312,14 +390,15 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
       };
       visit(f, um.content);
       CAF_AFTER_PROCESSING(this, invoke_message_result::consumed);
-      return ++consumed < max_throughput ? intrusive::task_result::resume
-                                         : intrusive::task_result::stop_all;
+      ++consumed;
+      return has_budget() ? intrusive::task_result::resume
+                          : intrusive::task_result::stop_all;
     });
   };
   // Callback for handling downstream messages (e.g., batches).
-  auto handle_dmsg = [this, &consumed, max_throughput](stream_slot, auto& q,
-                                                       mailbox_element& x) {
-    return run_with_metrics(x, [this, max_throughput, &consumed, &q, &x] {
+  auto handle_dmsg = [this, &consumed, &has_budget](stream_slot, auto& q,
+                                                    mailbox_element& x) {
+    return run_with_metrics(x, [this, &consumed, &has_budget, &q, &x] {
       current_mailbox_element(&x);
       CAF_LOG_RECEIVE_EVENT((&x));
       CAF_BEFORE_PROCESSING(this, x);
@@ -369,15 +448,18 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
       };
       auto res = visit(f, dm.content);
       CAF_AFTER_PROCESSING(this, invoke_message_result::consumed);
-      return ++consumed < max_throughput ? res
-                                         : intrusive::task_result::stop_all;
+      ++consumed;
+      return has_budget() ? res : intrusive::task_result::stop_all;
     });
   };
   std::vector<stream_manager*> managers;
   mailbox_element_ptr ptr;
-  while (consumed < max_throughput) {
+  while (has_budget()) {
     CAF_LOG_DEBUG("start new DRR round");
     mailbox_.fetch_more();
+    if (mailbox_overflow_ == mailbox_overflow_policy::drop_oldest
+        && mailbox_capacity_ > 0)
+      trim_mailbox();
     auto prev = consumed; // Caches the value before processing more.
     // TODO: maybe replace '3' with configurable / adaptive value?
     static constexpr size_t quantum = 3;
@@ -407,7 +489,7 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
         for (auto mgr : managers)
           mgr->push();
       } while (
-        consumed < max_throughput
+        has_budget()
         && get_downstream_queue().new_round(0, handle_dmsg).consumed_items > 0);
     }
     // Update metrics or try returning if the actor consumed nothing.
@@ -432,7 +514,7 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
     if (auto now = clock().now(); now >= tout)
       tout = advance_streams(now);
   }
-  CAF_LOG_DEBUG("max throughput reached");
+  CAF_LOG_DEBUG("max throughput or time slice reached");
   reset_timeouts_if_needed();
   if (mailbox().try_block())
     return resumable::awaiting_message;
@@ -461,6 +543,7 @@ void scheduled_actor::quit(error x) {
   bhvr_stack_.clear();
   awaited_responses_.clear();
   multiplexed_responses_.clear();
+  pending_requests_.clear();
   // Ignore future exit, down and error messages.
   set_exit_handler(silently_ignore<exit_msg>);
   set_down_handler(silently_ignore<down_msg>);
@@ -602,6 +685,11 @@ void scheduled_actor::add_multiplexed_response_handler(message_id response_id,
   multiplexed_responses_.emplace(response_id, std::move(bhvr));
 }
 
+void scheduled_actor::add_multiplexed_response_handler(
+  message_id response_id, detail::response_continuation f) {
+  pending_requests_.set_continuation(response_id, std::move(f));
+}
+
 scheduled_actor::message_category
 scheduled_actor::categorize(mailbox_element& x) {
   CAF_LOG_TRACE(CAF_ARG(x));
@@ -671,6 +759,11 @@ scheduled_actor::categorize(mailbox_element& x) {
     call_handler(node_down_handler_, this, dm);
     return message_category::internal;
   }
+  if (auto view = make_typed_message_view<backpressure_msg>(content)) {
+    auto& bm = get<0>(view);
+    call_handler(backpressure_handler_, this, bm);
+    return message_category::internal;
+  }
   if (auto view = make_typed_message_view<error>(content)) {
     auto& err = get<0>(view);
     call_handler(error_handler_, this, err);
@@ -698,6 +791,10 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
       return f(in.content()) != none;
     };
     auto select_invoke_fun = [&]() -> fun_t { return ordinary_invoke; };
+    // The response (or its timeout) is here. Tell the clock to discard the
+    // timeout instead of delivering it later.
+    if (x.mid.is_response() && !pending_requests_.empty())
+      pending_requests_.dispose_token(x.mid);
     // Short-circuit awaited responses.
     if (!awaited_responses_.empty()) {
       auto invoke = select_invoke_fun();
@@ -717,6 +814,17 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
     }
     // Handle multiplexed responses.
     if (x.mid.is_response()) {
+      if (pending_requests_.continuations() > 0) {
+        if (auto f = pending_requests_.take_continuation(x.mid)) {
+          if (!f(x.content())) {
+            CAF_LOG_DEBUG("got unexpected_response");
+            auto msg = make_message(
+              make_error(sec::unexpected_response, std::move(x.payload)));
+            f(msg);
+          }
+          return invoke_message_result::consumed;
+        }
+      }
       auto invoke = select_invoke_fun();
       auto mrh = multiplexed_responses_.find(x.mid);
       // neither awaited nor multiplexed, probably an expired timeout
@@ -912,6 +1020,79 @@ bool scheduled_actor::finalize() {
   return true;
 }
 
+bool scheduled_actor::handle_mailbox_overflow(mailbox_element_ptr& ptr,
+                                              size_t depth,
+                                              execution_unit* eu) {
+  CAF_LOG_TRACE(CAF_ARG(depth));
+  auto& sender = ptr->sender;
+  switch (mailbox_overflow_) {
+    case mailbox_overflow_policy::drop_oldest:
+      // The actor trims its mailbox when fetching new messages.
+      return true;
+    case mailbox_overflow_policy::signal:
+      if (sender != nullptr)
+        sender->enqueue(ctrl(), make_message_id(),
+                        make_message(backpressure_msg{address(), depth}), eu);
+      return true;
+    default:
+      break;
+  }
+  mailbox_depth_.fetch_sub(1, std::memory_order_relaxed);
+  CAF_LOG_REJECT_EVENT();
+  if (metrics_.dropped_messages)
+    metrics_.dropped_messages->inc();
+  if (sender != nullptr) {
+    if (ptr->mid.is_request())
+      sender->enqueue(ctrl(), ptr->mid.response_id(),
+                      make_message(make_error(sec::mailbox_full)), eu);
+    else if (mailbox_overflow_ == mailbox_overflow_policy::reject)
+      sender->enqueue(ctrl(), make_message_id(),
+                      make_message(make_error(sec::mailbox_full)), eu);
+  }
+  return false;
+}
+
+void scheduled_actor::trim_mailbox() {
+  auto& queue = get_normal_queue();
+  auto depth = mailbox_depth_.load(std::memory_order_relaxed);
+  if (depth <= mailbox_capacity_)
+    return;
+  size_t dropped = 0;
+  auto trim = [&](auto& items) {
+    // Responses never count towards the capacity, so we put them back in
+    // front of the remaining messages after dropping enough ordinary messages.
+    using list_type = std::decay_t<decltype(items)>;
+    using task_size_type = typename list_type::task_size_type;
+    list_type responses{items.policy()};
+    auto deficit = std::numeric_limits<task_size_type>::max();
+    while (depth - dropped > mailbox_capacity_ && !items.empty()) {
+      auto ptr = items.next(deficit);
+      if (!counts_towards_capacity(*ptr)) {
+        responses.push_back(ptr.release());
+        continue;
+      }
+      CAF_LOG_DEBUG("drop oldest message" << CAF_ARG2("mid", ptr->mid));
+      if (ptr->sender != nullptr && ptr->mid.is_request())
+        ptr->sender->enqueue(ctrl(), ptr->mid.response_id(),
+                             make_message(make_error(sec::mailbox_full)),
+                             context());
+      ++dropped;
+    }
+    items.prepend(responses);
+  };
+  // Skipped messages wait in the cache and are older than all other messages.
+  trim(queue.cache());
+  trim(queue.items());
+  if (dropped == 0)
+    return;
+  mailbox_depth_.fetch_sub(dropped, std::memory_order_relaxed);
+  if (getf(abstract_actor::collects_metrics_flag)) {
+    auto val = static_cast<int64_t>(dropped);
+    metrics_.mailbox_size->dec(val);
+    metrics_.dropped_messages->inc(val);
+  }
+}
+
 void scheduled_actor::push_to_cache(mailbox_element_ptr ptr) {
   using namespace intrusive;
   auto& p = mailbox_.queue().policy();
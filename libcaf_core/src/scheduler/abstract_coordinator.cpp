@@ -172,6 +172,11 @@ const actor_system_config& abstract_coordinator::config() const {
   return system_.config();
 }
 
+void abstract_coordinator::bulk_enqueue(span<resumable* const> jobs) {
+  for (auto job : jobs)
+    enqueue(job);
+}
+
 bool abstract_coordinator::detaches_utility_actors() const {
   return true;
 }
@@ -189,6 +194,9 @@ void abstract_coordinator::init(actor_system_config& cfg) {
                            sr::max_throughput);
   num_workers_ = get_or(cfg, "caf.scheduler.max-threads",
                         default_thread_count());
+  time_slice_ = get_or(cfg, "caf.scheduler.time-slice", sr::time_slice);
+  adaptive_throughput_ = get_or(cfg, "caf.scheduler.adaptive-throughput",
+                                sr::adaptive_throughput);
 }
 
 actor_system::module::id_t abstract_coordinator::id() const {
@@ -208,7 +216,12 @@ void abstract_coordinator::stop_actors() {
 }
 
 abstract_coordinator::abstract_coordinator(actor_system& sys)
-  : next_worker_(0), max_throughput_(0), num_workers_(0), system_(sys) {
+  : next_worker_(0),
+    max_throughput_(0),
+    time_slice_(0),
+    adaptive_throughput_(false),
+    num_workers_(0),
+    system_(sys) {
   // nop
 }
 
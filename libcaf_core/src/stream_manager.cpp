@@ -24,9 +24,8 @@ namespace caf {
 
 stream_manager::stream_manager(scheduled_actor* selfptr, stream_priority prio)
   : self_(selfptr), pending_handshakes_(0), priority_(prio), flags_(0) {
-  auto& cfg = selfptr->config();
-  max_batch_delay_ = get_or(cfg, "caf.stream.max-batch-delay",
-                            defaults::stream::max_batch_delay);
+  const auto& snapshot = selfptr->home_system().config_snapshot();
+  max_batch_delay_ = snapshot.stream_max_batch_delay;
 }
 
 stream_manager::~stream_manager() {
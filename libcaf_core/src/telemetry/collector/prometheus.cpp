@@ -5,9 +5,11 @@
 #include "caf/telemetry/collector/prometheus.hpp"
 
 #include <cmath>
+#include <cstdio>
 #include <ctime>
 #include <type_traits>
 
+#include "caf/detail/print.hpp"
 #include "caf/telemetry/dbl_gauge.hpp"
 #include "caf/telemetry/int_gauge.hpp"
 #include "caf/telemetry/metric.hpp"
@@ -114,7 +116,14 @@ void append(prometheus::char_buffer& buf, double val, Ts&&... xs) {
     else
       append(buf, "-Inf"_sv);
   } else {
-    append(buf, std::to_string(val));
+    // Same output as std::to_string, but without allocating a string unless
+    // the value has more than 64 characters in fixed notation.
+    char tmp[64];
+    auto len = snprintf(tmp, sizeof(tmp), "%f", val);
+    if (len > 0 && static_cast<size_t>(len) < sizeof(tmp))
+      append(buf, string_view{tmp, static_cast<size_t>(len)});
+    else
+      append(buf, std::to_string(val));
   }
   append(buf, std::forward<Ts>(xs)...);
 }
@@ -122,7 +131,7 @@ void append(prometheus::char_buffer& buf, double val, Ts&&... xs) {
 template <class T, class... Ts>
 std::enable_if_t<std::is_integral<T>::value>
 append(prometheus::char_buffer& buf, T val, Ts&&... xs) {
-  append(buf, std::to_string(val));
+  detail::print(buf, val);
   append(buf, std::forward<Ts>(xs)...);
 }
 
@@ -177,7 +186,9 @@ void append(prometheus::char_buffer& buf, const prometheus::char_buffer& x,
 void prometheus::reset() {
   buf_.clear();
   last_scrape_ = timestamp{timespan{0}};
+  timestamp_info_.clear();
   family_info_.clear();
+  instance_info_.clear();
   histogram_info_.clear();
   current_family_ = nullptr;
   min_scrape_interval_ = timespan{0};
@@ -189,6 +200,8 @@ bool prometheus::begin_scrape(timestamp now) {
   if (buf_.empty() || last_scrape_ + min_scrape_interval_ <= now) {
     buf_.clear();
     last_scrape_ = now;
+    timestamp_info_.clear();
+    append(timestamp_info_, ' ', ms_timestamp{now}, '\n');
     current_family_ = nullptr;
     return true;
   } else {
@@ -242,20 +255,28 @@ void prometheus::set_current_family(const metric_family* family,
   buf_.insert(buf_.end(), i->second.begin(), i->second.end());
 }
 
+const prometheus::char_buffer&
+prometheus::instance_info(const metric_family* family, const metric* instance) {
+  auto i = instance_info_.find(instance);
+  if (i == instance_info_.end()) {
+    i = instance_info_.emplace(instance, char_buffer{}).first;
+    append(i->second, family, instance, ' ');
+  }
+  return i->second;
+}
+
 void prometheus::append_impl(const metric_family* family,
                              string_view prometheus_type,
                              const metric* instance, int64_t value) {
   set_current_family(family, prometheus_type);
-  append(buf_, family, instance, ' ', value, ' ', ms_timestamp{last_scrape_},
-         '\n');
+  append(buf_, instance_info(family, instance), value, timestamp_info_);
 }
 
 void prometheus::append_impl(const metric_family* family,
                              string_view prometheus_type,
                              const metric* instance, double value) {
   set_current_family(family, prometheus_type);
-  append(buf_, family, instance, ' ', value, ' ', ms_timestamp{last_scrape_},
-         '\n');
+  append(buf_, instance_info(family, instance), value, timestamp_info_);
 }
 
 namespace {
@@ -307,10 +328,10 @@ void prometheus::append_histogram_impl(const metric_family* family,
   auto index = size_t{0};
   for (; index < buckets.size(); ++index) {
     acc += buckets[index].count.value();
-    append(buf_, vm[index], acc, ' ', ms_timestamp{last_scrape_}, '\n');
+    append(buf_, vm[index], acc, timestamp_info_);
   }
-  append(buf_, vm[index++], sum, ' ', ms_timestamp{last_scrape_}, '\n');
-  append(buf_, vm[index++], acc, ' ', ms_timestamp{last_scrape_}, '\n');
+  append(buf_, vm[index++], sum, timestamp_info_);
+  append(buf_, vm[index++], acc, timestamp_info_);
 }
 
 } // namespace caf::telemetry::collector
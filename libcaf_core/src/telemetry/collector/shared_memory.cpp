@@ -0,0 +1,381 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/telemetry/collector/shared_memory.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include "caf/config.hpp"
+#include "caf/sec.hpp"
+#include "caf/telemetry/dbl_gauge.hpp"
+#include "caf/telemetry/int_gauge.hpp"
+#include "caf/telemetry/metric.hpp"
+#include "caf/telemetry/metric_family.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+#include "caf/telemetry/shared_memory_format.hpp"
+
+#ifdef CAF_POSIX
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace caf::telemetry::collector {
+
+namespace fmt = shared_memory_format;
+
+namespace {
+
+uint64_t to_word(int64_t value) noexcept {
+  return static_cast<uint64_t>(value);
+}
+
+uint64_t to_word(double value) noexcept {
+  uint64_t result;
+  memcpy(&result, &value, sizeof(result));
+  return result;
+}
+
+// Writes the static parts of the file into a buffer before copying them into
+// the mapped memory in one go.
+class layout_builder {
+public:
+  explicit layout_builder(size_t size) : buf_(size) {
+    // nop
+  }
+
+  size_t size() const noexcept {
+    return buf_.size();
+  }
+
+  const std::byte* data() const noexcept {
+    return buf_.data();
+  }
+
+  // Reserves `size` bytes at the end of the buffer, aligned to 8 bytes.
+  size_t allocate(size_t size) {
+    auto offset = (buf_.size() + 7) & ~size_t{7};
+    buf_.resize(offset + size);
+    return offset;
+  }
+
+  fmt::string_ref add(string_view str) {
+    auto offset = allocate(str.size());
+    memcpy(buf_.data() + offset, str.data(), str.size());
+    return {offset, str.size()};
+  }
+
+  template <class T>
+  void put(size_t offset, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value);
+    memcpy(buf_.data() + offset, &value, sizeof(T));
+  }
+
+private:
+  std::vector<std::byte> buf_;
+};
+
+} // namespace
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+shared_memory::~shared_memory() {
+  close();
+}
+
+// -- file management ----------------------------------------------------------
+
+#ifdef CAF_POSIX
+
+error shared_memory::open(const std::string& path) {
+  close();
+  // Remove any previous file to make sure that readers with an existing
+  // mapping never observe a truncated file.
+  ::unlink(path.c_str());
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (fd_ == -1)
+    return make_error(sec::cannot_open_file, path, strerror(errno));
+  path_ = path;
+  if (auto err = reserve(sizeof(fmt::header))) {
+    close();
+    return err;
+  }
+  auto hdr = new (data_) fmt::header;
+  hdr->magic = fmt::magic;
+  hdr->version = fmt::version;
+  hdr->header_size = sizeof(fmt::header);
+  hdr->layout_seq.store(0, std::memory_order_relaxed);
+  hdr->file_size = sizeof(fmt::header);
+  hdr->num_records = 0;
+  hdr->records_offset = sizeof(fmt::header);
+  hdr->last_update.store(0, std::memory_order_relaxed);
+  hdr->reserved = 0;
+  std::atomic_thread_fence(std::memory_order_release);
+  return none;
+}
+
+void shared_memory::close() {
+  if (data_ != nullptr) {
+    ::munmap(data_, mapped_size_);
+    data_ = nullptr;
+    mapped_size_ = 0;
+  }
+  if (fd_ != -1) {
+    ::close(fd_);
+    ::unlink(path_.c_str());
+    fd_ = -1;
+  }
+  path_.clear();
+  entries_.clear();
+  layout_.clear();
+  value_offsets_.clear();
+}
+
+error shared_memory::reserve(size_t size) {
+  if (size <= mapped_size_)
+    return none;
+  auto new_size = std::max(size, mapped_size_ * 2);
+  if (::ftruncate(fd_, static_cast<off_t>(new_size)) != 0)
+    return make_error(sec::runtime_error, "ftruncate failed", strerror(errno));
+  auto ptr = ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_,
+                    0);
+  if (ptr == MAP_FAILED)
+    return make_error(sec::runtime_error, "mmap failed", strerror(errno));
+  if (data_ != nullptr)
+    ::munmap(data_, mapped_size_);
+  data_ = static_cast<std::byte*>(ptr);
+  mapped_size_ = new_size;
+  return none;
+}
+
+#else // CAF_POSIX
+
+error shared_memory::open(const std::string&) {
+  return make_error(sec::unsupported_operation,
+                    "shared memory export requires a POSIX system");
+}
+
+void shared_memory::close() {
+  // nop
+}
+
+error shared_memory::reserve(size_t) {
+  return make_error(sec::unsupported_operation,
+                    "shared memory export requires a POSIX system");
+}
+
+#endif // CAF_POSIX
+
+// -- collect API --------------------------------------------------------------
+
+error shared_memory::collect_from(const metric_registry& registry,
+                                  timestamp now) {
+  if (!is_open())
+    return make_error(sec::runtime_error, "no open file");
+  entries_.clear();
+  registry.collect(*this);
+  auto same_instance = [](const entry& x, const entry& y) {
+    return x.family == y.family && x.instance == y.instance;
+  };
+  if (std::equal(entries_.begin(), entries_.end(), layout_.begin(),
+                 layout_.end(), same_instance))
+    write_values();
+  else if (auto err = write_layout())
+    return err;
+  auto hdr = reinterpret_cast<fmt::header*>(data_);
+  hdr->last_update.store(now.time_since_epoch().count(),
+                         std::memory_order_release);
+  return none;
+}
+
+// -- call operators for the metric registry -----------------------------------
+
+void shared_memory::operator()(const metric_family* family,
+                               const metric* instance,
+                               const dbl_counter* counter) {
+  entries_.emplace_back(
+    entry{family, instance, counter, metric_type::dbl_counter, 0});
+}
+
+void shared_memory::operator()(const metric_family* family,
+                               const metric* instance,
+                               const int_counter* counter) {
+  entries_.emplace_back(
+    entry{family, instance, counter, metric_type::int_counter, 0});
+}
+
+void shared_memory::operator()(const metric_family* family,
+                               const metric* instance, const dbl_gauge* gauge) {
+  entries_.emplace_back(
+    entry{family, instance, gauge, metric_type::dbl_gauge, 0});
+}
+
+void shared_memory::operator()(const metric_family* family,
+                               const metric* instance, const int_gauge* gauge) {
+  entries_.emplace_back(
+    entry{family, instance, gauge, metric_type::int_gauge, 0});
+}
+
+void shared_memory::operator()(const metric_family* family,
+                               const metric* instance,
+                               const dbl_histogram* val) {
+  entries_.emplace_back(entry{family, instance, val,
+                              metric_type::dbl_histogram,
+                              val->buckets().size()});
+}
+
+void shared_memory::operator()(const metric_family* family,
+                               const metric* instance,
+                               const int_histogram* val) {
+  entries_.emplace_back(entry{family, instance, val,
+                              metric_type::int_histogram,
+                              val->buckets().size()});
+}
+
+// -- implementation details ---------------------------------------------------
+
+namespace {
+
+template <class Histogram>
+void put_bounds(layout_builder& out, size_t offset, const void* impl) {
+  using limits = std::numeric_limits<double>;
+  auto buckets = static_cast<const Histogram*>(impl)->buckets();
+  for (size_t index = 0; index + 1 < buckets.size(); ++index)
+    out.put(offset + index * sizeof(double),
+            static_cast<double>(buckets[index].upper_bound));
+  // The last bucket always collects all remaining values.
+  out.put(offset + (buckets.size() - 1) * sizeof(double), limits::infinity());
+}
+
+} // namespace
+
+error shared_memory::write_layout() {
+  layout_builder out{sizeof(fmt::header)};
+  auto records_offset = out.allocate(entries_.size() * sizeof(fmt::record));
+  std::vector<fmt::record> records;
+  records.reserve(entries_.size());
+  for (auto& x : entries_) {
+    fmt::record rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.type = static_cast<uint8_t>(x.type);
+    rec.is_sum = x.family->is_sum() ? 1 : 0;
+    rec.prefix = out.add(x.family->prefix());
+    rec.name = out.add(x.family->name());
+    rec.unit = out.add(x.family->unit());
+    rec.helptext = out.add(x.family->helptext());
+    const auto& labels = x.instance->labels();
+    rec.num_labels = static_cast<uint32_t>(labels.size());
+    rec.labels_offset = out.allocate(2 * labels.size()
+                                     * sizeof(fmt::string_ref));
+    for (size_t index = 0; index < labels.size(); ++index) {
+      auto pos = rec.labels_offset + 2 * index * sizeof(fmt::string_ref);
+      out.put(pos, out.add(labels[index].name()));
+      out.put(pos + sizeof(fmt::string_ref), out.add(labels[index].value()));
+    }
+    rec.num_buckets = x.num_buckets;
+    if (x.num_buckets > 0) {
+      rec.bounds_offset = out.allocate(x.num_buckets * sizeof(double));
+      if (x.type == metric_type::dbl_histogram)
+        put_bounds<dbl_histogram>(out, rec.bounds_offset, x.impl);
+      else
+        put_bounds<int_histogram>(out, rec.bounds_offset, x.impl);
+    }
+    records.emplace_back(rec);
+  }
+  // Place the value blocks after all static content.
+  value_offsets_.clear();
+  for (size_t index = 0; index < entries_.size(); ++index) {
+    auto& rec = records[index];
+    auto num_values = rec.num_buckets > 0 ? rec.num_buckets + 1 : 1;
+    rec.values_offset = out.allocate(fmt::value_block_size(num_values));
+    value_offsets_.emplace_back(rec.values_offset);
+    out.put(records_offset + index * sizeof(fmt::record), rec);
+  }
+  if (auto err = reserve(out.size()))
+    return err;
+  // Copy the new layout while holding the seqlock for the static content.
+  auto hdr = reinterpret_cast<fmt::header*>(data_);
+  auto seq = hdr->layout_seq.load(std::memory_order_relaxed);
+  hdr->layout_seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(data_ + sizeof(fmt::header), out.data() + sizeof(fmt::header),
+         out.size() - sizeof(fmt::header));
+  hdr->file_size = out.size();
+  hdr->num_records = entries_.size();
+  hdr->records_offset = records_offset;
+  layout_ = entries_;
+  write_values();
+  hdr->layout_seq.store(seq + 2, std::memory_order_release);
+  return none;
+}
+
+namespace {
+
+class value_writer {
+public:
+  explicit value_writer(std::byte* block) noexcept
+    : words_(reinterpret_cast<std::atomic<uint64_t>*>(block)) {
+    seq_ = words_[0].load(std::memory_order_relaxed);
+    words_[0].store(seq_ + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  ~value_writer() {
+    words_[0].store(seq_ + 2, std::memory_order_release);
+  }
+
+  template <class T>
+  void put(size_t index, T value) noexcept {
+    words_[index + 1].store(to_word(value), std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t>* words_;
+  uint64_t seq_;
+};
+
+template <class Histogram>
+void put_histogram(value_writer& out, const void* impl) {
+  auto ptr = static_cast<const Histogram*>(impl);
+  auto buckets = ptr->buckets();
+  for (size_t index = 0; index < buckets.size(); ++index)
+    out.put(index, buckets[index].count.value());
+  out.put(buckets.size(), ptr->sum());
+}
+
+} // namespace
+
+void shared_memory::write_values() {
+  for (size_t index = 0; index < layout_.size(); ++index) {
+    auto& x = layout_[index];
+    value_writer out{data_ + value_offsets_[index]};
+    switch (x.type) {
+      case metric_type::dbl_counter:
+        out.put(0, static_cast<const dbl_counter*>(x.impl)->value());
+        break;
+      case metric_type::int_counter:
+        out.put(0, static_cast<const int_counter*>(x.impl)->value());
+        break;
+      case metric_type::dbl_gauge:
+        out.put(0, static_cast<const dbl_gauge*>(x.impl)->value());
+        break;
+      case metric_type::int_gauge:
+        out.put(0, static_cast<const int_gauge*>(x.impl)->value());
+        break;
+      case metric_type::dbl_histogram:
+        put_histogram<dbl_histogram>(out, x.impl);
+        break;
+      case metric_type::int_histogram:
+        put_histogram<int_histogram>(out, x.impl);
+        break;
+    }
+  }
+}
+
+} // namespace caf::telemetry::collector
@@ -63,6 +63,15 @@ metric_family* metric_registry::fetch(const string_view& prefix,
   return nullptr;
 }
 
+bool metric_registry::per_thread_storage(string_view prefix,
+                                         string_view name) const {
+  if (config_ != nullptr)
+    if (auto grp = get_if<settings>(config_, prefix))
+      if (auto sub_settings = get_if<settings>(grp, name))
+        return get_or(*sub_settings, "per-thread-storage", false);
+  return false;
+}
+
 std::vector<std::string>
 metric_registry::to_sorted_vec(span<const string_view> xs) {
   std::vector<std::string> result;
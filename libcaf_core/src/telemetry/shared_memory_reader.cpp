@@ -0,0 +1,304 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/telemetry/shared_memory_reader.hpp"
+
+#include <cstring>
+#include <thread>
+
+#include "caf/config.hpp"
+#include "caf/sec.hpp"
+#include "caf/telemetry/shared_memory_format.hpp"
+
+#ifdef CAF_POSIX
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace caf::telemetry {
+
+namespace fmt = shared_memory_format;
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+shared_memory_reader::~shared_memory_reader() {
+  close();
+}
+
+// -- file management ----------------------------------------------------------
+
+#ifdef CAF_POSIX
+
+error shared_memory_reader::open(const std::string& path) {
+  close();
+  fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ == -1)
+    return make_error(sec::cannot_open_file, path, strerror(errno));
+  struct stat st;
+  if (::fstat(fd_, &st) != 0) {
+    close();
+    return make_error(sec::cannot_open_file, path, strerror(errno));
+  }
+  path_ = path;
+  inode_ = static_cast<uint64_t>(st.st_ino);
+  if (auto err = remap(sizeof(fmt::header))) {
+    close();
+    return err;
+  }
+  auto hdr = reinterpret_cast<const fmt::header*>(data_);
+  if (hdr->magic != fmt::magic || hdr->version != fmt::version
+      || hdr->header_size < sizeof(fmt::header)) {
+    close();
+    return make_error(sec::runtime_error, "unsupported file format", path);
+  }
+  return none;
+}
+
+void shared_memory_reader::close() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<std::byte*>(data_), mapped_size_);
+    data_ = nullptr;
+    mapped_size_ = 0;
+  }
+  if (fd_ != -1) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  inode_ = 0;
+}
+
+error shared_memory_reader::remap(size_t size) {
+  struct stat st;
+  if (::fstat(fd_, &st) != 0)
+    return make_error(sec::runtime_error, "fstat failed", strerror(errno));
+  auto file_size = static_cast<size_t>(st.st_size);
+  if (file_size < size)
+    return make_error(sec::runtime_error, "file too small", path_);
+  auto ptr = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd_, 0);
+  if (ptr == MAP_FAILED)
+    return make_error(sec::runtime_error, "mmap failed", strerror(errno));
+  if (data_ != nullptr)
+    ::munmap(const_cast<std::byte*>(data_), mapped_size_);
+  data_ = static_cast<const std::byte*>(ptr);
+  mapped_size_ = file_size;
+  return none;
+}
+
+error shared_memory_reader::refresh() {
+  struct stat st;
+  if (::stat(path_.c_str(), &st) != 0)
+    return make_error(sec::cannot_open_file, path_, strerror(errno));
+  if (static_cast<uint64_t>(st.st_ino) == inode_)
+    return none;
+  auto path = path_;
+  return open(path);
+}
+
+#else // CAF_POSIX
+
+error shared_memory_reader::open(const std::string&) {
+  return make_error(sec::unsupported_operation,
+                    "shared memory export requires a POSIX system");
+}
+
+void shared_memory_reader::close() {
+  // nop
+}
+
+error shared_memory_reader::remap(size_t) {
+  return make_error(sec::unsupported_operation,
+                    "shared memory export requires a POSIX system");
+}
+
+error shared_memory_reader::refresh() {
+  return make_error(sec::unsupported_operation,
+                    "shared memory export requires a POSIX system");
+}
+
+#endif // CAF_POSIX
+
+// -- reading ------------------------------------------------------------------
+
+expected<shared_memory_reader::snapshot> shared_memory_reader::read() {
+  if (!is_open())
+    return make_error(sec::runtime_error, "no open file");
+  if (auto err = refresh())
+    return err;
+  snapshot result;
+  for (size_t attempt = 0; attempt < max_attempts; ++attempt) {
+    if (auto res = try_read(result); !res)
+      return std::move(res.error());
+    else if (*res)
+      return result;
+    std::this_thread::yield();
+  }
+  return make_error(sec::runtime_error,
+                    "failed to read a consistent snapshot");
+}
+
+namespace {
+
+// Copies data from the mapped file with bounds checking. Since the writer may
+// change the file while reading, any check may fail due to inconsistent data.
+class file_view {
+public:
+  file_view(const std::byte* data, size_t size) noexcept
+    : data_(data), size_(size) {
+    // nop
+  }
+
+  bool contains(uint64_t offset, uint64_t size) const noexcept {
+    return offset <= size_ && size <= size_ - offset;
+  }
+
+  template <class T>
+  bool read(uint64_t offset, T& dst) const noexcept {
+    if (!contains(offset, sizeof(T)))
+      return false;
+    memcpy(&dst, data_ + offset, sizeof(T));
+    return true;
+  }
+
+  bool read(const fmt::string_ref& ref, std::string& dst) const {
+    if (!contains(ref.offset, ref.size))
+      return false;
+    dst.assign(reinterpret_cast<const char*>(data_ + ref.offset), ref.size);
+    return true;
+  }
+
+  const std::atomic<uint64_t>* words(uint64_t offset,
+                                     uint64_t num_words) const noexcept {
+    if (offset % sizeof(uint64_t) != 0
+        || num_words > size_ / sizeof(uint64_t)
+        || !contains(offset, num_words * sizeof(uint64_t)))
+      return nullptr;
+    return reinterpret_cast<const std::atomic<uint64_t>*>(data_ + offset);
+  }
+
+private:
+  const std::byte* data_;
+  size_t size_;
+};
+
+int64_t to_int(uint64_t word) noexcept {
+  return static_cast<int64_t>(word);
+}
+
+double to_dbl(uint64_t word) noexcept {
+  double result;
+  memcpy(&result, &word, sizeof(result));
+  return result;
+}
+
+// Copies the values of a single value block or returns `false` if the writer
+// keeps changing the values.
+bool read_values(const std::atomic<uint64_t>* block, std::vector<uint64_t>& dst,
+                 size_t num_values) {
+  dst.resize(num_values);
+  for (size_t attempt = 0; attempt < shared_memory_reader::max_attempts;
+       ++attempt) {
+    auto seq = block[0].load(std::memory_order_acquire);
+    if (seq % 2 == 0) {
+      for (size_t index = 0; index < num_values; ++index)
+        dst[index] = block[index + 1].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (block[0].load(std::memory_order_relaxed) == seq)
+        return true;
+    }
+    std::this_thread::yield();
+  }
+  return false;
+}
+
+} // namespace
+
+expected<bool> shared_memory_reader::try_read(snapshot& result) {
+  auto hdr = reinterpret_cast<const fmt::header*>(data_);
+  auto seq = hdr->layout_seq.load(std::memory_order_acquire);
+  if (seq % 2 != 0)
+    return false;
+  auto file_size = hdr->file_size;
+  if (file_size > mapped_size_) {
+    if (auto err = remap(file_size))
+      return err;
+    return false;
+  }
+  // Returns `false` if the writer changed the layout in the meantime or an
+  // error if the file is corrupted.
+  auto fail = [hdr, seq]() -> expected<bool> {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (hdr->layout_seq.load(std::memory_order_relaxed) != seq)
+      return false;
+    return make_error(sec::runtime_error, "malformed file content");
+  };
+  file_view file{data_, file_size};
+  auto num_records = hdr->num_records;
+  auto records_offset = hdr->records_offset;
+  if (num_records > file_size / sizeof(fmt::record)
+      || !file.contains(records_offset, num_records * sizeof(fmt::record)))
+    return fail();
+  result.samples.clear();
+  result.samples.reserve(num_records);
+  std::vector<uint64_t> values;
+  for (uint64_t index = 0; index < num_records; ++index) {
+    fmt::record rec;
+    file.read(records_offset + index * sizeof(fmt::record), rec);
+    auto& x = result.samples.emplace_back();
+    if (rec.type > static_cast<uint8_t>(metric_type::int_histogram))
+      return fail();
+    x.type = static_cast<metric_type>(rec.type);
+    x.is_sum = rec.is_sum != 0;
+    if (!file.read(rec.prefix, x.prefix) || !file.read(rec.name, x.name)
+        || !file.read(rec.unit, x.unit)
+        || !file.read(rec.helptext, x.helptext))
+      return fail();
+    if (rec.num_labels > file_size / (2 * sizeof(fmt::string_ref)))
+      return fail();
+    for (uint64_t i = 0; i < rec.num_labels; ++i) {
+      fmt::string_ref name;
+      fmt::string_ref value;
+      auto pos = rec.labels_offset + 2 * i * sizeof(fmt::string_ref);
+      auto& lbl = x.labels.emplace_back();
+      if (!file.read(pos, name)
+          || !file.read(pos + sizeof(fmt::string_ref), value)
+          || !file.read(name, lbl.first) || !file.read(value, lbl.second))
+        return fail();
+    }
+    auto is_histogram = x.type == metric_type::dbl_histogram
+                        || x.type == metric_type::int_histogram;
+    if (is_histogram != (rec.num_buckets > 0)
+        || rec.num_buckets > file_size / sizeof(double))
+      return fail();
+    auto num_values = is_histogram ? rec.num_buckets + 1 : 1;
+    auto block = file.words(rec.values_offset, num_values + 1);
+    if (block == nullptr)
+      return fail();
+    if (!read_values(block, values, num_values))
+      return false;
+    auto is_dbl = x.type == metric_type::dbl_counter
+                  || x.type == metric_type::dbl_gauge
+                  || x.type == metric_type::dbl_histogram;
+    if (is_dbl)
+      x.dbl_value = to_dbl(values.back());
+    else
+      x.int_value = to_int(values.back());
+    for (uint64_t i = 0; i < rec.num_buckets; ++i) {
+      auto& bkt = x.buckets.emplace_back();
+      if (!file.read(rec.bounds_offset + i * sizeof(double), bkt.upper_bound))
+        return fail();
+      bkt.count = to_int(values[i]);
+    }
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (hdr->layout_seq.load(std::memory_order_relaxed) != seq)
+    return false;
+  auto ns = hdr->last_update.load(std::memory_order_acquire);
+  result.last_update = timestamp{timespan{ns}};
+  return true;
+}
+
+} // namespace caf::telemetry
@@ -8,6 +8,10 @@
 
 #include "core-test.hpp"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "caf/binary_deserializer.hpp"
 #include "caf/binary_serializer.hpp"
 
@@ -51,4 +55,43 @@ CAF_TEST(serialization roundtrips go through the registry) {
   anon_send_exit(hdl, exit_reason::user_shutdown);
 }
 
+CAF_TEST(threads may access the registry concurrently) {
+  auto& reg = sys.registry();
+  constexpr size_t num_actors = actor_registry::num_shards * 4;
+  constexpr size_t num_threads = 4;
+  std::vector<actor> hdls;
+  for (size_t i = 0; i < num_actors; ++i)
+    hdls.emplace_back(sys.spawn(dummy));
+  auto for_each_thread = [](auto f) {
+    std::vector<std::thread> threads;
+    for (size_t id = 0; id < num_threads; ++id)
+      threads.emplace_back(f, id);
+    for (auto& t : threads)
+      t.join();
+  };
+  MESSAGE("each thread registers its own slice of the actors");
+  for_each_thread([&](size_t id) {
+    for (size_t i = id; i < num_actors; i += num_threads)
+      reg.put(hdls[i].id(), hdls[i]);
+  });
+  MESSAGE("all threads look up all actors");
+  std::atomic<size_t> hits{0};
+  for_each_thread([&](size_t) {
+    for (auto& hdl : hdls)
+      if (reg.get<actor>(hdl.id()) == hdl)
+        ++hits;
+  });
+  CHECK_EQ(hits.load(), num_actors * num_threads);
+  MESSAGE("each thread erases its own slice of the actors");
+  for_each_thread([&](size_t id) {
+    for (size_t i = id; i < num_actors; i += num_threads)
+      reg.erase(hdls[i].id());
+  });
+  for (auto& hdl : hdls)
+    CHECK_EQ(reg.get(hdl.id()), nullptr);
+  for (auto& hdl : hdls)
+    anon_send_exit(hdl, exit_reason::user_shutdown);
+  run();
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
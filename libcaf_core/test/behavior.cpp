@@ -90,6 +90,35 @@ CAF_TEST(multiple_lambda_construct) {
   CAF_CHECK_EQUAL(res_of(f, m3), none);
 }
 
+CAF_TEST(large behaviors dispatch on the types of the message) {
+  behavior f{
+    [](int8_t) { return int32_t{1}; },
+    [](int16_t) { return int32_t{2}; },
+    [](int32_t x) { return x + 1; },
+    [](int64_t) { return int32_t{4}; },
+    [](uint8_t) { return int32_t{5}; },
+    [](uint16_t) { return int32_t{6}; },
+    [](uint32_t) { return int32_t{7}; },
+    [](uint64_t) { return int32_t{8}; },
+    [](float) { return int32_t{9}; },
+    [](double) { return int32_t{10}; },
+    [](int32_t x, int32_t y) { return x * y; },
+    [](int32_t) { return int32_t{-1}; },
+    [](const std::string& str) { return static_cast<int32_t>(str.size()); },
+  };
+  CAF_CHECK_EQUAL(res_of(f, m1), 2);
+  CAF_CHECK_EQUAL(res_of(f, m2), 2);
+  CAF_CHECK_EQUAL(res_of(f, m3), none);
+  auto m4 = make_message(int8_t{0});
+  CAF_CHECK_EQUAL(res_of(f, m4), 1);
+  auto m5 = make_message(uint64_t{0});
+  CAF_CHECK_EQUAL(res_of(f, m5), 8);
+  auto m6 = make_message(std::string{"hello"});
+  CAF_CHECK_EQUAL(res_of(f, m6), 5);
+  message m7;
+  CAF_CHECK_EQUAL(f(m7), none);
+}
+
 CAF_TEST(become_empty_behavior) {
   actor_system_config cfg{};
   actor_system sys{cfg};
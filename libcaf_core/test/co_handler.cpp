@@ -0,0 +1,160 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE co_handler
+
+#include "caf/co_handler.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/event_based_actor.hpp"
+
+using namespace caf;
+
+using namespace std::chrono_literals;
+using namespace std::string_literals;
+
+namespace {
+
+using adder_actor = typed_actor<result<int32_t>(int32_t, int32_t),
+                                result<int32_t>(std::string)>;
+
+adder_actor::behavior_type adder() {
+  return {
+    [](int32_t x, int32_t y) { return x + y; },
+    [](const std::string&) -> result<int32_t> { return sec::runtime_error; },
+  };
+}
+
+// Holds on to its response promises in order to never respond. Tests must
+// terminate the sink explicitly to have it drop its promises.
+behavior sink(event_based_actor* self) {
+  auto promises = std::make_shared<std::vector<response_promise>>();
+  return {
+    [self, promises](int32_t) {
+      promises->emplace_back(self->make_response_promise());
+    },
+  };
+}
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(co_handler_tests, test_coordinator_fixture<>)
+
+CAF_TEST(handlers resume when receiving the response) {
+  std::vector<int32_t> results;
+  auto server = sys.spawn(adder);
+  auto client = sys.spawn([&](event_based_actor* self) -> behavior {
+    return {
+      [=, &results](int32_t x) -> co_handler {
+        auto res1 = co_await self->request(server, infinite, x, x);
+        if (!res1) {
+          CAF_FAIL("unexpected error: " << res1.error());
+          co_return;
+        }
+        results.push_back(*res1);
+        auto res2 = co_await self->request(server, infinite, *res1, 1);
+        if (res2)
+          results.push_back(*res2);
+      },
+    };
+  });
+  run();
+  inject((int32_t), to(client).with(int32_t{2}));
+  expect((int32_t, int32_t), from(client).to(server).with(2, 2));
+  expect((int32_t), from(server).to(client).with(4));
+  expect((int32_t, int32_t), from(client).to(server).with(4, 1));
+  expect((int32_t), from(server).to(client).with(5));
+  CHECK_EQ(results, std::vector<int32_t>({4, 5}));
+}
+
+CAF_TEST(actors process other messages while a handler is suspended) {
+  std::vector<std::string> log;
+  auto server = sys.spawn(adder);
+  auto client = sys.spawn([&](event_based_actor* self) -> behavior {
+    return {
+      [=, &log](int32_t x) -> co_handler {
+        log.emplace_back("begin");
+        // Dynamically typed requests produce the response message as-is.
+        auto hdl = actor_cast<actor>(server);
+        auto res = co_await self->request(hdl, infinite, x, x);
+        if (res && res->match_elements<int32_t>())
+          log.emplace_back(std::to_string(res->get_as<int32_t>(0)));
+        else
+          log.emplace_back("unexpected response");
+      },
+      [&log](const std::string& str) { log.emplace_back(str); },
+    };
+  });
+  run();
+  inject((int32_t), to(client).with(int32_t{3}));
+  inject((std::string), to(client).with("other"s));
+  expect((int32_t, int32_t), from(client).to(server).with(3, 3));
+  expect((int32_t), from(server).to(client).with(6));
+  CHECK_EQ(log, std::vector<std::string>({"begin", "other", "6"}));
+}
+
+CAF_TEST(co_await returns errors and timeouts) {
+  std::vector<error> errors;
+  auto server = sys.spawn(adder);
+  auto dummy = sys.spawn(sink);
+  auto client = sys.spawn([&](event_based_actor* self) -> behavior {
+    return {
+      [=, &errors](const std::string& str) -> co_handler {
+        auto res = co_await self->request(server, infinite, str);
+        errors.push_back(res.error());
+      },
+      [=, &errors](int32_t x) -> co_handler {
+        auto res = co_await self->request(dummy, 1s, x);
+        errors.push_back(res.error());
+      },
+    };
+  });
+  run();
+  inject((std::string), to(client).with("foo"s));
+  expect((std::string), from(client).to(server).with("foo"s));
+  expect((error), from(server).to(client).with(sec::runtime_error));
+  CHECK_EQ(errors, std::vector<error>({sec::runtime_error}));
+  inject((int32_t), to(client).with(int32_t{1}));
+  expect((int32_t), from(client).to(dummy).with(1));
+  CHECK(sched.trigger_timeout());
+  expect((error), from(client).to(client).with(sec::request_timeout));
+  CHECK_EQ(errors,
+           std::vector<error>({sec::runtime_error, sec::request_timeout}));
+  anon_send_exit(dummy, exit_reason::kill);
+  run();
+}
+
+CAF_TEST(terminating actors destroy suspended handlers) {
+  struct tracker {
+    explicit tracker(bool* flag) : flag(flag) {
+      // nop
+    }
+    ~tracker() {
+      *flag = true;
+    }
+    bool* flag;
+  };
+  auto destroyed = false;
+  auto dummy = sys.spawn(sink);
+  auto client = sys.spawn([&](event_based_actor* self) -> behavior {
+    return {
+      [=, &destroyed](int32_t x) -> co_handler {
+        tracker guard{&destroyed};
+        co_await self->request(dummy, infinite, x);
+        CAF_FAIL("handler resumed after the actor terminated");
+      },
+    };
+  });
+  run();
+  inject((int32_t), to(client).with(int32_t{1}));
+  CHECK(!destroyed);
+  anon_send_exit(client, exit_reason::kill);
+  run();
+  CHECK(destroyed);
+  anon_send_exit(dummy, exit_reason::kill);
+  run();
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
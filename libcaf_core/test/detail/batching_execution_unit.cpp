@@ -0,0 +1,122 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.batching_execution_unit
+
+#include "caf/detail/batching_execution_unit.hpp"
+
+#include "core-test.hpp"
+
+#include <condition_variable>
+#include <mutex>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/ref_counted.hpp"
+#include "caf/resumable.hpp"
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+using namespace caf;
+
+namespace {
+
+// Counts how often the scheduler resumes jobs of this type.
+struct counter {
+  void inc() {
+    std::unique_lock<std::mutex> guard{mtx};
+    ++value;
+    cv.notify_all();
+  }
+
+  void await(size_t expected) {
+    std::unique_lock<std::mutex> guard{mtx};
+    cv.wait(guard, [&] { return value == expected; });
+  }
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t value = 0;
+};
+
+class job : public resumable, public ref_counted {
+public:
+  explicit job(counter& count) : count_(count) {
+    // nop
+  }
+
+  resume_result resume(execution_unit*, size_t) override {
+    count_.inc();
+    return resumable::done;
+  }
+
+  void intrusive_ptr_add_ref_impl() override {
+    intrusive_ptr_add_ref(this);
+  }
+
+  void intrusive_ptr_release_impl() override {
+    intrusive_ptr_release(this);
+  }
+
+private:
+  counter& count_;
+};
+
+struct config : actor_system_config {
+  explicit config(const char* policy) {
+    set("caf.scheduler.policy", policy);
+    set("caf.scheduler.max-threads", 3);
+  }
+};
+
+// Submits `n` jobs via a batching execution unit and waits for them to run.
+void run_jobs(actor_system& sys, size_t n) {
+  counter count;
+  std::vector<intrusive_ptr<job>> jobs;
+  for (size_t i = 0; i < n; ++i)
+    jobs.emplace_back(make_counted<job>(count));
+  { // lifetime scope of batch
+    detail::batching_execution_unit batch{&sys};
+    for (auto& ptr : jobs) {
+      // the scheduler releases one reference after running the job
+      ptr->ref();
+      batch.exec_later(ptr.get());
+    }
+    CHECK_EQ(batch.pending(), n);
+    batch.flush();
+    CHECK_EQ(batch.pending(), 0u);
+  }
+  count.await(n);
+  CHECK_EQ(count.value, n);
+}
+
+} // namespace
+
+CAF_TEST(work stealing runs all jobs submitted in bulk) {
+  config cfg{"stealing"};
+  actor_system sys{cfg};
+  run_jobs(sys, 1);
+  run_jobs(sys, 2);
+  run_jobs(sys, 100);
+}
+
+CAF_TEST(work sharing runs all jobs submitted in bulk) {
+  config cfg{"sharing"};
+  actor_system sys{cfg};
+  run_jobs(sys, 1);
+  run_jobs(sys, 100);
+}
+
+CAF_TEST(batching execution units flush pending jobs on destruction) {
+  config cfg{"stealing"};
+  actor_system sys{cfg};
+  counter count;
+  auto ptr = make_counted<job>(count);
+  { // lifetime scope of batch
+    detail::batching_execution_unit batch{&sys};
+    ptr->ref();
+    batch.exec_later(ptr.get());
+  }
+  count.await(1);
+  CHECK_EQ(count.value, 1u);
+}
@@ -0,0 +1,109 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.chase_lev_deque
+
+#include "caf/detail/chase_lev_deque.hpp"
+
+#include "core-test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using int_deque = detail::chase_lev_deque<int>;
+
+struct fixture {
+  fixture() : xs(4) {
+    for (int i = 0; i < 1000; ++i)
+      values.push_back(i);
+  }
+
+  std::vector<int> values;
+  int_deque xs;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(chase_lev_deque_tests, fixture)
+
+CAF_TEST(a default constructed deque is empty) {
+  CHECK(xs.empty());
+  CHECK_EQ(xs.pop_back(), nullptr);
+  CHECK_EQ(xs.steal(), nullptr);
+  CHECK_EQ(xs.capacity(), 4u);
+}
+
+CAF_TEST(the owner pops elements in LIFO order) {
+  for (int i = 0; i < 3; ++i)
+    xs.push_back(&values[i]);
+  CHECK(!xs.empty());
+  CHECK_EQ(xs.pop_back(), &values[2]);
+  CHECK_EQ(xs.pop_back(), &values[1]);
+  CHECK_EQ(xs.pop_back(), &values[0]);
+  CHECK_EQ(xs.pop_back(), nullptr);
+  CHECK(xs.empty());
+}
+
+CAF_TEST(thieves steal elements in FIFO order) {
+  for (int i = 0; i < 3; ++i)
+    xs.push_back(&values[i]);
+  CHECK_EQ(xs.steal(), &values[0]);
+  CHECK_EQ(xs.steal(), &values[1]);
+  CHECK_EQ(xs.pop_back(), &values[2]);
+  CHECK_EQ(xs.steal(), nullptr);
+  CHECK(xs.empty());
+}
+
+CAF_TEST(the deque grows when running full) {
+  for (int i = 0; i < 10; ++i)
+    xs.push_back(&values[i]);
+  CHECK_EQ(xs.capacity(), 16u);
+  CHECK_EQ(xs.steal(), &values[0]);
+  for (int i = 9; i > 0; --i)
+    CHECK_EQ(xs.pop_back(), &values[i]);
+  CHECK(xs.empty());
+  MESSAGE("the deque re-uses its storage after draining it");
+  for (int i = 0; i < 16; ++i)
+    xs.push_back(&values[i]);
+  CHECK_EQ(xs.capacity(), 16u);
+}
+
+CAF_TEST(concurrent thieves and owner process each element exactly once) {
+  std::atomic<bool> done{false};
+  std::vector<std::vector<int>> stolen(3);
+  std::vector<std::thread> thieves;
+  for (auto& buf : stolen)
+    thieves.emplace_back([&, ptr = &buf] {
+      for (;;) {
+        if (auto x = xs.steal())
+          ptr->push_back(*x);
+        else if (done.load())
+          return;
+      }
+    });
+  std::vector<int> popped;
+  for (int i = 0; i < 1000; ++i) {
+    xs.push_back(&values[i]);
+    if (i % 3 == 0)
+      if (auto x = xs.pop_back())
+        popped.push_back(*x);
+  }
+  while (auto x = xs.pop_back())
+    popped.push_back(*x);
+  done = true;
+  for (auto& t : thieves)
+    t.join();
+  for (auto& buf : stolen)
+    popped.insert(popped.end(), buf.begin(), buf.end());
+  std::sort(popped.begin(), popped.end());
+  CHECK_EQ(popped, values);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,56 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.config_snapshot
+
+#include "caf/detail/config_snapshot.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/actor_system_config.hpp"
+
+using namespace caf;
+
+using namespace std::literals::chrono_literals;
+
+using credit_policy = detail::config_snapshot::credit_policy;
+
+CAF_TEST(snapshots of an empty configuration contain the default values) {
+  actor_system_config cfg;
+  detail::config_snapshot uut{cfg};
+  CHECK_EQ(uut.stream_max_batch_delay, defaults::stream::max_batch_delay);
+  CHECK(uut.stream_credit_policy == credit_policy::size_based);
+  CHECK_EQ(uut.size_policy.bytes_per_batch,
+           defaults::stream::size_policy::bytes_per_batch);
+  CHECK_EQ(uut.size_policy.sampling_rate,
+           defaults::stream::size_policy::sampling_rate);
+  CHECK_EQ(uut.token_policy.batch_size,
+           defaults::stream::token_policy::batch_size);
+}
+
+CAF_TEST(snapshots contain the values from the configuration) {
+  actor_system_config cfg;
+  cfg.set("caf.stream.max-batch-delay", timespan{5ms});
+  cfg.set("caf.stream.credit-policy", "token-based");
+  cfg.set("caf.stream.size-based-policy.bytes-per-batch", 128);
+  cfg.set("caf.stream.size-based-policy.sampling-rate", 7);
+  cfg.set("caf.stream.token-based-policy.batch-size", 42);
+  cfg.set("caf.stream.token-based-policy.buffer-size", 84);
+  detail::config_snapshot uut{cfg};
+  CHECK_EQ(uut.stream_max_batch_delay, timespan{5ms});
+  CHECK(uut.stream_credit_policy == credit_policy::token_based);
+  CHECK_EQ(uut.size_policy.bytes_per_batch, 128);
+  CHECK_EQ(uut.size_policy.sampling_rate, 7);
+  CHECK_EQ(uut.size_policy.buffer_capacity,
+           defaults::stream::size_policy::buffer_capacity);
+  CHECK_EQ(uut.token_policy.batch_size, 42);
+  CHECK_EQ(uut.token_policy.buffer_size, 84);
+}
+
+CAF_TEST(unknown credit policies fall back to the size-based policy) {
+  actor_system_config cfg;
+  cfg.set("caf.stream.credit-policy", "foo");
+  detail::config_snapshot uut{cfg};
+  CHECK(uut.stream_credit_policy == credit_policy::size_based);
+}
@@ -0,0 +1,160 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.cpu_topology
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "core-test.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+#ifdef CAF_LINUX
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif // CAF_LINUX
+
+using namespace caf;
+
+using detail::cpu_topology;
+
+using ivec = std::vector<int>;
+
+namespace {
+
+#ifdef CAF_LINUX
+
+// Creates a fake sysfs tree in a temporary directory.
+struct sysfs_tree {
+  sysfs_tree() {
+    char tmpl[] = "/tmp/caf-sysfs-XXXXXX";
+    if (auto res = mkdtemp(tmpl))
+      root = res;
+  }
+
+  ~sysfs_tree() {
+    for (auto i = created.rbegin(); i != created.rend(); ++i)
+      remove(i->c_str());
+    if (!root.empty())
+      rmdir(root.c_str());
+  }
+
+  void add_file(const std::string& path, const std::string& content) {
+    std::string dir = root;
+    size_t pos = 0;
+    while ((pos = path.find('/', pos)) != std::string::npos) {
+      dir = root + "/" + path.substr(0, pos++);
+      if (mkdir(dir.c_str(), 0700) == 0)
+        created.emplace_back(dir);
+    }
+    auto fname = root + "/" + path;
+    std::ofstream out{fname};
+    out << content << '\n';
+    created.emplace_back(fname);
+  }
+
+  // Adds a CPU with an L2 cache for each core pair and one L3 per package.
+  void add_cpu(int id, int package, int node, const std::string& l2,
+               const std::string& l3) {
+    auto cpu = "cpu" + std::to_string(id);
+    add_file(cpu + "/topology/physical_package_id", std::to_string(package));
+    add_file(cpu + "/node" + std::to_string(node) + "/dummy", "");
+    add_file(cpu + "/cache/index0/level", "1");
+    add_file(cpu + "/cache/index0/shared_cpu_list", std::to_string(id));
+    add_file(cpu + "/cache/index1/level", "2");
+    add_file(cpu + "/cache/index1/shared_cpu_list", l2);
+    add_file(cpu + "/cache/index2/level", "3");
+    add_file(cpu + "/cache/index2/shared_cpu_list", l3);
+  }
+
+  std::string root;
+  std::vector<std::string> created;
+};
+
+#endif // CAF_LINUX
+
+} // namespace
+
+CAF_TEST(CPU lists use the sysfs format) {
+  CHECK_EQ(cpu_topology::parse_cpu_list("0"), ivec({0}));
+  CHECK_EQ(cpu_topology::parse_cpu_list("0-3"), ivec({0, 1, 2, 3}));
+  CHECK_EQ(cpu_topology::parse_cpu_list("8,0-1,4"), ivec({0, 1, 4, 8}));
+  CHECK_EQ(cpu_topology::parse_cpu_list(""), ivec());
+  CHECK_EQ(cpu_topology::parse_cpu_list("3-1"), ivec());
+  CHECK_EQ(cpu_topology::parse_cpu_list("1,,2"), ivec());
+  CHECK_EQ(cpu_topology::parse_cpu_list("a-b"), ivec());
+}
+
+CAF_TEST(topologies sort CPUs by their location) {
+  cpu_topology uut{{
+    {0, 0, 0, 0, 0},
+    {1, 1, 1, 1, 1},
+    {2, 0, 0, 0, 0},
+    {3, 1, 1, 1, 1},
+  }};
+  auto& cpus = uut.cpus();
+  ivec ids;
+  for (auto& cpu : cpus)
+    ids.emplace_back(cpu.id);
+  CHECK_EQ(ids, ivec({0, 2, 1, 3}));
+  CHECK_EQ(uut.cpu_for_worker(1).id, 2);
+  CHECK_EQ(uut.cpu_for_worker(5).id, 2);
+}
+
+CAF_TEST(the distance between CPUs depends on caches and NUMA nodes) {
+  using locality = cpu_topology::locality;
+  cpu_topology::cpu_info cpu0{0, 0, 0, 0, 0};
+  cpu_topology::cpu_info cpu1{1, 0, 0, 0, 0};
+  cpu_topology::cpu_info cpu2{2, 0, 0, 2, 0};
+  cpu_topology::cpu_info cpu3{3, 0, 0, 3, 3};
+  cpu_topology::cpu_info cpu4{4, 1, 1, 4, 4};
+  CHECK_EQ(cpu_topology::distance(cpu0, cpu1), locality::l2);
+  CHECK_EQ(cpu_topology::distance(cpu0, cpu2), locality::llc);
+  CHECK_EQ(cpu_topology::distance(cpu0, cpu3), locality::numa);
+  CHECK_EQ(cpu_topology::distance(cpu0, cpu4), locality::remote);
+}
+
+#ifdef CAF_LINUX
+
+CAF_TEST(topologies read the CPU information from the sysfs) {
+  sysfs_tree tree;
+  REQUIRE(!tree.root.empty());
+  tree.add_file("online", "0-7");
+  // Package 0 has the even CPUs, package 1 the odd ones. Each core pair
+  // shares an L2 cache and each package shares an L3 cache.
+  tree.add_cpu(0, 0, 0, "0,2", "0,2,4,6");
+  tree.add_cpu(1, 1, 1, "1,3", "1,3,5,7");
+  tree.add_cpu(2, 0, 0, "0,2", "0,2,4,6");
+  tree.add_cpu(3, 1, 1, "1,3", "1,3,5,7");
+  tree.add_cpu(4, 0, 0, "4,6", "0,2,4,6");
+  tree.add_cpu(5, 1, 1, "5,7", "1,3,5,7");
+  tree.add_cpu(6, 0, 0, "4,6", "0,2,4,6");
+  tree.add_cpu(7, 1, 1, "5,7", "1,3,5,7");
+  auto uut = cpu_topology::read(tree.root);
+  REQUIRE_EQ(uut.cpus().size(), 8u);
+  auto& cpus = uut.cpus();
+  ivec ids;
+  for (auto& cpu : cpus)
+    ids.emplace_back(cpu.id);
+  CHECK_EQ(ids, ivec({0, 2, 4, 6, 1, 3, 5, 7}));
+  CHECK_EQ(cpus[1].l2_group, 0);
+  CHECK_EQ(cpus[1].llc_group, 0);
+  CHECK_EQ(cpus[2].l2_group, 4);
+  CHECK_EQ(cpus[2].llc_group, 0);
+  CHECK_EQ(cpus[4].numa_node, 1);
+  CHECK_EQ(cpus[4].package, 1);
+  CHECK_EQ(cpus[7].l2_group, 5);
+  CHECK_EQ(cpus[7].llc_group, 1);
+  using locality = cpu_topology::locality;
+  CHECK_EQ(cpu_topology::distance(cpus[0], cpus[1]), locality::l2);
+  CHECK_EQ(cpu_topology::distance(cpus[0], cpus[2]), locality::llc);
+  CHECK_EQ(cpu_topology::distance(cpus[0], cpus[4]), locality::remote);
+}
+
+CAF_TEST(reading the topology from an invalid path returns an empty result) {
+  CHECK(cpu_topology::read("/does/not/exist").empty());
+}
+
+#endif // CAF_LINUX
@@ -0,0 +1,97 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.memory_pool
+
+#include "caf/detail/memory_pool.hpp"
+
+#include "core-test.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using pool = detail::memory_pool;
+
+CAF_TEST(size classes double the block size) {
+  CHECK_EQ(pool::size_class(0), 0u);
+  CHECK_EQ(pool::size_class(48), 0u);
+  CHECK_EQ(pool::size_class(49), 1u);
+  CHECK_EQ(pool::size_class(112), 1u);
+  CHECK_EQ(pool::size_class(113), 2u);
+  CHECK_EQ(pool::size_class(pool::max_block_size - pool::header_size),
+           pool::num_size_classes - 1);
+  CHECK_EQ(pool::size_class(pool::max_block_size), pool::num_size_classes);
+}
+
+CAF_TEST(allocated blocks are aligned and writable) {
+  std::vector<void*> blocks;
+  for (size_t size = 1; size <= 4096; size *= 2) {
+    auto ptr = pool::allocate(size);
+    REQUIRE(ptr != nullptr);
+    CHECK_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t), 0u);
+    memset(ptr, 0xFF, size);
+    blocks.push_back(ptr);
+  }
+  for (auto ptr : blocks)
+    pool::deallocate(ptr);
+}
+
+CAF_TEST(the pool reuses released blocks) {
+  auto before = pool::stats();
+  auto ptr1 = pool::allocate(32);
+  pool::deallocate(ptr1);
+  auto ptr2 = pool::allocate(32);
+  CHECK_EQ(ptr1, ptr2);
+  pool::deallocate(ptr2);
+  auto after = pool::stats();
+  CHECK_EQ(after.allocations - before.allocations, 2u);
+  CHECK_EQ(after.deallocations - before.deallocations, 2u);
+  CHECK_EQ(after.remote_deallocations, before.remote_deallocations);
+}
+
+CAF_TEST(large allocations bypass the pool) {
+  auto before = pool::stats();
+  auto ptr = pool::allocate(pool::max_block_size);
+  REQUIRE(ptr != nullptr);
+  memset(ptr, 0xFF, pool::max_block_size);
+  pool::deallocate(ptr);
+  auto after = pool::stats();
+  CHECK_EQ(after.fallback_allocations - before.fallback_allocations, 1u);
+  CHECK_EQ(after.allocations, before.allocations);
+}
+
+CAF_TEST(blocks return to their owner when released by another thread) {
+  auto before = pool::stats();
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < 10; ++i)
+    blocks.push_back(pool::allocate(100));
+  std::thread releaser{[&blocks] {
+    for (auto ptr : blocks)
+      pool::deallocate(ptr);
+  }};
+  releaser.join();
+  auto after = pool::stats();
+  CHECK_EQ(after.remote_deallocations - before.remote_deallocations, 10u);
+  CHECK_EQ(after.deallocations - before.deallocations, 10u);
+  // Once the local free list runs empty, the owner picks up remote blocks.
+  std::vector<void*> reused;
+  auto is_reused = [&](void* ptr) {
+    return std::find(blocks.begin(), blocks.end(), ptr) != blocks.end();
+  };
+  size_t num_reused = 0;
+  auto reserved = pool::stats().reserved_bytes;
+  while (num_reused < 10 && pool::stats().reserved_bytes == reserved) {
+    auto ptr = pool::allocate(100);
+    if (is_reused(ptr))
+      ++num_reused;
+    reused.push_back(ptr);
+  }
+  CHECK_EQ(num_reused, 10u);
+  for (auto ptr : reused)
+    pool::deallocate(ptr);
+}
@@ -0,0 +1,116 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.metric_index
+
+#include "caf/detail/metric_index.hpp"
+
+#include "core-test.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "caf/telemetry/label.hpp"
+#include "caf/telemetry/label_view.hpp"
+#include "caf/telemetry/metric.hpp"
+
+using namespace caf;
+using namespace caf::telemetry;
+
+namespace {
+
+struct fixture {
+  // Creates one instance per combination of the label values and adds it to
+  // the index.
+  void fill(size_t num_methods, size_t num_paths) {
+    for (size_t i = 0; i < num_methods; ++i) {
+      for (size_t j = 0; j < num_paths; ++j) {
+        std::vector<label> labels{{"method", "m" + std::to_string(i)},
+                                  {"path", "/p" + std::to_string(j)}};
+        auto hash = detail::metric_index::hash_of(labels);
+        instances.emplace_back(std::make_unique<metric>(std::move(labels)));
+        uut.insert(hash, instances.back().get());
+      }
+    }
+  }
+
+  metric* find(std::vector<label_view> labels) const {
+    return uut.find(detail::metric_index::hash_of(labels), labels);
+  }
+
+  std::vector<std::unique_ptr<metric>> instances;
+  detail::metric_index uut;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(metric_index_tests, fixture)
+
+CAF_TEST(hash values do not depend on the order of labels) {
+  std::vector<label_view> xs{{"a", "1"}, {"b", "2"}, {"c", "3"}};
+  std::vector<label_view> ys{{"c", "3"}, {"a", "1"}, {"b", "2"}};
+  std::vector<label> zs{{"b", "2"}, {"c", "3"}, {"a", "1"}};
+  using detail::metric_index;
+  CHECK_EQ(metric_index::hash_of(xs), metric_index::hash_of(ys));
+  CHECK_EQ(metric_index::hash_of(xs), metric_index::hash_of(zs));
+  std::vector<label_view> other{{"a", "2"}, {"b", "1"}, {"c", "3"}};
+  CHECK_NE(metric_index::hash_of(xs), metric_index::hash_of(other));
+}
+
+CAF_TEST(empty indexes contain no instances) {
+  CHECK(find({}) == nullptr);
+  CHECK(find({{"method", "get"}}) == nullptr);
+}
+
+CAF_TEST(indexes find instances for many label combinations) {
+  fill(50, 40);
+  for (size_t i = 0; i < 50; ++i) {
+    for (size_t j = 0; j < 40; ++j) {
+      auto method = "m" + std::to_string(i);
+      auto path = "/p" + std::to_string(j);
+      auto ptr = find({{"method", method}, {"path", path}});
+      CHECK(ptr == instances[i * 40 + j].get());
+      CHECK(find({{"path", path}, {"method", method}}) == ptr);
+    }
+  }
+  MESSAGE("lookups require an exact match of all labels");
+  CHECK(find({{"method", "m1"}}) == nullptr);
+  CHECK(find({{"method", "m1"}, {"path", "/p1"}, {"code", "200"}}) == nullptr);
+  CHECK(find({{"method", "m1"}, {"path", "/p50"}}) == nullptr);
+  CHECK(find({{"method", "/p1"}, {"path", "m1"}}) == nullptr);
+}
+
+CAF_TEST(readers may find instances while the index grows) {
+  std::vector<std::unique_ptr<metric>> more_instances;
+  fill(1, 1);
+  std::atomic<bool> done{false};
+  std::atomic<size_t> failures{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([this, &done, &failures] {
+      while (!done.load()) {
+        if (find({{"method", "m0"}, {"path", "/p0"}}) != instances[0].get())
+          ++failures;
+      }
+    });
+  }
+  for (size_t i = 0; i < 1000; ++i) {
+    std::vector<label> labels{{"method", "x"},
+                              {"path", "/q" + std::to_string(i)}};
+    auto hash = detail::metric_index::hash_of(labels);
+    more_instances.emplace_back(std::make_unique<metric>(std::move(labels)));
+    uut.insert(hash, more_instances.back().get());
+  }
+  done = true;
+  for (auto& reader : readers)
+    reader.join();
+  CHECK_EQ(failures.load(), 0u);
+  CHECK(find({{"method", "x"}, {"path", "/q999"}})
+        == more_instances.back().get());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
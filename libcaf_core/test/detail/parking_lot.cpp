@@ -0,0 +1,62 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.parking_lot
+
+#include "caf/detail/parking_lot.hpp"
+
+#include "core-test.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+struct fixture {
+  fixture() : lot(70) {
+    // nop
+  }
+
+  detail::parking_lot lot;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(parking_lot_tests, fixture)
+
+CAF_TEST(unparking an active worker is a no-op) {
+  CHECK_EQ(lot.size(), 70u);
+  CHECK(!lot.has_parked());
+  CHECK(!lot.unpark(0));
+  CHECK(!lot.unpark(69));
+  CHECK(!lot.unpark_any());
+}
+
+CAF_TEST(workers with pending work return immediately) {
+  CHECK(lot.park(3, timespan{10s}, [] { return true; }));
+  CHECK(!lot.has_parked());
+}
+
+CAF_TEST(parked workers return after a timeout) {
+  CHECK(!lot.park(3, timespan{1ms}, [] { return false; }));
+  CHECK(!lot.has_parked());
+}
+
+CAF_TEST(unpark wakes up parked workers) {
+  std::atomic<bool> woken{false};
+  std::thread worker{[&] {
+    woken = lot.park(65, timespan{10s}, [] { return false; });
+  }};
+  while (!lot.has_parked())
+    std::this_thread::yield();
+  CHECK(lot.unpark_any());
+  worker.join();
+  CHECK(woken);
+  CHECK(!lot.has_parked());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,127 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.response_slot_table
+
+#include "caf/detail/response_slot_table.hpp"
+
+#include "core-test.hpp"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "caf/make_counted.hpp"
+
+using namespace caf;
+
+using detail::response_continuation;
+
+namespace {
+
+struct fixture {
+  fixture() {
+    for (uint64_t i = 1; i <= 100; ++i)
+      ids.emplace_back(make_message_id(i).response_id());
+  }
+
+  response_continuation make_continuation(int32_t* result) {
+    return {[result](int32_t x) { *result = x; },
+            [result](error&) { *result = -1; }};
+  }
+
+  detail::response_slot_table uut;
+  std::vector<message_id> ids;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(response_slot_table_tests, fixture)
+
+CAF_TEST(continuations store small callbacks inline) {
+  int32_t result = 0;
+  auto f = make_continuation(&result);
+  CHECK(f.is_inline());
+  auto msg = make_message(int32_t{42});
+  CHECK(f(msg));
+  CHECK_EQ(result, 42);
+  auto err = make_message(make_error(sec::request_timeout));
+  CHECK(f(err));
+  CHECK_EQ(result, -1);
+  auto other = make_message(std::string{"foo"});
+  CHECK(!f(other));
+  std::array<char, 128> large{};
+  response_continuation g{[large](int32_t) mutable { large[0] = 1; },
+                          [](error&) {}};
+  CHECK(!g.is_inline());
+  CHECK(g(msg));
+  auto h = std::move(g);
+  CHECK(!g);
+  CHECK(h);
+}
+
+CAF_TEST(the table finds continuations by response ID) {
+  std::vector<int32_t> results(ids.size());
+  for (size_t i = 0; i < ids.size(); ++i)
+    uut.set_continuation(ids[i], make_continuation(&results[i]));
+  CHECK_EQ(uut.size(), 100u);
+  CHECK_EQ(uut.continuations(), 100u);
+  // Take the continuations in random order to exercise erasing slots in the
+  // middle of a probe sequence.
+  std::vector<size_t> order(ids.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::shuffle(order.begin(), order.end(), std::minstd_rand{42});
+  for (auto i : order) {
+    auto f = uut.take_continuation(ids[i]);
+    if (CHECK(f)) {
+      auto msg = make_message(static_cast<int32_t>(i));
+      f(msg);
+    }
+    CHECK(!uut.take_continuation(ids[i]));
+  }
+  CHECK(uut.empty());
+  CHECK_EQ(uut.continuations(), 0u);
+  for (size_t i = 0; i < results.size(); ++i)
+    CHECK_EQ(results[i], static_cast<int32_t>(i));
+}
+
+CAF_TEST(the table recycles its slots) {
+  int32_t result = 0;
+  uut.set_continuation(ids[0], make_continuation(&result));
+  auto capacity = uut.capacity();
+  for (uint64_t i = 1'000; i < 11'000; ++i) {
+    auto id = make_message_id(i).response_id();
+    uut.set_token(id, make_counted<detail::timeout_token>());
+    uut.set_continuation(id, make_continuation(&result));
+    CHECK(uut.take_continuation(id));
+  }
+  CHECK_EQ(uut.size(), 1u);
+  CHECK_EQ(uut.capacity(), capacity);
+}
+
+CAF_TEST(the table disposes tokens when taking continuations or clearing) {
+  int32_t result = 0;
+  auto t1 = make_counted<detail::timeout_token>();
+  auto t2 = make_counted<detail::timeout_token>();
+  auto t3 = make_counted<detail::timeout_token>();
+  uut.set_token(ids[0], t1);
+  uut.set_token(ids[1], t2);
+  uut.set_token(ids[2], t3);
+  uut.set_continuation(ids[1], make_continuation(&result));
+  uut.dispose_token(ids[0]);
+  CHECK(t1->disposed());
+  CHECK_EQ(uut.size(), 2u);
+  uut.dispose_token(ids[1]);
+  CHECK(t2->disposed());
+  CHECK_EQ(uut.size(), 2u);
+  CHECK_EQ(uut.continuations(), 1u);
+  CHECK(!t3->disposed());
+  uut.clear();
+  CHECK(t3->disposed());
+  CHECK(uut.empty());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,157 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.thread_safe_actor_clock
+
+#include "caf/detail/thread_safe_actor_clock.hpp"
+
+#include "core-test.hpp"
+
+#include <thread>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/scoped_actor.hpp"
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+struct fixture {
+  fixture() : sys(cfg), self(sys) {
+    // nop
+  }
+
+  ~fixture() {
+    stop();
+  }
+
+  void start() {
+    dispatcher = std::thread{[this] { clock.run_dispatch_loop(); }};
+  }
+
+  void stop() {
+    if (dispatcher.joinable()) {
+      clock.cancel_dispatch_loop();
+      dispatcher.join();
+    }
+  }
+
+  void schedule(actor_clock::time_point t, int32_t producer, int32_t value) {
+    auto hdl = actor_cast<strong_actor_ptr>(self);
+    clock.schedule_message(t, hdl,
+                           make_mailbox_element(nullptr, make_message_id(),
+                                                no_stages, producer, value));
+  }
+
+  actor_system_config cfg;
+  actor_system sys;
+  scoped_actor self;
+  detail::thread_safe_actor_clock clock;
+  std::thread dispatcher;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(thread_safe_actor_clock_tests, fixture)
+
+CAF_TEST(submitting events never blocks while the dispatch loop is busy) {
+  // The dispatch loop is not running yet, so all events remain in the
+  // submission buffers.
+  auto now = clock.now();
+  for (int32_t i = 0; i < 10'000; ++i)
+    schedule(now, 0, i);
+  start();
+  for (int32_t i = 0; i < 10'000; ++i)
+    self->receive([i](int32_t, int32_t value) { CHECK_EQ(value, i); });
+}
+
+CAF_TEST(the clock preserves the order of events for each receiver) {
+  for (auto use_wheel : {false, true}) {
+    MESSAGE("use_wheel = " << use_wheel);
+    if (use_wheel)
+      clock.use_timing_wheel(1ms);
+    start();
+    std::vector<std::thread> producers;
+    for (int32_t producer = 0; producer < 4; ++producer)
+      producers.emplace_back([this, producer] {
+        for (int32_t i = 0; i < 1'000; ++i)
+          schedule(clock.now(), producer, i);
+      });
+    std::vector<int32_t> next(4, 0);
+    for (int i = 0; i < 4'000; ++i)
+      self->receive([&](int32_t producer, int32_t value) {
+        auto& expected = next[static_cast<size_t>(producer)];
+        CHECK_EQ(value, expected);
+        expected = value + 1;
+      });
+    for (auto& producer : producers)
+      producer.join();
+    stop();
+  }
+}
+
+CAF_TEST(cancellations from other threads apply to earlier submissions) {
+  for (auto use_wheel : {false, true}) {
+    MESSAGE("use_wheel = " << use_wheel);
+    if (use_wheel)
+      clock.use_timing_wheel(1ms);
+    start();
+    auto ptr = actor_cast<abstract_actor*>(self);
+    auto mid = make_message_id(42).response_id();
+    clock.set_request_timeout(clock.now() + 10ms, ptr, mid);
+    std::thread{[&] { clock.cancel_request_timeout(ptr, mid); }}.join();
+    schedule(clock.now() + 20ms, 0, 1);
+    self->receive([](int32_t, int32_t value) { CHECK_EQ(value, 1); },
+                  [](error& err) { CAF_FAIL("unexpected error: " << err); });
+    stop();
+  }
+}
+
+CAF_TEST(cancel_all applies to earlier submissions in all buffers) {
+  using clock_type = detail::thread_safe_actor_clock;
+  auto key = actor_cast<abstract_actor*>(self)->id() % clock_type::num_buffers;
+  REQUIRE_NE(key, 0u);
+  for (auto use_wheel : {false, true}) {
+    MESSAGE("use_wheel = " << use_wheel);
+    if (use_wheel)
+      clock.use_timing_wheel(1ms);
+    // The dispatch loop is not running yet, so it sees all submissions at
+    // once when draining the buffers.
+    schedule(clock.now() + 10ms, 0, 1);
+    clock.cancel_all();
+    schedule(clock.now() + 20ms, 0, 2);
+    start();
+    self->receive([](int32_t, int32_t value) { CHECK_EQ(value, 2); });
+    self->receive([](int32_t, int32_t value) { CAF_FAIL("got " << value); },
+                  after(30ms) >> [] {});
+    stop();
+  }
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(events reuse the memory of destroyed events) {
+  using clock_type = detail::simple_actor_clock;
+  std::thread{[] {
+    // The first allocation moves all recycled blocks into the cache of this
+    // thread. Hence, the block of `ptr` becomes the next block in the shared
+    // free list and this thread receives it after using up its cache.
+    auto ptr = new clock_type::drop_all;
+    auto addr = static_cast<void*>(ptr);
+    delete ptr;
+    std::vector<clock_type::event*> events;
+    auto reused = false;
+    while (!reused && events.size() < 1'000'000) {
+      events.emplace_back(new clock_type::request_timeout_cancellation(
+        42, make_message_id()));
+      reused = static_cast<void*>(events.back()) == addr;
+    }
+    CHECK(reused);
+    for (auto ptr : events)
+      delete ptr;
+  }}.join();
+}
@@ -0,0 +1,206 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.timing_wheel_actor_clock
+
+#include "caf/detail/timing_wheel_actor_clock.hpp"
+
+#include "core-test.hpp"
+
+#include <algorithm>
+#include <random>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class manual_wheel : public detail::timing_wheel_actor_clock {
+public:
+  using super = detail::timing_wheel_actor_clock;
+
+  explicit manual_wheel(duration_type tick_interval)
+    : super(tick_interval), current_time(std::chrono::hours(1)) {
+    // nop
+  }
+
+  time_point now() const noexcept override {
+    return current_time;
+  }
+
+  size_t advance_time(duration_type x) {
+    current_time += x;
+    return trigger_expired_timeouts();
+  }
+
+  time_point current_time;
+};
+
+struct tid {
+  uint32_t value;
+};
+
+inline bool operator==(const timeout_msg& x, const tid& y) {
+  return x.timeout_id == y.value;
+}
+
+struct fixture : test_coordinator_fixture<> {
+  fixture() : t(1ms) {
+    aut = sys.spawn([this](event_based_actor* self) -> behavior {
+      self->set_default_handler(drop);
+      return {
+        [this](int x) { received.push_back(x); },
+      };
+    });
+    run();
+    aut_ptr = actor_cast<abstract_actor*>(aut);
+  }
+
+  void schedule(actor_clock::time_point due, int x) {
+    auto hdl = actor_cast<strong_actor_ptr>(aut);
+    t.schedule_message(due, hdl,
+                       make_mailbox_element(nullptr, make_message_id(),
+                                            no_stages, x));
+  }
+
+  manual_wheel t;
+  actor aut;
+  abstract_actor* aut_ptr;
+  std::vector<int> received;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(timing_wheel_tests, fixture)
+
+CAF_TEST(the wheel triggers ordinary timeouts at their due time) {
+  t.set_ordinary_timeout(t.now() + 10s, aut_ptr, "", 42);
+  CHECK_EQ(t.size(), 1u);
+  CHECK_EQ(t.advance_time(9s), 0u);
+  CHECK_EQ(t.advance_time(1s), 1u);
+  CHECK(t.empty());
+  expect((timeout_msg), from(aut).to(aut).with(tid{42}));
+}
+
+CAF_TEST(ordinary timeouts override previous timeouts of the same type) {
+  t.set_ordinary_timeout(t.now() + 10s, aut_ptr, "", 42);
+  t.set_ordinary_timeout(t.now() + 20s, aut_ptr, "", 43);
+  t.set_ordinary_timeout(t.now() + 10s, aut_ptr, "other", 44);
+  CHECK_EQ(t.size(), 2u);
+  CHECK_EQ(t.advance_time(10s), 1u);
+  expect((timeout_msg), from(aut).to(aut).with(tid{44}));
+  CHECK_EQ(t.advance_time(10s), 1u);
+  expect((timeout_msg), from(aut).to(aut).with(tid{43}));
+  t.set_ordinary_timeout(t.now() + 10s, aut_ptr, "", 45);
+  t.cancel_ordinary_timeout(aut_ptr, "");
+  CHECK(t.empty());
+}
+
+CAF_TEST(the wheel keeps multiple multi timeouts per type) {
+  t.set_multi_timeout(t.now() + 10s, aut_ptr, "", 42);
+  t.set_multi_timeout(t.now() + 5s, aut_ptr, "", 43);
+  CHECK_EQ(t.size(), 2u);
+  CHECK_EQ(t.advance_time(5s), 1u);
+  expect((timeout_msg), from(aut).to(aut).with(tid{43}));
+  CHECK_EQ(t.advance_time(5s), 1u);
+  expect((timeout_msg), from(aut).to(aut).with(tid{42}));
+}
+
+CAF_TEST(request timeouts are cancellable by message ID) {
+  auto mid1 = make_message_id(1).response_id();
+  auto mid2 = make_message_id(2).response_id();
+  t.set_request_timeout(t.now() + 10s, aut_ptr, mid1);
+  t.set_request_timeout(t.now() + 10s, aut_ptr, mid2);
+  CHECK_EQ(t.size(), 2u);
+  t.cancel_request_timeout(aut_ptr, mid1);
+  CHECK_EQ(t.size(), 1u);
+  CHECK_EQ(t.advance_time(10s), 1u);
+  expect((error), from(aut).to(aut).with(sec::request_timeout));
+  disallow((error), from(aut).to(aut));
+}
+
+CAF_TEST(cancel_timeouts removes all timeouts of an actor) {
+  t.set_ordinary_timeout(t.now() + 10s, aut_ptr, "", 42);
+  t.set_multi_timeout(t.now() + 10s, aut_ptr, "", 43);
+  t.set_request_timeout(t.now() + 10s, aut_ptr,
+                        make_message_id(1).response_id());
+  schedule(t.now() + 10s, 1);
+  CHECK_EQ(t.size(), 4u);
+  t.cancel_timeouts(aut_ptr);
+  CHECK_EQ(t.size(), 1u);
+  CHECK_EQ(t.advance_time(10s), 1u);
+  run();
+  CHECK_EQ(received, std::vector<int>({1}));
+}
+
+CAF_TEST(events in the same tick trigger in insertion order) {
+  for (int i = 0; i < 5; ++i)
+    schedule(t.now() + 1s + std::chrono::microseconds(100 * (5 - i)), i);
+  t.advance_time(2s);
+  run();
+  CHECK_EQ(received, std::vector<int>({0, 1, 2, 3, 4}));
+}
+
+CAF_TEST(events in the past trigger on the next call) {
+  schedule(t.now() - 1s, 1);
+  CHECK_EQ(t.size(), 1u);
+  CHECK(t.next_timeout() <= t.now());
+  CHECK_EQ(t.trigger_expired_timeouts(), 1u);
+  run();
+  CHECK_EQ(received, std::vector<int>({1}));
+}
+
+CAF_TEST(next_timeout never lies behind the next event) {
+  auto due = t.now() + 90min;
+  schedule(due, 1);
+  auto rounds = 0;
+  while (!t.empty()) {
+    auto next = t.next_timeout();
+    CHECK(next <= due + t.tick_interval());
+    t.current_time = std::max(t.current_time, next);
+    t.trigger_expired_timeouts();
+    ++rounds;
+  }
+  CHECK_LE(rounds, 5);
+  run();
+  CHECK_EQ(received, std::vector<int>({1}));
+}
+
+CAF_TEST(the wheel triggers each event exactly once and never early) {
+  // Use a tick interval of 1us to make the wheel overflow after ~71 minutes.
+  manual_wheel wheel{1us};
+  wheel.current_time = t.current_time;
+  std::minstd_rand rng{42};
+  std::uniform_int_distribution<int64_t> dist{0, 7'200'000'000};
+  std::vector<actor_clock::time_point> due;
+  auto hdl = actor_cast<strong_actor_ptr>(aut);
+  for (int i = 0; i < 10'000; ++i) {
+    due.emplace_back(wheel.now() + std::chrono::microseconds(dist(rng)));
+    wheel.schedule_message(due.back(), hdl,
+                           make_mailbox_element(nullptr, make_message_id(),
+                                                no_stages, i));
+  }
+  CHECK_EQ(wheel.size(), 10'000u);
+  std::uniform_int_distribution<int64_t> step{0, 60'000'000};
+  size_t checked = 0;
+  while (!wheel.empty()) {
+    wheel.advance_time(std::chrono::microseconds(step(rng)));
+    run();
+    for (; checked < received.size(); ++checked)
+      CHECK(due[static_cast<size_t>(received[checked])] <= wheel.now());
+    auto expected = std::count_if(due.begin(), due.end(), [&](auto x) {
+      return x <= wheel.now() - wheel.tick_interval();
+    });
+    CHECK_GE(received.size(), static_cast<size_t>(expected));
+  }
+  std::sort(received.begin(), received.end());
+  CHECK_EQ(received.size(), 10'000u);
+  CHECK(std::adjacent_find(received.begin(), received.end())
+        == received.end());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
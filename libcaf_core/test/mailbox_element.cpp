@@ -13,6 +13,9 @@
 #include <vector>
 
 #include "caf/all.hpp"
+#include "caf/intrusive/drr_cached_queue.hpp"
+#include "caf/intrusive/drr_queue.hpp"
+#include "caf/policy/normal_messages.hpp"
 
 using std::make_tuple;
 using std::string;
@@ -20,6 +23,7 @@ using std::tuple;
 using std::vector;
 
 using namespace caf;
+using namespace std::literals;
 
 namespace {
 
@@ -97,3 +101,74 @@ CAF_TEST(downstream_msg_dynamic) {
     make_message(make<downstream_msg::close>({0, 0}, nullptr)));
   CAF_CHECK(m1->mid.category() == message_id::downstream_message_category);
 }
+
+CAF_TEST(small messages share the memory block with their element) {
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                 int64_t{42}, string{"hello"});
+  auto data = reinterpret_cast<const byte*>(m1->content().cptr());
+  auto elem = reinterpret_cast<const byte*>(m1.get());
+  CHECK_LT(data, elem);
+  CHECK_LE(elem - data, static_cast<ptrdiff_t>(
+                          sizeof(detail::message_data)
+                          + mailbox_element::max_inline_payload_size
+                          + alignof(mailbox_element)));
+  CHECK(m1->content().cdata().unique());
+  CHECK_EQ(m1->content().cdata().get_reference_count(), 1u);
+  CHECK_EQ((fetch<int64_t, string>(*m1)), make_tuple(int64_t{42}, "hello"s));
+}
+
+CAF_TEST(small messages may outlive their element) {
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                 int64_t{42}, string{"hello"});
+  auto msg = m1->content();
+  CHECK_EQ(msg.cdata().get_reference_count(), 2u);
+  m1.reset();
+  CHECK(msg.cdata().unique());
+  CHECK_EQ((fetch<int64_t, string>(msg)), make_tuple(int64_t{42}, "hello"s));
+  msg.get_mutable_as<string>(1) = "world";
+  CHECK_EQ((fetch<int64_t, string>(msg)), make_tuple(int64_t{42}, "world"s));
+}
+
+CAF_TEST(elements may replace their inline content) {
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages, 1, 2);
+  auto& original = m1->content().cdata();
+  m1->content().get_mutable_as<int>(0) = 10;
+  CHECK_EQ(&m1->content().cdata(), &original);
+  m1->content() = make_message(1, 2, 3);
+  CHECK_EQ((fetch<int, int, int>(*m1)), make_tuple(1, 2, 3));
+}
+
+CAF_TEST(DRR queues prefetch elements with inline and heap content) {
+  // Fills `queue` with an element that stores its content inline, an element
+  // with heap-allocated content and an element without content. The last
+  // element has no successor, so the queue also prefetches past the end.
+  auto fill = [](auto& queue) {
+    queue.push_back(make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                         1, 2));
+    queue.push_back(make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                         make_message("hello"s)));
+    queue.push_back(make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                         message{}));
+  };
+  auto drain = [](auto& queue) {
+    vector<string> result;
+    auto f = [&result](mailbox_element& x) {
+      result.emplace_back(to_string(x.content()));
+      return intrusive::task_result::resume;
+    };
+    while (!queue.empty())
+      queue.new_round(1, f);
+    return result;
+  };
+  vector<string> expected{"message(1, 2)", R"__(message("hello"))__",
+                          "message()"};
+  MESSAGE("drr_queue");
+  intrusive::drr_queue<policy::normal_messages> q1{policy::normal_messages{}};
+  fill(q1);
+  CHECK_EQ(drain(q1), expected);
+  MESSAGE("drr_cached_queue");
+  intrusive::drr_cached_queue<policy::normal_messages> q2{
+    policy::normal_messages{}};
+  fill(q2);
+  CHECK_EQ(drain(q2), expected);
+}
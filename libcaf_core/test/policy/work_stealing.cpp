@@ -0,0 +1,130 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE policy.work_stealing
+
+#include "caf/policy/work_stealing.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+
+using namespace caf;
+
+namespace {
+
+// A job that never runs.
+struct dummy_job : resumable {
+  resume_result resume(execution_unit*, size_t) override {
+    return resumable::done;
+  }
+
+  void intrusive_ptr_add_ref_impl() override {
+    // nop
+  }
+
+  void intrusive_ptr_release_impl() override {
+    // nop
+  }
+};
+
+struct config : actor_system_config {
+  config(bool lifo_slot, size_t max_lifo_runs) {
+    set("caf.scheduler.policy", "testing");
+    set("caf.work-stealing.idle-strategy", "poll");
+    set("caf.work-stealing.lifo-slot", lifo_slot);
+    set("caf.work-stealing.max-lifo-runs", max_lifo_runs);
+  }
+};
+
+// Provides the interface of a worker to the policy without running a thread.
+struct fake_worker {
+  explicit fake_worker(scheduler::abstract_coordinator* parent)
+    : data_(parent) {
+    // nop
+  }
+
+  policy::work_stealing::worker_data& data() {
+    return data_;
+  }
+
+  size_t id() const noexcept {
+    return 0;
+  }
+
+  policy::work_stealing::worker_data data_;
+};
+
+struct fixture {
+  fixture(bool lifo_slot = true, size_t max_lifo_runs = 2)
+    : cfg(lifo_slot, max_lifo_runs), sys(cfg), self(&sys.scheduler()) {
+    // nop
+  }
+
+  config cfg;
+  actor_system sys;
+  fake_worker self;
+  policy::work_stealing uut;
+  dummy_job a;
+  dummy_job b;
+  dummy_job c;
+};
+
+struct no_lifo_fixture : fixture {
+  no_lifo_fixture() : fixture(false, 2) {
+    // nop
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(lifo_slot_tests, fixture)
+
+CAF_TEST(workers run the job they enqueued last next) {
+  uut.internal_enqueue(&self, &a);
+  CHECK(self.data().local_queue.empty());
+  uut.internal_enqueue(&self, &b);
+  CHECK(!self.data().local_queue.empty());
+  CHECK_EQ(uut.take_head(&self), &b);
+  CHECK_EQ(uut.take_head(&self), &a);
+  CHECK_EQ(uut.take_head(&self), nullptr);
+}
+
+CAF_TEST(other workers cannot steal the job in the LIFO slot) {
+  uut.internal_enqueue(&self, &a);
+  CHECK_EQ(self.data().local_queue.steal(), nullptr);
+  CHECK_EQ(self.data().queue.take_tail(), nullptr);
+  CHECK_EQ(uut.take_head(&self), &a);
+}
+
+CAF_TEST(workers limit consecutive runs from the LIFO slot) {
+  uut.external_enqueue(&self, &c);
+  // simulate two actors that keep waking each other up
+  uut.internal_enqueue(&self, &a);
+  CHECK_EQ(uut.take_head(&self), &a);
+  uut.internal_enqueue(&self, &b);
+  CHECK_EQ(uut.take_head(&self), &b);
+  uut.internal_enqueue(&self, &a);
+  // exceeds max-lifo-runs, so the worker must run the other job first
+  CHECK_EQ(uut.take_head(&self), &c);
+  CHECK_EQ(uut.take_head(&self), &a);
+  CHECK_EQ(uut.take_head(&self), nullptr);
+  // the counter resets after taking a job from the queues
+  uut.internal_enqueue(&self, &b);
+  CHECK_EQ(uut.take_head(&self), &b);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST_FIXTURE_SCOPE(no_lifo_slot_tests, no_lifo_fixture)
+
+CAF_TEST(workers without LIFO slot push all jobs to their local queue) {
+  uut.internal_enqueue(&self, &a);
+  CHECK(!self.data().local_queue.empty());
+  CHECK_EQ(self.data().local_queue.steal(), &a);
+  CHECK_EQ(uut.take_head(&self), nullptr);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,173 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE proxy_registry
+
+#include "caf/proxy_registry.hpp"
+
+#include "core-test.hpp"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "caf/actor_proxy.hpp"
+#include "caf/make_actor.hpp"
+
+using namespace caf;
+
+namespace {
+
+class mock_actor_proxy : public actor_proxy {
+public:
+  explicit mock_actor_proxy(actor_config& cfg) : actor_proxy(cfg) {
+    // nop
+  }
+
+  void enqueue(mailbox_element_ptr, execution_unit*) override {
+    CAF_FAIL("mock_actor_proxy::enqueue called");
+  }
+
+  void kill_proxy(execution_unit*, error) override {
+    ++killed;
+  }
+
+  static inline std::atomic<size_t> killed;
+};
+
+class mock_backend : public proxy_registry::backend {
+public:
+  explicit mock_backend(actor_system& sys) : sys_(sys) {
+    // nop
+  }
+
+  strong_actor_ptr make_proxy(node_id nid, actor_id aid) override {
+    ++created;
+    if (on_make_proxy)
+      on_make_proxy();
+    actor_config cfg;
+    return make_actor<mock_actor_proxy, strong_actor_ptr>(aid, nid, &sys_, cfg);
+  }
+
+  void set_last_hop(node_id*) override {
+    // nop
+  }
+
+  std::atomic<size_t> created{0};
+
+  std::function<void()> on_make_proxy;
+
+private:
+  actor_system& sys_;
+};
+
+struct fixture : test_coordinator_fixture<> {
+  fixture() : backend(sys), proxies(sys, backend) {
+    mock_actor_proxy::killed = 0;
+  }
+
+  node_id make_node(uint8_t id) {
+    hashed_node_id::host_id_type host{};
+    host[0] = id;
+    return make_node_id(static_cast<uint32_t>(id), host);
+  }
+
+  mock_backend backend;
+  proxy_registry proxies;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(proxy_registry_tests, fixture)
+
+CAF_TEST(get_or_put creates each proxy only once) {
+  auto nid = make_node(1);
+  CHECK(proxies.empty());
+  CHECK_EQ(proxies.get(nid, 42), nullptr);
+  auto x = proxies.get_or_put(nid, 42);
+  REQUIRE_NE(x, nullptr);
+  CHECK_EQ(x->id(), 42u);
+  CHECK_EQ(x->node(), nid);
+  CHECK_EQ(proxies.get_or_put(nid, 42), x);
+  CHECK_EQ(proxies.get(nid, 42), x);
+  CHECK_EQ(backend.created.load(), 1u);
+  CHECK(!proxies.empty());
+}
+
+CAF_TEST(lookups do not wait for the creation of a proxy) {
+  auto nid = make_node(1);
+  strong_actor_ptr concurrent_result;
+  backend.on_make_proxy = [&] {
+    // Blocks forever if get_or_put holds the lock of the shard.
+    std::thread{[&] { concurrent_result = proxies.get(nid, 42); }}.join();
+  };
+  auto x = proxies.get_or_put(nid, 42);
+  CHECK_NE(x, nullptr);
+  CHECK_EQ(concurrent_result, nullptr);
+  CHECK_EQ(proxies.get(nid, 42), x);
+}
+
+CAF_TEST(get_all returns all proxies of a node sorted by ID) {
+  auto nid1 = make_node(1);
+  auto nid2 = make_node(2);
+  for (actor_id aid = 200; aid > 0; --aid) {
+    proxies.get_or_put(nid1, aid);
+    proxies.get_or_put(nid2, aid + 1000);
+  }
+  CHECK_EQ(proxies.count_proxies(nid1), 200u);
+  CHECK_EQ(proxies.count_proxies(nid2), 200u);
+  auto xs = proxies.get_all(nid1);
+  REQUIRE_EQ(xs.size(), 200u);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    CHECK_EQ(xs[i]->id(), i + 1);
+    CHECK_EQ(xs[i]->node(), nid1);
+  }
+}
+
+CAF_TEST(erasing a node kills all of its proxies) {
+  auto nid1 = make_node(1);
+  auto nid2 = make_node(2);
+  for (actor_id aid = 1; aid <= 100; ++aid) {
+    proxies.get_or_put(nid1, aid);
+    proxies.get_or_put(nid2, aid);
+  }
+  proxies.erase(nid1, 1);
+  CHECK_EQ(mock_actor_proxy::killed.load(), 1u);
+  CHECK_EQ(proxies.get(nid1, 1), nullptr);
+  CHECK_EQ(proxies.count_proxies(nid1), 99u);
+  proxies.erase(nid1);
+  CHECK_EQ(mock_actor_proxy::killed.load(), 100u);
+  CHECK_EQ(proxies.count_proxies(nid1), 0u);
+  CHECK_EQ(proxies.count_proxies(nid2), 100u);
+  proxies.clear();
+  CHECK_EQ(mock_actor_proxy::killed.load(), 200u);
+  CHECK(proxies.empty());
+}
+
+CAF_TEST(threads may look up and create proxies concurrently) {
+  constexpr size_t num_threads = 4;
+  constexpr size_t num_nodes = 4;
+  constexpr actor_id num_actors = proxy_registry::num_shards * 2;
+  std::vector<node_id> nodes;
+  for (size_t i = 0; i < num_nodes; ++i)
+    nodes.emplace_back(make_node(static_cast<uint8_t>(i + 1)));
+  std::vector<std::vector<strong_actor_ptr>> results(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t id = 0; id < num_threads; ++id)
+    threads.emplace_back([&, id] {
+      for (auto& nid : nodes)
+        for (actor_id aid = 1; aid <= num_actors; ++aid)
+          results[id].emplace_back(proxies.get_or_put(nid, aid));
+    });
+  for (auto& t : threads)
+    t.join();
+  CHECK_EQ(backend.created.load(), num_nodes * num_actors);
+  for (size_t id = 1; id < num_threads; ++id)
+    CHECK(results[id] == results[0]);
+  for (auto& nid : nodes)
+    CHECK_EQ(proxies.count_proxies(nid), num_actors);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -284,4 +284,24 @@ CAF_TEST(multiplexed_timeout) {
   }
 }
 
+CAF_TEST(responses discard pending request timeouts) {
+  auto discarded = sys.base_metrics().discarded_timeouts;
+  auto had_pong = false;
+  auto buddy = sys.spawn(pong);
+  auto testee = sys.spawn([=, &had_pong](event_based_actor* self) {
+    self->request(buddy, seconds(1), ping_atom_v)
+      .then([&had_pong](pong_atom) { had_pong = true; },
+            [](const error& err) { CAF_FAIL("unexpected error: " << err); });
+    // Keep the actor alive. Otherwise, it cancels all of its timeouts.
+    return behavior{[](int) {}};
+  });
+  sched.run();
+  CAF_CHECK(had_pong);
+  CAF_CHECK_EQUAL(discarded->value(), 0);
+  // The clock still holds the timeout but drops it instead of shipping it.
+  CAF_CHECK(sched.trigger_timeout());
+  CAF_CHECK(sched.jobs.empty());
+  CAF_CHECK_EQUAL(discarded->value(), 1);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
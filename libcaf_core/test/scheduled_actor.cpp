@@ -0,0 +1,287 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE scheduled_actor
+
+#include "caf/scheduled_actor.hpp"
+
+#include "core-test.hpp"
+
+#include <thread>
+
+#include "caf/event_based_actor.hpp"
+#include "caf/scoped_execution_unit.hpp"
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+template <bool Adaptive>
+struct config : actor_system_config {
+  config() {
+    set("caf.scheduler.time-slice", timespan{2500us});
+    set("caf.scheduler.adaptive-throughput", Adaptive);
+    put(content, "caf.metrics-filters.actors.includes",
+        std::vector<std::string>{"user.scheduled-actor"});
+  }
+};
+
+template <class Config>
+struct fixture : test_coordinator_fixture<Config> {
+  using super = test_coordinator_fixture<Config>;
+
+  fixture() : ctx(&this->sys) {
+    hdl = this->sys.spawn([this]() -> behavior {
+      return {
+        [this](int) {
+          ++count;
+          std::this_thread::sleep_for(1ms);
+        },
+      };
+    });
+    this->run();
+    ptr = static_cast<scheduled_actor*>(actor_cast<abstract_actor*>(hdl));
+    for (int i = 0; i < 10; ++i)
+      this->self->send(hdl, i);
+  }
+
+  // Runs the actor once with a throughput that would allow it to consume all
+  // messages in its mailbox and returns how many messages it consumed.
+  size_t resume() {
+    auto before = count;
+    ptr->resume(&ctx, 100);
+    return count - before;
+  }
+
+  int64_t throughput_budget() {
+    auto& families = this->sys.actor_metric_families();
+    return families.throughput_budget
+      ->get_or_add({{"name", "user.scheduled-actor"}})
+      ->value();
+  }
+
+  double message_cost() {
+    auto& families = this->sys.actor_metric_families();
+    return families.message_cost
+      ->get_or_add({{"name", "user.scheduled-actor"}})
+      ->value();
+  }
+
+  scoped_execution_unit ctx;
+  actor hdl;
+  scheduled_actor* ptr = nullptr;
+  size_t count = 0;
+};
+
+using time_sliced_fixture = fixture<config<false>>;
+
+using adaptive_fixture = fixture<config<true>>;
+
+struct bounded_config : actor_system_config {
+  bounded_config() {
+    put(content, "caf.metrics-filters.actors.includes",
+        std::vector<std::string>{"user.scheduled-actor"});
+  }
+};
+
+class bounded_testee : public event_based_actor {
+public:
+  bounded_testee(actor_config& cfg, std::vector<int>* received)
+    : event_based_actor(cfg), received_(received) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    return {
+      [this](int x) { received_->push_back(x); },
+    };
+  }
+
+private:
+  std::vector<int>* received_;
+};
+
+struct bounded_fixture : test_coordinator_fixture<bounded_config> {
+  actor spawn_bounded(mailbox_overflow_policy policy) {
+    auto f = [this](event_based_actor*) -> behavior {
+      return {
+        [this](int x) { received.push_back(x); },
+      };
+    };
+    auto hdl = sys.spawn_bounded(3, policy, f);
+    run();
+    ptr = static_cast<scheduled_actor*>(actor_cast<abstract_actor*>(hdl));
+    return hdl;
+  }
+
+  int64_t dropped_messages() {
+    auto& families = sys.actor_metric_families();
+    return families.dropped_messages
+      ->get_or_add({{"name", "user.scheduled-actor"}})
+      ->value();
+  }
+
+  scheduled_actor* ptr = nullptr;
+  std::vector<int> received;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(time_sliced_tests, time_sliced_fixture)
+
+CAF_TEST(actors return control to the scheduler after their time slice) {
+  auto n = resume();
+  CHECK_GE(n, 1u);
+  CHECK_LE(n, 3u);
+  CHECK_GE(ptr->message_cost(), timespan{1ms});
+  run();
+  CHECK_EQ(count, 10u);
+}
+
+CAF_TEST(actors without adaptive throughput only publish their message cost) {
+  resume();
+  CHECK_GE(message_cost(), 0.001);
+  CHECK_EQ(throughput_budget(), 0);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST_FIXTURE_SCOPE(adaptive_tests, adaptive_fixture)
+
+CAF_TEST(actors derive their throughput from their message costs) {
+  CHECK_EQ(ptr->message_cost(), timespan{0});
+  resume();
+  CHECK_GE(ptr->message_cost(), timespan{1ms});
+  // The time slice only fits two messages, so the actor must stop after two
+  // messages even if the clock check would allow a third message.
+  auto n = resume();
+  CHECK_GE(n, 1u);
+  CHECK_LE(n, 2u);
+  CHECK_GE(throughput_budget(), 1);
+  CHECK_LE(throughput_budget(), 2);
+  run();
+  CHECK_EQ(count, 10u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST_FIXTURE_SCOPE(bounded_mailbox_tests, bounded_fixture)
+
+CAF_TEST(actors have unbounded mailboxes by default) {
+  auto hdl = sys.spawn([this](event_based_actor* self) {
+    CHECK_EQ(self->mailbox_capacity(), 0u);
+    return behavior{[this](int x) { received.push_back(x); }};
+  });
+  for (int i = 1; i <= 5; ++i)
+    anon_send(hdl, i);
+  run();
+  CHECK_EQ(received, std::vector<int>({1, 2, 3, 4, 5}));
+}
+
+CAF_TEST(drop_newest discards messages beyond the capacity) {
+  auto hdl = spawn_bounded(mailbox_overflow_policy::drop_newest);
+  for (int i = 1; i <= 5; ++i)
+    anon_send(hdl, i);
+  CHECK_EQ(ptr->mailbox_depth(), 3u);
+  CHECK_EQ(dropped_messages(), 2);
+  run();
+  CHECK_EQ(received, std::vector<int>({1, 2, 3}));
+  CHECK_EQ(ptr->mailbox_depth(), 0u);
+  anon_send(hdl, 4);
+  run();
+  CHECK_EQ(received, std::vector<int>({1, 2, 3, 4}));
+}
+
+CAF_TEST(class-based actors accept a bounded mailbox) {
+  auto hdl = sys.spawn_bounded<bounded_testee>(
+    2, mailbox_overflow_policy::drop_newest, &received);
+  run();
+  for (int i = 1; i <= 5; ++i)
+    anon_send(hdl, i);
+  run();
+  CHECK_EQ(received, std::vector<int>({1, 2}));
+}
+
+CAF_TEST(full mailboxes answer requests with mailbox_full) {
+  auto hdl = spawn_bounded(mailbox_overflow_policy::drop_newest);
+  for (int i = 1; i <= 3; ++i)
+    anon_send(hdl, i);
+  self->request(hdl, infinite, 4)
+    .receive([] { CAF_FAIL("expected an error"); },
+             [](const error& err) { CHECK_EQ(err, sec::mailbox_full); });
+  run();
+  CHECK_EQ(received, std::vector<int>({1, 2, 3}));
+}
+
+CAF_TEST(reject sends mailbox_full to asynchronous senders) {
+  auto hdl = spawn_bounded(mailbox_overflow_policy::reject);
+  for (int i = 1; i <= 4; ++i)
+    self->send(hdl, i);
+  self->receive([](const error& err) { CHECK_EQ(err, sec::mailbox_full); });
+  run();
+  CHECK_EQ(received, std::vector<int>({1, 2, 3}));
+  CHECK_EQ(dropped_messages(), 1);
+}
+
+CAF_TEST(drop_oldest discards the oldest messages) {
+  auto hdl = spawn_bounded(mailbox_overflow_policy::drop_oldest);
+  for (int i = 1; i <= 5; ++i)
+    anon_send(hdl, i);
+  CHECK_EQ(ptr->mailbox_depth(), 5u);
+  run();
+  CHECK_EQ(received, std::vector<int>({3, 4, 5}));
+  CHECK_EQ(ptr->mailbox_depth(), 0u);
+  CHECK_EQ(dropped_messages(), 2);
+}
+
+CAF_TEST(drop_oldest discards skipped messages first) {
+  std::vector<std::string> strings;
+  auto f = [this, &strings](event_based_actor* self) -> behavior {
+    self->set_default_handler(skip);
+    return {
+      [this](int x) { received.push_back(x); },
+      [self, &strings](get_atom) {
+        self->become(
+          [&strings](const std::string& x) { strings.push_back(x); });
+      },
+    };
+  };
+  auto hdl = sys.spawn_bounded(3, mailbox_overflow_policy::drop_oldest, f);
+  run();
+  ptr = static_cast<scheduled_actor*>(actor_cast<abstract_actor*>(hdl));
+  MESSAGE("skipped messages fill the mailbox");
+  for (auto str : {"a", "b", "c"})
+    anon_send(hdl, std::string{str});
+  run();
+  CHECK_EQ(ptr->mailbox_depth(), 3u);
+  MESSAGE("new messages push out the oldest skipped messages");
+  anon_send(hdl, 1);
+  anon_send(hdl, 2);
+  run();
+  CHECK_EQ(received, std::vector<int>({1, 2}));
+  CHECK_EQ(dropped_messages(), 2);
+  anon_send(hdl, get_atom_v);
+  run();
+  CHECK_EQ(strings, std::vector<std::string>({"c"}));
+  CHECK_EQ(ptr->mailbox_depth(), 0u);
+}
+
+CAF_TEST(signal sends backpressure messages to the sender) {
+  auto hdl = spawn_bounded(mailbox_overflow_policy::signal);
+  for (int i = 1; i <= 5; ++i)
+    self->send(hdl, i);
+  std::vector<uint64_t> sizes;
+  for (int i = 0; i < 2; ++i)
+    self->receive([&](backpressure_msg& x) {
+      CHECK_EQ(x.source, hdl.address());
+      sizes.push_back(x.mailbox_size);
+    });
+  CHECK_EQ(sizes, std::vector<uint64_t>({4, 5}));
+  run();
+  CHECK_EQ(received, std::vector<int>({1, 2, 3, 4, 5}));
+  CHECK_EQ(dropped_messages(), 0);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,105 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE spawn_n
+
+#include "caf/actor_system.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/event_based_actor.hpp"
+
+using namespace caf;
+
+namespace {
+
+behavior adder(int32_t offset) {
+  return {
+    [offset](int32_t x) { return x + offset; },
+  };
+}
+
+class multiplier : public event_based_actor {
+public:
+  multiplier(actor_config& cfg, int32_t factor)
+    : event_based_actor(cfg), factor_(factor) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    return {
+      [this](int32_t x) { return x * factor_; },
+    };
+  }
+
+private:
+  int32_t factor_;
+};
+
+struct fixture : test_coordinator_fixture<> {
+  size_t running() {
+    return sys.registry().running();
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(spawn_n_tests, fixture)
+
+CAF_TEST(spawn_n creates actors with consecutive IDs) {
+  auto baseline = running();
+  auto hdls = sys.spawn_n(10, adder, int32_t{1});
+  REQUIRE_EQ(hdls.size(), 10u);
+  CHECK_EQ(running(), baseline + 10);
+  for (size_t i = 1; i < hdls.size(); ++i)
+    CHECK_EQ(hdls[i].id(), hdls[0].id() + i);
+  CHECK_EQ(sys.latest_actor_id(), hdls.back().id());
+  run();
+  for (auto& hdl : hdls) {
+    self->send(hdl, int32_t{41});
+    run();
+    expect((int32_t), from(hdl).to(self).with(42));
+  }
+  for (auto& hdl : hdls)
+    anon_send_exit(hdl, exit_reason::user_shutdown);
+  run();
+  CHECK_EQ(running(), baseline);
+}
+
+CAF_TEST(spawn_n passes copies of the arguments to class-based actors) {
+  auto hdls = sys.spawn_n<multiplier>(3, int32_t{3});
+  REQUIRE_EQ(hdls.size(), 3u);
+  run();
+  for (auto& hdl : hdls) {
+    self->send(hdl, int32_t{7});
+    run();
+    expect((int32_t), from(hdl).to(self).with(21));
+  }
+}
+
+CAF_TEST(spawn_n schedules all new actors at once) {
+  auto hdls = sys.spawn_n(5, adder, int32_t{0});
+  CHECK_EQ(sched.jobs.size(), 5u);
+  run();
+  CHECK(sched.jobs.empty());
+  auto lazy_hdls = sys.spawn_n<lazy_init>(5, adder, int32_t{0});
+  CHECK(sched.jobs.empty());
+  self->send(lazy_hdls[0], int32_t{1});
+  CHECK_EQ(sched.jobs.size(), 1u);
+}
+
+CAF_TEST(hidden actors do not count as running actors) {
+  auto baseline = running();
+  auto hdls = sys.spawn_n<hidden>(5, adder, int32_t{0});
+  CHECK_EQ(hdls.size(), 5u);
+  CHECK_EQ(running(), baseline);
+}
+
+CAF_TEST(spawn_n returns an empty list for n = 0) {
+  auto id = sys.latest_actor_id();
+  CHECK(sys.spawn_n(0, adder, int32_t{0}).empty());
+  CHECK_EQ(sys.latest_actor_id(), id);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -75,4 +75,48 @@ some_request_duration_seconds_count{x="get"} 3 42000
   CAF_CHECK_EQUAL(res1, exporter.collect_from(registry, ts));
 }
 
+CAF_TEST(the Prometheus collector renders new values on each scrape) {
+  auto dg = registry.gauge_family<double>("foo", "ratio", {"x"}, "A ratio.");
+  auto ic = registry.counter_family("foo", "events", {"x"}, "Some events.",
+                                    "1", true);
+  auto ratio = dg->get_or_add({{"x", "a"}});
+  auto events = ic->get_or_add({{"x", "b"}});
+  ratio->value(0.5);
+  events->inc(2);
+  CAF_CHECK_EQUAL(exporter.collect_from(registry, timestamp{1s}),
+                  R"(# HELP foo_ratio A ratio.
+# TYPE foo_ratio gauge
+foo_ratio{x="a"} 0.500000 1000
+# HELP foo_events_total Some events.
+# TYPE foo_events_total counter
+foo_events_total{x="b"} 2 1000
+)"_sv);
+  ratio->value(-1234.25);
+  events->inc(9000000000);
+  CAF_CHECK_EQUAL(exporter.collect_from(registry, timestamp{2s}),
+                  R"(# HELP foo_ratio A ratio.
+# TYPE foo_ratio gauge
+foo_ratio{x="a"} -1234.250000 2000
+# HELP foo_events_total Some events.
+# TYPE foo_events_total counter
+foo_events_total{x="b"} 9000000002 2000
+)"_sv);
+}
+
+CAF_TEST(callers can take over the scrape result without copying it) {
+  auto fam = registry.gauge_family("foo", "bar", {}, "Some value.");
+  fam->get_or_add({})->value(1);
+  exporter.min_scrape_interval(1h);
+  auto text = exporter.collect_from(registry, timestamp{1s});
+  std::string expected{text.data(), text.size()};
+  collector::prometheus::char_buffer buf;
+  exporter.swap_buffer(buf);
+  CAF_CHECK_EQUAL(std::string(buf.begin(), buf.end()), expected);
+  CAF_CHECK(exporter.str().empty());
+  CAF_MESSAGE("an empty buffer forces the collector to scrape again");
+  fam->get_or_add({})->value(2);
+  text = exporter.collect_from(registry, timestamp{2s});
+  CAF_CHECK_NOT_EQUAL(text.find("\nfoo_bar 2 2000\n"), string_view::npos);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
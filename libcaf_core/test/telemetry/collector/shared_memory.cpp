@@ -0,0 +1,258 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE telemetry.collector.shared_memory
+
+#include "caf/telemetry/collector/shared_memory.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/config.hpp"
+
+#ifdef CAF_POSIX
+
+#  include <algorithm>
+#  include <cstdio>
+#  include <limits>
+#  include <thread>
+#  include <tuple>
+
+#  include <unistd.h>
+
+#  include "caf/actor_system.hpp"
+#  include "caf/actor_system_config.hpp"
+#  include "caf/telemetry/metric_registry.hpp"
+#  include "caf/telemetry/shared_memory_reader.hpp"
+
+using namespace caf;
+using namespace caf::telemetry;
+
+using namespace std::literals;
+
+namespace {
+
+std::string make_path(const char* suffix) {
+  std::string result = "/tmp/caf-test-metrics-";
+  result += std::to_string(getpid());
+  result += '-';
+  result += suffix;
+  return result;
+}
+
+struct fixture {
+  fixture() : path(make_path("collector")) {
+    if (auto err = writer.open(path))
+      CAF_FAIL("failed to open " << path << ": " << err);
+  }
+
+  shared_memory_reader::snapshot read() {
+    if (!reader.is_open())
+      if (auto err = reader.open(path))
+        CAF_FAIL("failed to open " << path << ": " << err);
+    auto res = reader.read();
+    if (!res)
+      CAF_FAIL("failed to read " << path << ": " << res.error());
+    return std::move(*res);
+  }
+
+  std::string path;
+  collector::shared_memory writer;
+  shared_memory_reader reader;
+  metric_registry registry;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(shared_memory_tests, fixture)
+
+CAF_TEST(readers receive all metrics from the writer) {
+  auto fb = registry.gauge_family("foo", "bar", {},
+                                  "Some value without labels.", "seconds");
+  auto sv = registry.gauge_family<double>("some", "value", {"a", "b"},
+                                          "Some value with two labels.", "1",
+                                          true);
+  std::vector<int64_t> upper_bounds{1, 2, 4};
+  auto sr = registry.histogram_family("some", "request-duration", {"x"},
+                                      upper_bounds, "Some help.", "seconds");
+  fb->get_or_add({})->value(123);
+  sv->get_or_add({{"a", "1"}, {"b", "2"}})->value(2.5);
+  auto h = sr->get_or_add({{"x", "get"}});
+  h->observe(3);
+  h->observe(4);
+  h->observe(7);
+  CHECK_EQ(writer.collect_from(registry, timestamp{42s}), none);
+  auto snapshot = read();
+  CHECK_EQ(snapshot.last_update, timestamp{42s});
+  if (!CHECK_EQ(snapshot.samples.size(), 3u))
+    return;
+  auto& x = snapshot.samples[0];
+  CHECK_EQ(x.type, metric_type::int_gauge);
+  CHECK_EQ(x.prefix, "foo");
+  CHECK_EQ(x.name, "bar");
+  CHECK_EQ(x.unit, "seconds");
+  CHECK_EQ(x.helptext, "Some value without labels.");
+  CHECK(!x.is_sum);
+  CHECK(x.labels.empty());
+  CHECK_EQ(x.int_value, 123);
+  auto& y = snapshot.samples[1];
+  CHECK_EQ(y.type, metric_type::dbl_gauge);
+  CHECK(y.is_sum);
+  if (CHECK_EQ(y.labels.size(), 2u)) {
+    CHECK_EQ(y.labels[0].first, "a");
+    CHECK_EQ(y.labels[0].second, "1");
+    CHECK_EQ(y.labels[1].first, "b");
+    CHECK_EQ(y.labels[1].second, "2");
+  }
+  CHECK_EQ(y.dbl_value, 2.5);
+  auto& z = snapshot.samples[2];
+  CHECK_EQ(z.type, metric_type::int_histogram);
+  CHECK_EQ(z.int_value, 14);
+  if (CHECK_EQ(z.buckets.size(), 4u)) {
+    CHECK_EQ(z.buckets[0].upper_bound, 1.0);
+    CHECK_EQ(z.buckets[1].upper_bound, 2.0);
+    CHECK_EQ(z.buckets[2].upper_bound, 4.0);
+    CHECK_EQ(z.buckets[3].upper_bound,
+             std::numeric_limits<double>::infinity());
+    CHECK_EQ(z.buckets[0].count, 0);
+    CHECK_EQ(z.buckets[1].count, 0);
+    CHECK_EQ(z.buckets[2].count, 2);
+    CHECK_EQ(z.buckets[3].count, 1);
+  }
+}
+
+CAF_TEST(readers observe updated values and new instances) {
+  auto fam = registry.counter_family("foo", "events", {"kind"}, "Events.");
+  auto a = fam->get_or_add({{"kind", "a"}});
+  a->inc(1);
+  CHECK_EQ(writer.collect_from(registry, timestamp{1s}), none);
+  auto snapshot = read();
+  if (CHECK_EQ(snapshot.samples.size(), 1u))
+    CHECK_EQ(snapshot.samples[0].int_value, 1);
+  MESSAGE("updating values keeps the layout");
+  a->inc(10);
+  CHECK_EQ(writer.collect_from(registry, timestamp{2s}), none);
+  snapshot = read();
+  CHECK_EQ(snapshot.last_update, timestamp{2s});
+  if (CHECK_EQ(snapshot.samples.size(), 1u))
+    CHECK_EQ(snapshot.samples[0].int_value, 11);
+  MESSAGE("adding instances rewrites the layout");
+  for (int i = 0; i < 1000; ++i)
+    fam->get_or_add({{"kind", std::to_string(i)}})->inc(i);
+  CHECK_EQ(writer.collect_from(registry, timestamp{3s}), none);
+  snapshot = read();
+  if (CHECK_EQ(snapshot.samples.size(), 1001u)) {
+    CHECK_EQ(snapshot.samples[0].int_value, 11);
+    CHECK_EQ(snapshot.samples[1000].labels[0].second, "999");
+    CHECK_EQ(snapshot.samples[1000].int_value, 999);
+  }
+}
+
+CAF_TEST(readers never observe inconsistent values) {
+  std::vector<double> upper_bounds{1., 2.};
+  auto fam = registry.histogram_family<double>("foo", "latency", {},
+                                               upper_bounds, "Latency.",
+                                               "seconds");
+  auto h = fam->get_or_add({});
+  CHECK_EQ(writer.collect_from(registry), none);
+  read();
+  std::atomic<bool> done = false;
+  std::thread bg{[&] {
+    for (int i = 0; i < 2000; ++i) {
+      h->observe(1.0);
+      std::ignore = writer.collect_from(registry);
+    }
+    done = true;
+  }};
+  size_t failures = 0;
+  while (!done) {
+    auto res = reader.read();
+    if (!res || res->samples.size() != 1) {
+      ++failures;
+      continue;
+    }
+    auto& x = res->samples[0];
+    if (x.buckets.size() != 3
+        || static_cast<double>(x.buckets[0].count) != x.dbl_value)
+      ++failures;
+  }
+  bg.join();
+  CHECK_EQ(failures, 0u);
+}
+
+CAF_TEST(readers reject missing and malformed files) {
+  shared_memory_reader other;
+  CHECK_NE(other.open(make_path("missing")), none);
+  CHECK(!other.is_open());
+  auto bad_path = make_path("malformed");
+  if (auto f = fopen(bad_path.c_str(), "w")) {
+    std::string content(256, 'x');
+    fwrite(content.data(), 1, content.size(), f);
+    fclose(f);
+  }
+  CHECK_NE(other.open(bad_path), none);
+  CHECK(!other.is_open());
+  unlink(bad_path.c_str());
+}
+
+CAF_TEST(readers detect a removed file) {
+  CHECK_EQ(writer.collect_from(registry), none);
+  read();
+  writer.close();
+  CHECK(!reader.read());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(actor systems publish metrics when setting caf.metrics-shm.path) {
+  auto path = make_path("system");
+  actor_system_config cfg;
+  cfg.set("caf.metrics-shm.path", path);
+  cfg.set("caf.metrics-shm.interval", timespan{10ms});
+  {
+    actor_system sys{cfg};
+    shared_memory_reader reader;
+    if (auto err = reader.open(path))
+      CAF_FAIL("failed to open " << path << ": " << err);
+    auto res = reader.read();
+    if (CHECK(res))
+      CHECK(!res->samples.empty());
+  }
+  MESSAGE("the actor system removes the file on shutdown");
+  shared_memory_reader reader;
+  CHECK_NE(reader.open(path), none);
+}
+
+#  ifdef CAF_ENABLE_MEMORY_POOL
+
+CAF_TEST(actor systems publish memory pool statistics to shared memory) {
+  auto path = make_path("pool");
+  actor_system_config cfg;
+  cfg.set("caf.metrics-shm.path", path);
+  actor_system sys{cfg};
+  shared_memory_reader reader;
+  if (auto err = reader.open(path))
+    CAF_FAIL("failed to open " << path << ": " << err);
+  auto res = reader.read();
+  REQUIRE(res);
+  auto is_pool_allocations = [](const shared_memory_reader::sample& x) {
+    return x.prefix == "caf.memory-pool" && x.name == "allocations";
+  };
+  auto i = std::find_if(res->samples.begin(), res->samples.end(),
+                        is_pool_allocations);
+  if (CHECK(i != res->samples.end())) {
+    CHECK_EQ(i->type, metric_type::int_counter);
+    CHECK(i->is_sum);
+  }
+}
+
+#  endif // CAF_ENABLE_MEMORY_POOL
+
+#else // CAF_POSIX
+
+CAF_TEST(shared memory export is unsupported on this platform) {
+  telemetry::collector::shared_memory writer;
+  CHECK_NE(writer.open("metrics"), none);
+}
+
+#endif // CAF_POSIX
@@ -8,6 +8,9 @@
 
 #include "caf/test/dsl.hpp"
 
+#include <thread>
+#include <vector>
+
 using namespace caf;
 
 CAF_TEST(double counters can only increment) {
@@ -35,3 +38,27 @@ CAF_TEST(integer counters can only increment) {
   CAF_MESSAGE("users can create counters with custom start values");
   CAF_CHECK_EQUAL(telemetry::int_counter{42}.value(), 42);
 }
+
+CAF_TEST(counters with per-thread storage sum up the values of all threads) {
+  constexpr int64_t num_threads = 32;
+  constexpr int64_t num_increments = 1000;
+  telemetry::int_counter c{10};
+  telemetry::dbl_counter d;
+  c.enable_per_thread_storage();
+  d.enable_per_thread_storage();
+  CAF_CHECK(c.has_per_thread_storage());
+  CAF_CHECK_EQUAL(c.value(), 10);
+  CAF_CHECK_EQUAL(++c, 11);
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < num_threads; ++i)
+    threads.emplace_back([&c, &d] {
+      for (int64_t j = 0; j < num_increments; ++j) {
+        c.inc();
+        d.inc(.5);
+      }
+    });
+  for (auto& t : threads)
+    t.join();
+  CAF_CHECK_EQUAL(c.value(), 11 + num_threads * num_increments);
+  CAF_CHECK_EQUAL(d.value(), num_threads * num_increments * .5);
+}
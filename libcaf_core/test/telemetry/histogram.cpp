@@ -10,6 +10,8 @@
 
 #include <cmath>
 #include <limits>
+#include <thread>
+#include <vector>
 
 #include "caf/telemetry/gauge.hpp"
 
@@ -45,3 +47,78 @@ CAF_TEST(histograms aggregate to buckets and keep a sum) {
   CAF_CHECK_EQUAL(buckets[3].count.value(), 2); // 9, 10
   CAF_CHECK_EQUAL(h1.sum(), 55);
 }
+
+CAF_TEST(histograms with per-thread storage merge the values of all threads) {
+  constexpr int64_t num_threads = 8;
+  int_histogram h1{2, 4, 8};
+  h1.enable_per_thread_storage();
+  CAF_CHECK(h1.has_per_thread_storage());
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < num_threads; ++i)
+    threads.emplace_back([&h1] {
+      for (int64_t value = 1; value < 11; ++value)
+        h1.observe(value);
+    });
+  for (auto& t : threads)
+    t.join();
+  auto buckets = h1.buckets();
+  CAF_REQUIRE_EQUAL(buckets.size(), 4u);
+  CAF_CHECK_EQUAL(buckets[0].count.value(), 2 * num_threads);
+  CAF_CHECK_EQUAL(buckets[1].count.value(), 2 * num_threads);
+  CAF_CHECK_EQUAL(buckets[2].count.value(), 4 * num_threads);
+  CAF_CHECK_EQUAL(buckets[3].count.value(), 2 * num_threads);
+  CAF_CHECK_EQUAL(h1.sum(), 55 * num_threads);
+}
+
+CAF_TEST(histograms with log-linear bucket layouts find buckets directly) {
+  log_linear_layout<int64_t> layout{10, 2};
+  int_histogram h1{layout};
+  int_histogram h2{1, 5, 10, 50};
+  CAF_CHECK(h1.layout().has_value());
+  CAF_CHECK(!h2.layout().has_value());
+  CAF_REQUIRE_EQUAL(h1.buckets().size(), layout.size() + 1);
+  for (int64_t value = -1; value < 1100; ++value)
+    h1.observe(value);
+  auto buckets = h1.buckets();
+  CAF_CHECK_EQUAL(buckets[0].count.value(), 3); // -1, 0, 1
+  CAF_CHECK_EQUAL(buckets[1].count.value(), 1); // 2
+  CAF_CHECK_EQUAL(buckets[8].count.value(), 2); // 9, 10
+  CAF_CHECK_EQUAL(buckets.back().count.value(), 1099 - 1024);
+  int64_t total = 0;
+  for (auto& bucket : buckets)
+    total += bucket.count.value();
+  CAF_CHECK_EQUAL(total, 1101);
+}
+
+CAF_TEST(histograms estimate quantiles from their buckets) {
+  dbl_histogram h1{1., 2., 3., 4.};
+  CAF_CHECK(std::isnan(h1.quantile(.5)));
+  for (int i = 0; i < 10; ++i) {
+    h1.observe(.5);
+    h1.observe(1.5);
+    h1.observe(2.5);
+    h1.observe(3.5);
+  }
+  CAF_CHECK_EQUAL(h1.quantile(0.), 0.);
+  CAF_CHECK_EQUAL(h1.quantile(.25), 1.);
+  CAF_CHECK_EQUAL(h1.quantile(.5), 2.);
+  CAF_CHECK_EQUAL(h1.quantile(.625), 2.5);
+  CAF_CHECK_EQUAL(h1.quantile(1.), 4.);
+  h1.observe(100.);
+  CAF_CHECK_EQUAL(h1.quantile(1.), 4.);
+}
+
+CAF_TEST(log-linear layouts bound the relative error of quantiles) {
+  log_linear_layout<double> layout{-20, 10, 4};
+  dbl_histogram h1{layout};
+  std::vector<double> values;
+  for (int i = 1; i <= 1000; ++i)
+    values.emplace_back(std::exp2(i / 100.) / 1000.);
+  for (auto value : values)
+    h1.observe(value);
+  for (auto q : {.1, .5, .9, .99}) {
+    auto expected = values[static_cast<size_t>(q * values.size()) - 1];
+    auto estimate = h1.quantile(q);
+    CAF_CHECK_LESS_OR_EQUAL(std::abs(estimate - expected) / expected, 1. / 16);
+  }
+}
@@ -0,0 +1,123 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE telemetry.log_linear_layout
+
+#include "caf/telemetry/log_linear_layout.hpp"
+
+#include "core-test.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace caf;
+using namespace caf::telemetry;
+
+namespace {
+
+// Computes the bucket index by scanning all upper bounds.
+template <class T>
+size_t scan(const std::vector<T>& bounds, T value) {
+  size_t index = 0;
+  while (index < bounds.size() && value > bounds[index])
+    ++index;
+  return index;
+}
+
+} // namespace
+
+CAF_TEST(double layouts split each power of two into equal buckets) {
+  log_linear_layout<double> layout{-3, 0, 2};
+  std::vector<double> expected{.125,   .15625, .1875, .21875, .25,
+                               .3125,  .375,   .4375, .5,     .625,
+                               .75,    .875,   1.0};
+  CHECK_EQ(layout.size(), 13u);
+  CHECK_EQ(layout.upper_bounds(), expected);
+}
+
+CAF_TEST(integer layouts start with buckets of width one) {
+  log_linear_layout<int64_t> layout{5, 2};
+  std::vector<int64_t> expected{1,  2,  3,  4,  5,  6,  7,  8,  10, 12, 14, 16,
+                                20, 24, 28, 32};
+  CHECK_EQ(layout.size(), 16u);
+  CHECK_EQ(layout.upper_bounds(), expected);
+}
+
+CAF_TEST(double layouts compute the same buckets as a linear scan) {
+  log_linear_layout<double> layout{-20, 10, 3};
+  auto bounds = layout.upper_bounds();
+  for (auto bound : bounds) {
+    CHECK_EQ(layout.index_of(bound), scan(bounds, bound));
+    auto above = std::nextafter(bound, 2 * bound);
+    CHECK_EQ(layout.index_of(above), scan(bounds, above));
+  }
+  std::minstd_rand rng{42};
+  std::uniform_real_distribution<double> exponents{-22., 12.};
+  for (int i = 0; i < 1000; ++i) {
+    auto value = std::exp2(exponents(rng));
+    CHECK_EQ(layout.index_of(value), scan(bounds, value));
+  }
+  CHECK_EQ(layout.index_of(0.), 0u);
+  CHECK_EQ(layout.index_of(-1.), 0u);
+  CHECK_EQ(layout.index_of(std::nan("")), 0u);
+  CHECK_EQ(layout.index_of(HUGE_VAL), bounds.size());
+}
+
+CAF_TEST(integer layouts compute the same buckets as a linear scan) {
+  log_linear_layout<int64_t> layout{40, 4};
+  auto bounds = layout.upper_bounds();
+  for (auto bound : bounds) {
+    CHECK_EQ(layout.index_of(bound), scan(bounds, bound));
+    CHECK_EQ(layout.index_of(bound + 1), scan(bounds, bound + 1));
+  }
+  std::minstd_rand rng{42};
+  std::uniform_int_distribution<int> exponents{0, 42};
+  for (int i = 0; i < 1000; ++i) {
+    std::uniform_int_distribution<int64_t> values{0, int64_t{1}
+                                                       << exponents(rng)};
+    auto value = values(rng);
+    CHECK_EQ(layout.index_of(value), scan(bounds, value));
+  }
+  CHECK_EQ(layout.index_of(0), 0u);
+  CHECK_EQ(layout.index_of(-10), 0u);
+  CHECK_EQ(layout.index_of(INT64_MAX), bounds.size());
+}
+
+CAF_TEST(the relative width of each bucket is bounded by the precision) {
+  log_linear_layout<double> layout{-10, 10, 4};
+  auto bounds = layout.upper_bounds();
+  for (size_t index = 1; index < bounds.size(); ++index) {
+    auto width = bounds[index] - bounds[index - 1];
+    CHECK_LE(width / bounds[index - 1], 1. / 16);
+  }
+}
+
+CAF_TEST(layouts are recognizable from their upper bounds) {
+  MESSAGE("upper bounds from a layout produce the same layout");
+  log_linear_layout<double> dbl_layout{-17, 3, 3};
+  auto dbl_bounds = dbl_layout.upper_bounds();
+  if (auto res = log_linear_layout<double>::from_upper_bounds(dbl_bounds)) {
+    CHECK_EQ(res->min_exponent(), -17);
+    CHECK_EQ(res->max_exponent(), 3);
+    CHECK_EQ(res->precision(), 3);
+  } else {
+    CAF_FAIL("failed to recognize a log-linear layout");
+  }
+  log_linear_layout<int64_t> int_layout{30, 5};
+  auto int_bounds = int_layout.upper_bounds();
+  if (auto res = log_linear_layout<int64_t>::from_upper_bounds(int_bounds)) {
+    CHECK_EQ(res->max_exponent(), 30);
+    CHECK_EQ(res->precision(), 5);
+  } else {
+    CAF_FAIL("failed to recognize a log-linear layout");
+  }
+  MESSAGE("other upper bounds produce no layout");
+  std::vector<double> xs{.001, .01, .1, 1.};
+  CHECK(!log_linear_layout<double>::from_upper_bounds(xs));
+  std::vector<int64_t> ys{1, 2, 3, 5};
+  CHECK(!log_linear_layout<int64_t>::from_upper_bounds(ys));
+  dbl_bounds.pop_back();
+  CHECK(!log_linear_layout<double>::from_upper_bounds(dbl_bounds));
+}
@@ -8,6 +8,9 @@
 
 #include "core-test.hpp"
 
+#include <thread>
+#include <vector>
+
 #include "caf/string_view.hpp"
 #include "caf/telemetry/counter.hpp"
 #include "caf/telemetry/gauge.hpp"
@@ -182,6 +185,23 @@ CAF_TEST(buckets for histograms are configurable via runtime settings) {
   CAF_CHECK_EQUAL(bounds(h2->buckets()), alternative_upper_bounds);
 }
 
+CAF_TEST(per-thread storage is configurable per family via runtime settings) {
+  settings cfg;
+  put(cfg, "caf.requests.per-thread-storage", true);
+  put(cfg, "caf.response-time.per-thread-storage", true);
+  registry.config(&cfg);
+  auto requests = registry.counter_family("caf", "requests", {"method"},
+                                          "Number of requests.");
+  CAF_CHECK(requests->per_thread_storage());
+  CAF_CHECK(requests->get_or_add({{"method", "get"}})->has_per_thread_storage());
+  auto errors = registry.counter_singleton("caf", "errors", "Number of errors.");
+  CAF_CHECK(!errors->has_per_thread_storage());
+  std::vector<int64_t> upper_bounds{1, 2, 4, 8};
+  auto response_time = registry.histogram_singleton(
+    "caf", "response-time", upper_bounds, "How long take requests?");
+  CAF_CHECK(response_time->has_per_thread_storage());
+}
+
 CAF_TEST(counter_instance is a shortcut for using the family manually) {
   auto fptr = registry.counter_family("http", "requests", {"method"},
                                       "Number of HTTP requests.", "seconds",
@@ -193,6 +213,34 @@ CAF_TEST(counter_instance is a shortcut for using the family manually) {
   CAF_CHECK_EQUAL(count, count2);
 }
 
+CAF_TEST(families return the same instance for concurrent lookups) {
+  auto fptr = registry.counter_family("http", "requests", {"method", "path"},
+                                      "Number of HTTP requests.");
+  auto lookup = [fptr](size_t i, size_t j) {
+    auto method = "m" + std::to_string(i);
+    auto path = "/p" + std::to_string(j);
+    return fptr->get_or_add({{"path", path}, {"method", method}});
+  };
+  std::vector<std::thread> threads;
+  for (int n = 0; n < 4; ++n) {
+    threads.emplace_back([lookup] {
+      for (size_t i = 0; i < 20; ++i)
+        for (size_t j = 0; j < 20; ++j)
+          lookup(i, j)->inc();
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+  size_t num_instances = 0;
+  auto f = [&](auto*, auto*, auto* instance) {
+    ++num_instances;
+    CHECK_EQ(instance->value(), 4);
+  };
+  fptr->collect(f);
+  CHECK_EQ(num_instances, 400u);
+  CHECK_EQ(lookup(3, 7), fptr->get_or_add({{"method", "m3"}, {"path", "/p7"}}));
+}
+
 SCENARIO("metric registries can merge families from other registries") {
   GIVEN("a registry with some metrics") {
     metric_registry tmp;
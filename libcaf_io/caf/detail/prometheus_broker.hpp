@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ctime>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -16,9 +17,22 @@
 
 namespace caf::detail {
 
-/// Makes system metrics in the Prometheus format available via HTTP 1.1.
+/// Makes system metrics in the Prometheus format available via HTTP 1.1. The
+/// broker sends the scrape result in chunks of `chunk_size` bytes via chunked
+/// transfer encoding and only writes the next chunk after the socket has
+/// transferred most of the previous one.
 class CAF_IO_EXPORT prometheus_broker : public io::broker {
 public:
+  /// Stores the scrape result for a pending response and the number of bytes
+  /// the broker has written so far.
+  struct response_state {
+    std::shared_ptr<telemetry::collector::prometheus::char_buffer> text;
+    size_t offset;
+  };
+
+  /// Maximum size of a single chunk in an HTTP response.
+  static constexpr size_t chunk_size = 64 * 1024;
+
   explicit prometheus_broker(actor_config& cfg);
 
   prometheus_broker(actor_config& cfg, io::doorman_ptr ptr);
@@ -34,8 +48,23 @@ public:
 private:
   void scrape();
 
+  /// Writes the next chunk of the scrape result to `hdl` or finishes the
+  /// response and closes the connection if no data remains.
+  void send_chunk(io::connection_handle hdl);
+
+  /// Closes the connection and terminates the broker after closing the last
+  /// connection.
+  void close_connection(io::connection_handle hdl);
+
   std::unordered_map<io::connection_handle, byte_buffer> requests_;
+  /// Stores the state of all pending responses. Each response keeps the
+  /// scrape result it started with, so slow clients never delay new scrapes.
+  std::unordered_map<io::connection_handle, response_state> responses_;
   telemetry::collector::prometheus collector_;
+  /// Stores the latest scrape result. The broker hands its memory back to the
+  /// collector for the next scrape unless a pending response still refers to
+  /// it.
+  std::shared_ptr<telemetry::collector::prometheus::char_buffer> snapshot_;
   time_t last_scrape_ = 0;
   telemetry::dbl_gauge* cpu_time_ = nullptr;
   telemetry::int_gauge* mem_size_ = nullptr;
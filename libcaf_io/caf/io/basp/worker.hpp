@@ -50,6 +50,12 @@ public:
   void launch(const node_id& last_hop, const basp::header& hdr,
               const byte_buffer& payload);
 
+  /// Like `launch`, but schedules the worker via `ctx` unless `ctx` is
+  /// `nullptr`. Allows the multiplexer to submit all workers it launches
+  /// during a single event loop iteration at once.
+  void launch(execution_unit* ctx, const node_id& last_hop,
+              const basp::header& hdr, const byte_buffer& payload);
+
   // -- implementation of resumable --------------------------------------------
 
   resume_result resume(execution_unit* ctx, size_t) override;
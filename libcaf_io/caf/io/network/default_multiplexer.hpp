@@ -218,6 +218,9 @@ private:
 
   void wr_dispatch_request(resumable* ptr);
 
+  /// Hands all jobs in `scheduled_` to the scheduler at once.
+  void flush_scheduled();
+
   /// Socket handle to an OS-level event loop such as `epoll`. Unused in the
   /// `poll` implementation.
   native_socket epollfd_; // unused in poll() implementation
@@ -244,6 +247,10 @@ private:
   /// `wr_dispatch_request` when the pipe's buffer is full.
   std::vector<intrusive_ptr<resumable>> internally_posted_;
 
+  /// Jobs for the scheduler that the multiplexer collects during one
+  /// iteration of its event loop in order to submit them in bulk.
+  std::vector<resumable*> scheduled_;
+
   /// Sequential ids for handles of datagram servants
   int64_t servant_ids_;
 
@@ -4,6 +4,9 @@
 
 #include "caf/detail/prometheus_broker.hpp"
 
+#include <algorithm>
+#include <cstdio>
+
 #include "caf/span.hpp"
 #include "caf/string_algorithms.hpp"
 #include "caf/string_view.hpp"
@@ -169,8 +172,17 @@ constexpr string_view request_not_supported = "HTTP/1.1 501 Not Implemented\r\n"
 // HTTP header when sending a payload.
 constexpr string_view request_ok = "HTTP/1.1 200 OK\r\n"
                                    "Content-Type: text/plain\r\n"
+                                   "Transfer-Encoding: chunked\r\n"
                                    "Connection: Closed\r\n\r\n";
 
+// Marks the end of a response with chunked transfer encoding.
+constexpr string_view last_chunk = "0\r\n\r\n";
+
+void append(byte_buffer& buf, string_view str) {
+  auto bytes = as_bytes(make_span(str));
+  buf.insert(buf.end(), bytes.begin(), bytes.end());
+}
+
 } // namespace
 
 prometheus_broker::prometheus_broker(actor_config& cfg) : io::broker(cfg) {
@@ -213,11 +225,11 @@ behavior prometheus_broker::make_behavior() {
     [=](const io::new_data_msg& msg) {
       auto flush_and_close = [this, &msg] {
         flush(msg.handle);
-        close(msg.handle);
-        requests_.erase(msg.handle);
-        if (num_connections() + num_doormen() == 0)
-          quit();
+        close_connection(msg.handle);
       };
+      // Ignore any data after a complete request.
+      if (responses_.count(msg.handle) > 0)
+        return;
       auto& req = requests_[msg.handle];
       if (req.size() + msg.buf.size() > max_request_size) {
         write(msg.handle, as_bytes(make_span(request_too_large)));
@@ -237,15 +249,27 @@ behavior prometheus_broker::make_behavior() {
         flush_and_close();
         return;
       }
-      // Collect metrics, ship response, and close.
+      // Collect metrics and take over the result from the collector. The
+      // collector renders the next scrape into the memory of the previous
+      // snapshot unless a pending response still refers to it.
       scrape();
-      auto hdr = as_bytes(make_span(request_ok));
-      auto text = collector_.collect_from(system().metrics());
-      auto payload = as_bytes(make_span(text));
-      auto& dst = wr_buf(msg.handle);
-      dst.insert(dst.end(), hdr.begin(), hdr.end());
-      dst.insert(dst.end(), payload.begin(), payload.end());
-      flush_and_close();
+      collector_.collect_from(system().metrics());
+      using char_buffer = telemetry::collector::prometheus::char_buffer;
+      if (!snapshot_ || snapshot_.use_count() > 1)
+        snapshot_ = std::make_shared<char_buffer>();
+      snapshot_->clear();
+      collector_.swap_buffer(*snapshot_);
+      // Ship the response in chunks and close when done.
+      requests_.erase(msg.handle);
+      responses_.emplace(msg.handle, response_state{snapshot_, 0});
+      append(wr_buf(msg.handle), request_ok);
+      ack_writes(msg.handle, true);
+      send_chunk(msg.handle);
+    },
+    [=](const io::data_transferred_msg& msg) {
+      // Keep at most two chunks in the send buffer.
+      if (msg.remaining < chunk_size)
+        send_chunk(msg.handle);
     },
     [=](const io::new_connection_msg& msg) {
       // Pre-allocate buffer for maximum request size.
@@ -255,6 +279,7 @@ behavior prometheus_broker::make_behavior() {
     },
     [=](const io::connection_closed_msg& msg) {
       requests_.erase(msg.handle);
+      responses_.erase(msg.handle);
       if (num_connections() + num_doormen() == 0)
         quit();
     },
@@ -266,7 +291,42 @@ behavior prometheus_broker::make_behavior() {
   };
 }
 
+void prometheus_broker::send_chunk(io::connection_handle hdl) {
+  auto i = responses_.find(hdl);
+  if (i == responses_.end())
+    return;
+  auto& buf = *i->second.text;
+  auto text = string_view{buf.data(), buf.size()};
+  auto& offset = i->second.offset;
+  auto& dst = wr_buf(hdl);
+  if (offset < text.size()) {
+    auto len = std::min(chunk_size, text.size() - offset);
+    char size_line[24];
+    auto n = snprintf(size_line, sizeof(size_line), "%zx\r\n", len);
+    append(dst, string_view{size_line, static_cast<size_t>(n)});
+    append(dst, text.substr(offset, len));
+    append(dst, "\r\n");
+    offset += len;
+  }
+  if (offset < text.size()) {
+    flush(hdl);
+    return;
+  }
+  append(dst, last_chunk);
+  flush(hdl);
+  responses_.erase(i);
+  close_connection(hdl);
+}
+
+void prometheus_broker::close_connection(io::connection_handle hdl) {
+  close(hdl);
+  requests_.erase(hdl);
+  if (num_connections() + num_doormen() == 0)
+    quit();
+}
+
 void prometheus_broker::scrape() {
+  system().update_memory_pool_metrics();
 #ifdef HAS_PROCESS_METRICS
   // Collect system metrics at most once per second.
   auto now = time(NULL);
@@ -424,7 +424,7 @@ connection_state instance::handle(execution_unit* ctx, connection_handle hdl,
       if (worker != nullptr) {
         CAF_LOG_DEBUG("launch BASP worker for deserializing a"
                       << hdr.operation);
-        worker->launch(last_hop, hdr, *payload);
+        worker->launch(ctx, last_hop, hdr, *payload);
       } else {
         CAF_LOG_DEBUG("out of BASP workers, continue deserializing a"
                       << hdr.operation);
@@ -5,6 +5,7 @@
 #include "caf/io/basp/worker.hpp"
 
 #include "caf/actor_system.hpp"
+#include "caf/execution_unit.hpp"
 #include "caf/io/basp/message_queue.hpp"
 #include "caf/proxy_registry.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
@@ -26,6 +27,11 @@ worker::~worker() {
 
 void worker::launch(const node_id& last_hop, const basp::header& hdr,
                     const byte_buffer& payload) {
+  launch(nullptr, last_hop, hdr, payload);
+}
+
+void worker::launch(execution_unit* ctx, const node_id& last_hop,
+                    const basp::header& hdr, const byte_buffer& payload) {
   CAF_ASSERT(hdr.dest_actor != 0);
   CAF_ASSERT(hdr.operation == basp::message_type::direct_message
              || hdr.operation == basp::message_type::routed_message);
@@ -34,7 +40,10 @@ void worker::launch(const node_id& last_hop, const basp::header& hdr,
   memcpy(&hdr_, &hdr, sizeof(basp::header));
   payload_.assign(payload.begin(), payload.end());
   ref();
-  system_->scheduler().enqueue(this);
+  if (ctx != nullptr)
+    ctx->exec_later(this);
+  else
+    system_->scheduler().enqueue(this);
 }
 
 // -- implementation of resumable ----------------------------------------------
@@ -21,6 +21,7 @@
 #include "caf/io/network/scribe_impl.hpp"
 
 #include "caf/detail/call_cfun.hpp"
+#include "caf/detail/scope_guard.hpp"
 #include "caf/detail/socket_guard.hpp"
 
 #include "caf/scheduler/abstract_coordinator.hpp"
@@ -581,6 +582,9 @@ void default_multiplexer::init() {
 
 bool default_multiplexer::poll_once(bool block) {
   CAF_LOG_TRACE(CAF_ARG(block));
+  // Never block while holding back jobs for the scheduler.
+  flush_scheduled();
+  auto guard = detail::make_scope_guard([this] { flush_scheduled(); });
   if (!internally_posted_.empty()) {
     // Don't iterate internally_posted_ directly, because resumables can
     // enqueue new elements into it.
@@ -616,6 +620,8 @@ void default_multiplexer::resume(intrusive_ptr<resumable> ptr) {
 }
 
 default_multiplexer::~default_multiplexer() {
+  for (auto ptr : scheduled_)
+    scheduler::abstract_coordinator::cleanup_and_release(ptr);
   if (epollfd_ != invalid_native_socket)
     close_socket(epollfd_);
   // close write handle first
@@ -647,10 +653,21 @@ void default_multiplexer::exec_later(resumable* ptr) {
         internally_posted_.emplace_back(ptr, false);
       break;
     default:
-      system().scheduler().enqueue(ptr);
+      if (std::this_thread::get_id() != thread_id())
+        system().scheduler().enqueue(ptr);
+      else
+        scheduled_.emplace_back(ptr);
   }
 }
 
+void default_multiplexer::flush_scheduled() {
+  if (scheduled_.empty())
+    return;
+  CAF_LOG_DEBUG("schedule" << scheduled_.size() << "jobs in bulk");
+  system().scheduler().bulk_enqueue(scheduled_);
+  scheduled_.clear();
+}
+
 scribe_ptr default_multiplexer::new_scribe(native_socket fd) {
   CAF_LOG_TRACE("");
   keepalive(fd, true);
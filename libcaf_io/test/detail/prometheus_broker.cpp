@@ -8,6 +8,10 @@
 
 #include "io-test.hpp"
 
+#include <optional>
+#include <string>
+#include <utility>
+
 #include "caf/io/network/default_multiplexer.hpp"
 #include "caf/policy/tcp.hpp"
 
@@ -56,8 +60,33 @@ constexpr string_view http_request
 
 constexpr string_view http_ok_header = "HTTP/1.1 200 OK\r\n"
                                        "Content-Type: text/plain\r\n"
+                                       "Transfer-Encoding: chunked\r\n"
                                        "Connection: Closed\r\n\r\n";
 
+// Decodes a response body with chunked transfer encoding and returns the
+// payload plus the number of chunks.
+std::optional<std::pair<std::string, size_t>> dechunk(string_view body) {
+  std::string payload;
+  size_t num_chunks = 0;
+  for (;;) {
+    auto eol = body.find("\r\n");
+    if (eol == string_view::npos || eol == 0)
+      return std::nullopt;
+    auto size = std::stoul(std::string(body.data(), eol), nullptr, 16);
+    body.remove_prefix(eol + 2);
+    if (size == 0) {
+      if (body != "\r\n")
+        return std::nullopt;
+      return std::make_pair(std::move(payload), num_chunks);
+    }
+    if (body.size() < size + 2 || body.substr(size, 2) != "\r\n")
+      return std::nullopt;
+    payload.insert(payload.end(), body.begin(), body.begin() + size);
+    body.remove_prefix(size + 2);
+    ++num_chunks;
+  }
+}
+
 } // namespace
 
 CAF_TEST_FIXTURE_SCOPE(prometheus_broker_tests, fixture)
@@ -78,6 +107,53 @@ CAF_TEST(the prometheus broker responds to HTTP get requests) {
   }
 }
 
+CAF_TEST(the prometheus broker sends its response in chunks) {
+  auto bytes = as_bytes(make_span(http_request));
+  mpx.virtual_send(connection, byte_buffer{bytes.begin(), bytes.end()});
+  run();
+  auto& response_buf = mpx.output_buffer(connection);
+  string_view response{reinterpret_cast<char*>(response_buf.data()),
+                       response_buf.size()};
+  CAF_REQUIRE(starts_with(response, http_ok_header));
+  response.remove_prefix(http_ok_header.size());
+  if (auto body = dechunk(response)) {
+    CAF_CHECK_EQUAL(body->second, 1u);
+    CAF_CHECK(contains(body->first, "\ncaf_system_running_actors 2 "));
+  } else {
+    CAF_FAIL("response contains no valid chunked body");
+  }
+}
+
+CAF_TEST(stalled clients do not delay scrapes for other clients) {
+  auto family = sys.metrics().counter_family("test", "instances", {"id"},
+                                             "Test metric.");
+  for (int id = 0; id < 5000; ++id)
+    family->get_or_add({{"id", std::to_string(id)}})->inc(id);
+  auto bytes = as_bytes(make_span(http_request));
+  MESSAGE("the first client never reads past the first chunk");
+  mpx.virtual_send(connection, byte_buffer{bytes.begin(), bytes.end()});
+  run();
+  auto& first_buf = mpx.output_buffer(connection);
+  string_view first{reinterpret_cast<char*>(first_buf.data()),
+                    first_buf.size()};
+  CAF_REQUIRE(starts_with(first, http_ok_header));
+  CAF_CHECK(!contains(first, "0\r\n\r\n"));
+  MESSAGE("a second client receives a fresh scrape result");
+  family->get_or_add({{"id", "0"}})->inc(42);
+  auto other = connection_handle::from_int(2);
+  mpx.add_pending_connect(acceptor, other);
+  mpx.accept_connection(acceptor);
+  run();
+  mpx.virtual_send(other, byte_buffer{bytes.begin(), bytes.end()});
+  run();
+  auto& second_buf = mpx.output_buffer(other);
+  string_view second{reinterpret_cast<char*>(second_buf.data()),
+                     second_buf.size()};
+  CAF_REQUIRE(starts_with(second, http_ok_header));
+  CAF_CHECK(contains(second, "\ntest_instances{id=\"0\"} 42 "));
+  CAF_CHECK(contains(first, "\ntest_instances{id=\"0\"} 0 "));
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
 
 namespace {
@@ -142,3 +218,38 @@ SCENARIO("setting caf.middleman.prometheus-http.port exports metrics to HTTP") {
     }
   }
 }
+
+SCENARIO("the prometheus broker splits large responses into multiple chunks") {
+  GIVEN("an actor system with many metric instances") {
+    actor_system_config cfg;
+    cfg.load<io::middleman>();
+    cfg.set("caf.scheduler.max-threads", 2);
+    cfg.set("caf.middleman.prometheus-http.port", 0);
+    actor_system sys{cfg};
+    auto family = sys.metrics().counter_family("test", "instances", {"id"},
+                                               "Test metric.");
+    for (int id = 0; id < 5000; ++id)
+      family->get_or_add({{"id", std::to_string(id)}})->inc(id);
+    WHEN("scraping the metrics via HTTP") {
+      auto scraping_port = sys.middleman().prometheus_scraping_port();
+      REQUIRE_NE(scraping_port, 0);
+      auto response_buf = read_all(http_request, "localhost", scraping_port);
+      string_view response{reinterpret_cast<char*>(response_buf.data()),
+                           response_buf.size()};
+      THEN("the response contains all instances in multiple chunks") {
+        REQUIRE(starts_with(response, http_ok_header));
+        response.remove_prefix(http_ok_header.size());
+        if (auto body = dechunk(response)) {
+          auto min_chunks = body->first.size()
+                            / detail::prometheus_broker::chunk_size;
+          CHECK_GE(body->second, min_chunks);
+          CHECK_GT(body->second, 1u);
+          CHECK(contains(body->first, "\ntest_instances{id=\"0\"} 0 "));
+          CHECK(contains(body->first, "\ntest_instances{id=\"4999\"} 4999 "));
+        } else {
+          FAIL("response contains no valid chunked body");
+        }
+      }
+    }
+  }
+}
@@ -286,7 +286,7 @@ class expect_clause {
 public:
   explicit expect_clause(caf::scheduler::test_coordinator& sched)
     : sched_(sched), dest_(nullptr) {
-    peek_ = [=] {
+    peek_ = [this] {
       /// The extractor will call CAF_FAIL on a type mismatch, essentially
       /// performing a type check when ignoring the result.
       extract<Ts...>(dest_);
@@ -335,7 +335,7 @@ public:
     std::tuple<typename std::decay<Us>::type...> tmp{std::forward<Us>(xs)...};
     // auto tmp = std::make_tuple(std::forward<Us>(xs)...);
     // TODO: move tmp into lambda when switching to C++14
-    peek_ = [=] {
+    peek_ = [this, tmp] {
       using namespace caf::detail;
       elementwise_compare_inspector<decltype(tmp)> inspector{tmp};
       auto ys = extract<Ts...>(dest_);
@@ -484,7 +484,7 @@ class allow_clause {
 public:
   explicit allow_clause(caf::scheduler::test_coordinator& sched)
     : sched_(sched), dest_(nullptr) {
-    peek_ = [=] {
+    peek_ = [this] {
       if (dest_ != nullptr)
         return try_extract<Ts...>(dest_) != caf::none;
       return false;
@@ -520,7 +520,7 @@ public:
     //       for GCC 4.8.
     std::tuple<typename std::decay<Us>::type...> tmp{std::forward<Us>(xs)...};
     // TODO: move tmp into lambda when switching to C++14
-    peek_ = [=] {
+    peek_ = [this, tmp] {
       using namespace caf::detail;
       elementwise_compare_inspector<decltype(tmp)> inspector{tmp};
       auto ys = try_extract<Ts...>(dest_);
@@ -561,7 +561,7 @@ template <class... Ts>
 class disallow_clause {
 public:
   disallow_clause() {
-    check_ = [=] {
+    check_ = [this] {
       auto ptr = dest_->peek_at_next_mailbox_element();
       if (ptr == nullptr)
         return;
@@ -600,7 +600,7 @@ public:
     //       for GCC 4.8.
     std::tuple<typename std::decay<Us>::type...> tmp{std::forward<Us>(xs)...};
     // TODO: move tmp into lambda when switching to C++14
-    check_ = [=] {
+    check_ = [this, tmp] {
       auto ptr = dest_->peek_at_next_mailbox_element();
       if (ptr == nullptr)
         return;
@@ -791,13 +791,13 @@ public:
 
   /// Call `run()` when the next scheduled actor becomes ready.
   void run_after_next_ready_event() {
-    sched.after_next_enqueue([=] { run(); });
+    sched.after_next_enqueue([this] { run(); });
   }
 
   /// Call `run_until(predicate)` when the next scheduled actor becomes ready.
   template <class BoolPredicate>
   void run_until_after_next_ready_event(BoolPredicate predicate) {
-    sched.after_next_enqueue([=] { run_until(predicate); });
+    sched.after_next_enqueue([this, predicate] { run_until(predicate); });
   }
 
   /// Sends a request to `hdl`, then calls `run()`, and finally fetches and
@@ -0,0 +1,166 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+// Prints metrics that an actor system publishes via `caf.metrics-shm.path` in
+// the Prometheus text format.
+//
+// Usage: caf-metrics <path> [<interval in milliseconds>]
+//
+// Without an interval, caf-metrics prints the metrics once and exits.
+// Otherwise, caf-metrics prints the metrics repeatedly until the file
+// disappears.
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "caf/telemetry/metric_type.hpp"
+#include "caf/telemetry/shared_memory_reader.hpp"
+
+using namespace caf;
+using namespace caf::telemetry;
+
+namespace {
+
+using sample = shared_memory_reader::sample;
+
+bool is_dbl(const sample& x) {
+  return x.type == metric_type::dbl_counter
+         || x.type == metric_type::dbl_gauge
+         || x.type == metric_type::dbl_histogram;
+}
+
+bool is_histogram(const sample& x) {
+  return x.type == metric_type::dbl_histogram
+         || x.type == metric_type::int_histogram;
+}
+
+const char* type_name(const sample& x) {
+  switch (x.type) {
+    case metric_type::dbl_counter:
+    case metric_type::int_counter:
+      return "counter";
+    case metric_type::dbl_gauge:
+    case metric_type::int_gauge:
+      return "gauge";
+    default:
+      return "histogram";
+  }
+}
+
+// Prometheus only allows [a-zA-Z0-9_:] in metric names.
+std::string full_name(const sample& x) {
+  auto result = x.prefix;
+  result += '_';
+  result += x.name;
+  if (x.unit != "1") {
+    result += '_';
+    result += x.unit;
+  }
+  if (x.is_sum)
+    result += "_total";
+  for (auto& c : result)
+    if (c == '-' || c == '.')
+      c = '_';
+  return result;
+}
+
+// Renders doubles in fixed notation, like the Prometheus collector.
+std::string to_text(double val) {
+  if (std::isnan(val))
+    return "NaN";
+  if (std::isinf(val))
+    return std::signbit(val) ? "-Inf" : "+Inf";
+  return std::to_string(val);
+}
+
+void print_labels(const sample& x, const char* extra_name = nullptr,
+                  const std::string& extra_value = std::string{}) {
+  if (x.labels.empty() && extra_name == nullptr)
+    return;
+  std::cout << '{';
+  auto sep = "";
+  for (auto& [key, val] : x.labels) {
+    std::cout << sep << key << "=\"" << val << '"';
+    sep = ",";
+  }
+  if (extra_name != nullptr)
+    std::cout << sep << extra_name << "=\"" << extra_value << '"';
+  std::cout << '}';
+}
+
+void print(const shared_memory_reader::snapshot& snapshot) {
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+              snapshot.last_update.time_since_epoch())
+              .count();
+  const sample* prev = nullptr;
+  for (auto& x : snapshot.samples) {
+    auto name = full_name(x);
+    if (prev == nullptr || prev->prefix != x.prefix || prev->name != x.name) {
+      if (!x.helptext.empty())
+        std::cout << "# HELP " << name << ' ' << x.helptext << '\n';
+      std::cout << "# TYPE " << name << ' ' << type_name(x) << '\n';
+    }
+    prev = &x;
+    if (!is_histogram(x)) {
+      std::cout << name;
+      print_labels(x);
+      if (is_dbl(x))
+        std::cout << ' ' << to_text(x.dbl_value);
+      else
+        std::cout << ' ' << x.int_value;
+      std::cout << ' ' << ms << '\n';
+      continue;
+    }
+    int64_t count = 0;
+    for (auto& bkt : x.buckets) {
+      count += bkt.count;
+      std::cout << name << "_bucket";
+      print_labels(x, "le", to_text(bkt.upper_bound));
+      std::cout << ' ' << count << ' ' << ms << '\n';
+    }
+    std::cout << name << "_sum";
+    print_labels(x);
+    if (is_dbl(x))
+      std::cout << ' ' << to_text(x.dbl_value);
+    else
+      std::cout << ' ' << x.int_value;
+    std::cout << ' ' << ms << '\n';
+    std::cout << name << "_count";
+    print_labels(x);
+    std::cout << ' ' << count << ' ' << ms << '\n';
+  }
+  std::cout << std::flush;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "usage: " << argv[0] << " <path> [<interval in ms>]\n";
+    return EXIT_FAILURE;
+  }
+  shared_memory_reader reader;
+  if (auto err = reader.open(argv[1])) {
+    std::cerr << "unable to open " << argv[1] << ": " << to_string(err)
+              << '\n';
+    return EXIT_FAILURE;
+  }
+  auto interval = std::chrono::milliseconds{argc == 3 ? atoi(argv[2]) : 0};
+  for (;;) {
+    auto snapshot = reader.read();
+    if (!snapshot) {
+      std::cerr << "unable to read " << argv[1] << ": "
+                << to_string(snapshot.error()) << '\n';
+      return EXIT_FAILURE;
+    }
+    print(*snapshot);
+    if (interval.count() <= 0)
+      return EXIT_SUCCESS;
+    std::this_thread::sleep_for(interval);
+  }
+}